@@ -63,6 +63,10 @@ struct Config {
 
     int MaxVoxelArraySize_; /**Sets the maximum size of each voxel array even if enough memory exists*/
     float VoxelArrayPercentOfSystemMemory_; /**Set the amount of system memory we allow*/
+    float VoxelArrayExpectedOccupancyPercent_ = CONFIG_DEFAULT_VOXEL_ARRAY_EXPECTED_OCCUPANCY_PERCENT; /**Percent of the voxel array bricks expected to hold shapes, only those take up memory*/
+    std::string MetricsDumpPath_;                               /**If not empty, the route metrics are written to this file periodically*/
+    int MetricsDumpInterval_s_ = CONFIG_DEFAULT_METRICS_DUMP_INTERVAL_S; /**Seconds between writes of the route metrics*/
+    int SimulationNumThreads_ = CONFIG_DEFAULT_SIMULATION_NUM_THREADS; /**Threads of each new simulation until it sets Optional_NumThreads, 0 means one per hardware thread*/
 
 };
 
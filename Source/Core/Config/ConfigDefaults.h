@@ -23,4 +23,7 @@
 #define CONFIG_DEFAULT_CFG_FILE_PATH1 "NES.yaml"
 #define CONFIG_DEFAULT_CFG_FILE_PATH2 "/etc/BrainGenix/NES/NES.yaml"
 #define CONFIG_DEFAULT_PORT_NUMBER 8001
-#define CONFIG_DEFAULT_HOST "0.0.0.0"
\ No newline at end of file
+#define CONFIG_DEFAULT_HOST "0.0.0.0"
+#define CONFIG_DEFAULT_METRICS_DUMP_INTERVAL_S 60
+#define CONFIG_DEFAULT_VOXEL_ARRAY_EXPECTED_OCCUPANCY_PERCENT 100
+#define CONFIG_DEFAULT_SIMULATION_NUM_THREADS 4
\ No newline at end of file
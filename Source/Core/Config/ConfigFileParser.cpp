@@ -50,6 +50,20 @@ ConfigFileParser::ConfigFileParser(Config &_Config) {
     _Config.MaxVoxelArraySize_ = Config["VSDA_EM_MaxVoxelArraySize"].as<int>();
     _Config.VoxelArrayPercentOfSystemMemory_ = Config["VSDA_EM_PercentOfSysteMemoryLimit"].as<int>();
 
+    // Optional, so that older config files still load.
+    if (Config["VSDA_EM_ExpectedOccupancyPercent"]) {
+        _Config.VoxelArrayExpectedOccupancyPercent_ = Config["VSDA_EM_ExpectedOccupancyPercent"].as<int>();
+    }
+    if (Config["Diagnostic_MetricsDumpPath"]) {
+        _Config.MetricsDumpPath_ = Config["Diagnostic_MetricsDumpPath"].as<std::string>();
+    }
+    if (Config["Diagnostic_MetricsDumpInterval_s"]) {
+        _Config.MetricsDumpInterval_s_ = Config["Diagnostic_MetricsDumpInterval_s"].as<int>();
+    }
+    if (Config["Simulation_NumThreads"]) {
+        _Config.SimulationNumThreads_ = std::max(0, Config["Simulation_NumThreads"].as<int>());
+    }
+
 }
 
 
@@ -11,6 +11,7 @@
 #pragma once
 
 // Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <iterator>
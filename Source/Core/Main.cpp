@@ -37,6 +37,9 @@ int main(int NumArguments, char** ArgumentValues) {
     BG::NES::Simulator::VSDA::VSDARPCInterface VSDARPCInterface(&Logger, &APIManager, SimulationRPCInterface.GetSimulationVectorPtr());
     BG::NES::Simulator::NetmorphRPCInterface   NetmorphRPCInterface(&Logger, SimulationRPCInterface.GetSimulationVectorPtr(), &APIManager);
 
+    // All routes are added, look them up without locking from now on
+    APIManager.FreezeRoutes();
+
     // Print ASCII BrainGenix Logo To Console
     BG::NES::Util::LogLogo(&Logger);
 
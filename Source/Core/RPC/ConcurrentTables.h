@@ -0,0 +1,156 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the tables that RPCManager shares between the RPC server threads.
+    Additional Notes: ShardedTable spreads its entries over independently locked shards, so threads
+                      only wait for each other when they use the same shard, and readers of a shard
+                      share its lock. FrozenRouteTable is built once and then only read, without locks.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+//! Default number of shards of a ShardedTable, more than RPC threads on most hosts.
+#define _SHARDED_TABLE_SHARDS 32
+
+/**
+ * @brief Hash map that can be used from any number of threads.
+ *
+ * Each shard has its own lock and sits on its own cache line, so threads that
+ * use different keys rarely contend.
+ */
+template <typename Key, typename Value, size_t NumShards = _SHARDED_TABLE_SHARDS>
+class ShardedTable {
+public:
+    //! Adds _Value under _Key, replacing the value that was there.
+    void Set(const Key& _Key, Value _Value) {
+        Shard& KeyShard = ShardOf(_Key);
+        std::unique_lock<std::shared_mutex> Lock(KeyShard.Mutex);
+        KeyShard.Map[_Key] = std::move(_Value);
+    }
+
+    //! Returns false if there was no value under _Key.
+    bool Erase(const Key& _Key) {
+        Shard& KeyShard = ShardOf(_Key);
+        std::unique_lock<std::shared_mutex> Lock(KeyShard.Mutex);
+        return KeyShard.Map.erase(_Key) > 0;
+    }
+
+    //! Copies the value under _Key to _Value, returns false if there is none.
+    bool Find(const Key& _Key, Value& _Value) const {
+        const Shard& KeyShard = ShardOf(_Key);
+        std::shared_lock<std::shared_mutex> Lock(KeyShard.Mutex);
+        auto It = KeyShard.Map.find(_Key);
+        if (It == KeyShard.Map.end()) {
+            return false;
+        }
+        _Value = It->second;
+        return true;
+    }
+
+    //! Number of entries, which may be changed by other threads meanwhile.
+    size_t Size() const {
+        size_t Total = 0;
+        for (const Shard& TableShard : Shards_) {
+            std::shared_lock<std::shared_mutex> Lock(TableShard.Mutex);
+            Total += TableShard.Map.size();
+        }
+        return Total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex Mutex;
+        std::unordered_map<Key, Value> Map;
+    };
+
+    Shard& ShardOf(const Key& _Key) { return Shards_[std::hash<Key>{}(_Key) % NumShards]; }
+    const Shard& ShardOf(const Key& _Key) const { return Shards_[std::hash<Key>{}(_Key) % NumShards]; }
+
+    std::array<Shard, NumShards> Shards_;
+};
+
+/**
+ * @brief Read-only hash map of routes to their handlers.
+ *
+ * Entries are kept in one array and found by linear probing of a slot array
+ * at most half full, so a lookup is one hash and usually one string compare.
+ * Build() must finish before the table is read by other threads.
+ */
+template <typename Handler>
+class FrozenRouteTable {
+public:
+    void Build(const std::map<std::string, Handler>& _Routes) {
+        size_t NumSlots = 8;
+        while (NumSlots < 2 * _Routes.size()) {
+            NumSlots *= 2;
+        }
+        Mask_ = NumSlots - 1;
+        Slots_.assign(NumSlots, 0);
+        Entries_.clear();
+        Entries_.reserve(_Routes.size());
+        for (const auto& [Route, Function] : _Routes) {
+            size_t Hash = std::hash<std::string>{}(Route);
+            size_t Slot = Hash & Mask_;
+            while (Slots_[Slot] != 0) {
+                Slot = (Slot + 1) & Mask_;
+            }
+            Entries_.push_back(Entry{ Hash, Route, Function });
+            Slots_[Slot] = uint32_t(Entries_.size());
+        }
+    }
+
+    //! Returns the handler of _Route, nullptr if there is none.
+    const Handler* Find(const std::string& _Route) const {
+        if (Slots_.empty()) {
+            return nullptr;
+        }
+        size_t Hash = std::hash<std::string>{}(_Route);
+        for (size_t Slot = Hash & Mask_; Slots_[Slot] != 0; Slot = (Slot + 1) & Mask_) {
+            const Entry& SlotEntry = Entries_[Slots_[Slot] - 1];
+            if ((SlotEntry.Hash == Hash) && (SlotEntry.Route == _Route)) {
+                return &SlotEntry.Function;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t Size() const { return Entries_.size(); }
+
+private:
+    struct Entry {
+        size_t Hash;
+        std::string Route;
+        Handler Function;
+    };
+
+    std::vector<Entry> Entries_;
+    std::vector<uint32_t> Slots_; /**Index of the entry plus one, 0 for empty slots*/
+    size_t Mask_ = 0;
+};
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
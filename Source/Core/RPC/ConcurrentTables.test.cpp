@@ -0,0 +1,69 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the tables shared between RPC threads.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RPC/ConcurrentTables.h>
+
+
+TEST(ConcurrentTablesTest, test_ShardedTable_from_threads) {
+    BG::NES::API::ShardedTable<long, long> table;
+
+    std::vector<std::thread> threads;
+    for (long t = 0; t < 4; t++) {
+        threads.emplace_back([&table, t]() {
+            for (long i = 0; i < 1000; i++) {
+                long key = t * 1000 + i;
+                table.Set(key, 2 * key);
+                long value = 0;
+                ASSERT_TRUE(table.Find(key, value));
+                ASSERT_EQ(value, 2 * key);
+                if ((i % 2) == 0) {
+                    ASSERT_TRUE(table.Erase(key));
+                }
+            }
+        });
+    }
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(table.Size(), 2000);
+    long value = 0;
+    ASSERT_FALSE(table.Find(2, value));
+    ASSERT_FALSE(table.Erase(2));
+    ASSERT_TRUE(table.Find(3, value));
+    ASSERT_EQ(value, 6);
+}
+
+TEST(ConcurrentTablesTest, test_FrozenRouteTable_finds_all_routes) {
+    std::map<std::string, int> routes;
+    for (int i = 0; i < 100; i++) {
+        routes["Simulation/Route" + std::to_string(i)] = i;
+    }
+
+    BG::NES::API::FrozenRouteTable<int> table;
+    ASSERT_EQ(table.Find("Simulation/Route0"), nullptr);
+
+    table.Build(routes);
+    ASSERT_EQ(table.Size(), 100);
+    for (const auto & [route, index] : routes) {
+        const int* found = table.Find(route);
+        ASSERT_NE(found, nullptr);
+        ASSERT_EQ(*found, index);
+    }
+    ASSERT_EQ(table.Find("Simulation/Route100"), nullptr);
+    ASSERT_EQ(table.Find(""), nullptr);
+}
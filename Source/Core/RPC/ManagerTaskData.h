@@ -48,6 +48,7 @@ struct ManagerTaskData {
     // Must be set before launching Task:
     // Simulator::Manager& Man;
     std::string InputData;
+    std::string InputPath; // Instead of InputData, a file that the Task reads itself.
 
     // Must be set before calling AddManagerTask:
     std::unique_ptr<std::thread> Task;
@@ -7,6 +7,7 @@
 #include <thread>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
+#include <cpp-base64/base64.h>
 
 // Internal Libraries (BG convention: use <> instead of "")
 
@@ -24,12 +25,24 @@ namespace API {
 HandlerData::HandlerData(const std::string& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy, bool NoSimulation) {
 
     // ManTaskData = called_by_manager_task;
-    JSONRequestStr = _JSONRequest;
     Logger_ = _Logger;
     RoutePath_ = _RoutePath;
+    RequestJSON = nlohmann::json::parse(_JSONRequest);
+
+    Init(_Simulations, PermitBusy, NoSimulation);
+}
+
+HandlerData::HandlerData(const nlohmann::json& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy, bool NoSimulation) {
+    Logger_ = _Logger;
+    RoutePath_ = _RoutePath;
+    RequestJSON = _JSONRequest;
+
+    Init(_Simulations, PermitBusy, NoSimulation);
+}
+
+void HandlerData::Init(Simulations _Simulations, bool PermitBusy, bool NoSimulation) {
 
     SimVec = _Simulations;
-    RequestJSON = nlohmann::json::parse(_JSONRequest);
 
     // bool isloadingsim = (ManTaskData != nullptr); // Man.IsLoadingSim();
     // if (isloadingsim && (_Source == "SimulationLoad")) { // *** PERHAPS WE CAN ALLOW THIS (AS WE USE LOCAL PARAMS NOW)?
@@ -99,48 +112,64 @@ BGStatusCode HandlerData::GetStatus() const {
 //       NESRequest batch handler. We don't want to double-count the calls,
 //       and we want to store the individual ones, because they may be
 //       intended for different simulations (dependeing on their SimulationID).
-std::string HandlerData::ResponseAndStoreRequest(nlohmann::json& ResponseJSON,  bool store) {
+HandlerResponse HandlerData::ResponseAndStoreRequest(nlohmann::json& ResponseJSON,  bool store) {
     // if (store && (Status == BGStatusCode::BGStatusSuccess)) {
     //     if (ThisSimulation != nullptr) {
     //         ThisSimulation->StoreRequestHandled(Source, _RH.at(Source).Route, JSONRequestStr);
     //     }
     // }
     if (ThisSimulation != nullptr) {
-        ThisSimulation->StoreRequestHandled(RoutePath_, JSONRequestStr);
+        ThisSimulation->StoreRequestHandled(RoutePath_, RequestJSON, Status == BGStatusCode::BGStatusSuccess);
     }
 
-    return ResponseJSON.dump();
+    return HandlerResponse{std::move(ResponseJSON)};
 }
-std::string HandlerData::ErrResponse(int _Status) {
+HandlerResponse HandlerData::ErrResponse(int _Status) {
     Status = BGStatusCode(_Status);
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = _Status;
     return ResponseAndStoreRequest(ResponseJSON);
 }
-std::string HandlerData::ErrResponse(BGStatusCode _Status) {
+HandlerResponse HandlerData::ErrResponse(BGStatusCode _Status) {
     return ErrResponse(int(_Status));
 }
-std::string HandlerData::ErrResponse() {
+HandlerResponse HandlerData::ErrResponse() {
     return ErrResponse(int(Status));
 }
 
-std::string HandlerData::ResponseWithID(const std::string& IDName, int IDValue) {
+HandlerResponse HandlerData::ResponseWithID(const std::string& IDName, int IDValue) {
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = int(Status);
     ResponseJSON[IDName] = IDValue;
     return ResponseAndStoreRequest(ResponseJSON);
 }
-std::string HandlerData::ResponseWithID(const std::string& IDName, const std::string& IDValue) {
+HandlerResponse HandlerData::ResponseWithID(const std::string& IDName, const std::string& IDValue) {
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = int(Status);
     ResponseJSON[IDName] = IDValue;
     return ResponseAndStoreRequest(ResponseJSON);
 }
-std::string HandlerData::StringResponse(std::string _Key, std::string _Value) {
+HandlerResponse HandlerData::BulkResponse(int _FirstID, int _Count) {
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = int(Status);
+    ResponseJSON["FirstID"] = _FirstID;
+    ResponseJSON["Count"] = _Count;
+    return ResponseAndStoreRequest(ResponseJSON);
+}
+HandlerResponse HandlerData::ChunkResponse(const std::string& _DataKey, const Util::FileChunk& _Chunk) {
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = int(Status);
+    ResponseJSON["Offset"] = _Chunk.Offset;
+    ResponseJSON["Length"] = _Chunk.Data.size();
+    ResponseJSON["FileSize"] = _Chunk.FileSize;
+    ResponseJSON[_DataKey] = base64_encode(reinterpret_cast<const unsigned char*>(_Chunk.Data.data()), _Chunk.Data.size());
+    return HandlerResponse{std::move(ResponseJSON)};
+}
+HandlerResponse HandlerData::StringResponse(std::string _Key, std::string _Value) {
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = int(Status);
     ResponseJSON[_Key] = _Value;
-    return ResponseJSON.dump();
+    return HandlerResponse{std::move(ResponseJSON)};
 }
 
 int HandlerData::SimID() const {
@@ -331,6 +360,64 @@ bool HandlerData::GetParVecFloat(const std::string& ParName, std::vector<float>&
     return GetParVecFloat(ParName, Value, RequestJSON);
 }
 
+bool HandlerData::GetParUInt64(const std::string& ParName, uint64_t& Value) {
+    nlohmann::json::iterator it;
+    if (!FindPar(ParName, it)) {
+        return false;
+    }
+    if (!it.value().is_number_unsigned()) {
+        Logger_->Log("Error Parameter '" + ParName + "', Wrong Type (expected unsigned int) Request Is: " + RequestJSON.dump(), 7);
+        Status = BGStatusCode::BGStatusInvalidParametersPassed;
+        return false;
+    }
+    Value = it.value().template get<uint64_t>();
+    return true;
+}
+
+bool HandlerData::GetFileChunk(const std::string& _Path, Util::FileChunk& _Chunk) {
+    uint64_t Offset = 0;
+    uint64_t Length = 0;
+    if ((!GetParUInt64("Offset", Offset)) || (!GetParUInt64("Length", Length))) {
+        return false;
+    }
+    if (!Util::ReadFileChunk(_Path, Offset, Length, _Chunk)) {
+        Logger_->Log("Unable To Read Chunk Of File " + _Path, 6);
+        Status = BGStatusCode::BGStatusInvalidParametersPassed;
+        return false;
+    }
+    return true;
+}
+
+bool HandlerData::GetParPackedRecords(const std::string& ParName, size_t _RecordBytes, int& _Count, std::string& _Bytes) {
+    nlohmann::json::iterator it;
+    if ((!GetParInt("Count", _Count)) || (!FindPar(ParName, it))) {
+        return false;
+    }
+    if (it.value().is_binary()) {
+        // Requests replayed from a request log carry the records as is.
+        const nlohmann::json::binary_t& Binary = it.value().get_binary();
+        _Bytes.assign(Binary.begin(), Binary.end());
+    } else {
+        std::string Encoded;
+        if (!GetParString(ParName, Encoded)) {
+            return false;
+        }
+        try {
+            _Bytes = base64_decode(Encoded);
+        } catch (const std::exception& e) {
+            Logger_->Log("Error Parameter '" + ParName + "', Invalid Base64 Data: " + e.what(), 7);
+            Status = BGStatusCode::BGStatusInvalidParametersPassed;
+            return false;
+        }
+    }
+    if ((_Count < 0) || (_Bytes.size() != size_t(_Count) * _RecordBytes)) {
+        Logger_->Log("Error Parameter '" + ParName + "', Expected " + std::to_string(_Count) + " Records Of " + std::to_string(_RecordBytes) + " Bytes, Got " + std::to_string(_Bytes.size()) + " Bytes", 7);
+        Status = BGStatusCode::BGStatusInvalidParametersPassed;
+        return false;
+    }
+    return true;
+}
+
 
 
 }; // Close Namespace API
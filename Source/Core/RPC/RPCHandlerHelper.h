@@ -13,6 +13,8 @@
 // Standard Libraries (BG convention: use <> instead of "")
 #include <iostream>
 #include <memory>
+#include <cstdint>
+#include <cstring>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 
@@ -21,6 +23,8 @@
 
 #include <Simulator/Structs/Simulation.h>
 
+#include <Util/FileChunk.h>
+
 // #include <RPC/ManagerTaskData.h>
 #include <RPC/APIStatusCode.h>
 
@@ -35,6 +39,18 @@ typedef std::vector<std::unique_ptr<Simulator::Simulation>>* Simulations;
 
 
 
+/**
+ * @brief Response built by HandlerData. It stays JSON until a string is
+ * needed, so that handlers called in-process by NESRequest hand back their
+ * responses without serializing them.
+ */
+struct HandlerResponse {
+    nlohmann::json JSON;
+
+    operator std::string() const { return JSON.dump(); }
+    operator nlohmann::json() && { return std::move(JSON); }
+};
+
 // Handy class for standard handler data.
 class HandlerData {
 
@@ -44,7 +60,6 @@ protected:
 
     BG::Common::Logger::LoggingSystem* Logger_ = nullptr; /**Pointer to the instance of the logging system*/
 
-    std::string JSONRequestStr;
     std::string RoutePath_; /**Path that is this route*/
     nlohmann::json RequestJSON;
     BGStatusCode Status = BGStatusSuccess;
@@ -52,8 +67,12 @@ protected:
     int SimulationID = -1;
     Simulator::Simulation* ThisSimulation = nullptr;
 
+    void Init(Simulations _Simulations, bool PermitBusy, bool NoSimulation);
+
 public:
     HandlerData(const std::string& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy = false, bool NoSimulation = false);
+    // For requests that are already parsed, e.g. the calls batched in NESRequest.
+    HandlerData(const nlohmann::json& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy = false, bool NoSimulation = false);
 
     // See how this is used in Manager::SimulationCreate().
     // Simulator::Simulation* NewSimulation();
@@ -72,14 +91,18 @@ public:
     //       NESRequest batch handler. We don't want to double-count the calls,
     //       and we want to store the individual ones, because they may be
     //       intended for different simulations (dependeing on their SimulationID).
-    std::string ResponseAndStoreRequest(nlohmann::json& ResponseJSON, bool store = true);
-    std::string ErrResponse(int _Status);
-    std::string ErrResponse(BGStatusCode _Status);
-    std::string ErrResponse();
-
-    std::string ResponseWithID(const std::string& IDName, int IDValue);
-    std::string ResponseWithID(const std::string& IDName, const std::string& IDValue);
-    std::string StringResponse(std::string _Key, std::string _Value);
+    HandlerResponse ResponseAndStoreRequest(nlohmann::json& ResponseJSON, bool store = true);
+    HandlerResponse ErrResponse(int _Status);
+    HandlerResponse ErrResponse(BGStatusCode _Status);
+    HandlerResponse ErrResponse();
+
+    HandlerResponse ResponseWithID(const std::string& IDName, int IDValue);
+    HandlerResponse ResponseWithID(const std::string& IDName, const std::string& IDValue);
+    HandlerResponse StringResponse(std::string _Key, std::string _Value);
+    //! Response of the bulk create routes, the created IDs are FirstID to FirstID+Count-1.
+    HandlerResponse BulkResponse(int _FirstID, int _Count);
+    //! Response of the chunked download routes, with the chunk base64 encoded as _DataKey, not stored.
+    HandlerResponse ChunkResponse(const std::string& _DataKey, const Util::FileChunk& _Chunk);
 
     int SimID() const;
     std::string SimIDStr() const;
@@ -114,6 +137,86 @@ public:
     bool GetParVecFloat(const std::string& ParName, std::vector<float>& Value, nlohmann::json& _JSON);
     bool GetParVecFloat(const std::string& ParName, std::vector<float>& Value);
 
+    bool GetParUInt64(const std::string& ParName, uint64_t& Value);
+
+    /**
+     * @brief Reads the chunk of the file at _Path given by the "Offset" and
+     * "Length" parameters, in bytes.
+     *
+     * @return false if a parameter is missing or the file can not be read.
+     */
+    bool GetFileChunk(const std::string& _Path, Util::FileChunk& _Chunk);
+
+    /**
+     * @brief Decodes the base64 parameter ParName into packed records of
+     * _RecordBytes bytes each, their number is given by the "Count" parameter.
+     * ParName may also be a binary value, as in requests decoded from msgpack.
+     *
+     * @return false if either parameter is missing, the data is not valid
+     * base64 or its length does not match Count * _RecordBytes.
+     */
+    bool GetParPackedRecords(const std::string& ParName, size_t _RecordBytes, int& _Count, std::string& _Bytes);
+
+    //! Names elements created in bulk by the optional "Names" parameter, an
+    //! array with one name per element, or else by the optional "NamePrefix"
+    //! parameter followed by their index in the batch, leaves them unnamed
+    //! without either.
+    template <typename T>
+    void SetBulkNames(std::vector<T>& _Elements) {
+        nlohmann::json::iterator it;
+        if (FindPar("Names", it, true) && it.value().is_array() && (it.value().size() == _Elements.size())) {
+            for (size_t i = 0; i < _Elements.size(); i++) {
+                if (it.value()[i].is_string()) {
+                    _Elements[i].Name = it.value()[i].template get<std::string>();
+                }
+            }
+            return;
+        }
+        if ((!FindPar("NamePrefix", it, true)) || (!it.value().is_string())) {
+            return;
+        }
+        std::string Prefix = it.value().template get<std::string>();
+        for (size_t i = 0; i < _Elements.size(); i++) {
+            _Elements[i].Name = Prefix + std::to_string(i);
+        }
+    }
+
+};
+
+/**
+ * @brief Reads the fields of packed little-endian records one after another,
+ * as decoded by HandlerData::GetParPackedRecords.
+ */
+class PackedRecordReader {
+public:
+    PackedRecordReader(const std::string& _Bytes) : Ptr_(reinterpret_cast<const uint8_t*>(_Bytes.data())) {}
+
+    uint32_t UInt32() {
+        uint32_t Value = uint32_t(Ptr_[0]) | (uint32_t(Ptr_[1]) << 8) | (uint32_t(Ptr_[2]) << 16) | (uint32_t(Ptr_[3]) << 24);
+        Ptr_ += 4;
+        return Value;
+    }
+
+    int Int32() {
+        return int32_t(UInt32());
+    }
+
+    float Float32() {
+        uint32_t Bits = UInt32();
+        float Value;
+        std::memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+
+    Simulator::Geometries::Vec3D Vec3() {
+        float x = Float32();
+        float y = Float32();
+        float z = Float32();
+        return Simulator::Geometries::Vec3D(x, y, z);
+    }
+
+private:
+    const uint8_t* Ptr_;
 };
 
 
@@ -4,6 +4,9 @@
 
 
 // Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <thread>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
@@ -24,6 +27,7 @@ namespace API {
 RPCManager::RPCManager(Config::Config* _Config, BG::Common::Logger::LoggingSystem* _Logger) {
 
     Logger_ = _Logger;
+    StartTime_ = std::chrono::steady_clock::now();
 
     // Initialize Server
     std::string ServerHost = _Config->Host;
@@ -38,8 +42,22 @@ RPCManager::RPCManager(Config::Config* _Config, BG::Common::Logger::LoggingSyste
     // Add predefined routes to the RPC server
     AddRoute("GetAPIVersion", _Logger, &GetAPIVersion);
     AddRoute("Echo", _Logger, &Echo);
-    AddRoute("NES", Logger_, [this](std::string RequestJSON){ return NESRequest(RequestJSON);});
+    RouteMetrics* NESMetrics = Metrics_.Get("NES");
+    AddRoute("NES", Logger_, [this, NESMetrics](std::string RequestJSON){
+        // Includes the time of the requests of the batch, which are also counted by their own routes.
+        auto Start = std::chrono::steady_clock::now();
+        size_t BytesIn = RequestJSON.size();
+        std::string Response = NESRequest(std::move(RequestJSON));
+        NESMetrics->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count(), IsErrorResponse(Response), BytesIn, Response.size());
+        return Response;
+    });
     AddRoute("SetCallback", Logger_, [this](std::string RequestJSON){ return SetupCallback(RequestJSON);});
+    AddJSONRoute("Diagnostic/GetMetrics", [this](const nlohmann::json& _JSONRequest){ return GetMetrics(_JSONRequest); });
+
+    if (!_Config->MetricsDumpPath_.empty()) {
+        _Logger->Log("Writing Route Metrics To '" + _Config->MetricsDumpPath_ + "' Every " + std::to_string(_Config->MetricsDumpInterval_s_) + "s", 4);
+        MetricsDumpThread_ = std::thread(&RPCManager::MetricsDumpLoop, this, _Config->MetricsDumpPath_, std::max(1, _Config->MetricsDumpInterval_s_));
+    }
     
 
     int ThreadCount = std::thread::hardware_concurrency();
@@ -52,41 +70,131 @@ RPCManager::RPCManager(Config::Config* _Config, BG::Common::Logger::LoggingSyste
 RPCManager::~RPCManager() {
     // Destructor
     // No explicit cleanup needed as smart pointers manage the RPC server's memory
+    if (MetricsDumpThread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> Lock(MetricsDumpMutex_);
+            StopMetricsDump_ = true;
+        }
+        MetricsDumpCondition_.notify_all();
+        MetricsDumpThread_.join();
+    }
+}
+
+nlohmann::json RPCManager::GetMetrics(const nlohmann::json& _JSONRequest) {
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = int(BGStatusCode::BGStatusSuccess);
+    ResponseJSON["Uptime_s"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime_).count();
+    ResponseJSON["Routes"] = Metrics_.ToJSON();
+    return ResponseJSON;
+}
+
+void RPCManager::MetricsDumpLoop(std::string _Path, int _Interval_s) {
+    std::unique_lock<std::mutex> Lock(MetricsDumpMutex_);
+    bool Stop = false;
+    while (!Stop) {
+        Stop = MetricsDumpCondition_.wait_for(Lock, std::chrono::seconds(_Interval_s), [this]() { return StopMetricsDump_; });
+
+        // Written next to the file and renamed, so readers never see a partial file.
+        std::string TempPath = _Path + ".tmp";
+        std::ofstream DumpFile(TempPath, std::ios::out | std::ios::trunc);
+        DumpFile << GetMetrics(nlohmann::json()).dump(4) << '\n';
+        DumpFile.close();
+        if (!DumpFile.good() || (std::rename(TempPath.c_str(), _Path.c_str()) != 0)) {
+            Logger_->Log("Unable To Write Route Metrics To '" + _Path + "'", 7);
+        }
+    }
 }
 
 
 long RPCManager::GetBgRequestID() {
-    long BgId = BgRequestID;
-    BgRequestID++;
-    return BgId;
+    return BgRequestID.fetch_add(1);
 }
 
 void RPCManager::RegisterBgAPIProcess(long _BGRequestID, nlohmann::json* _BgStatusResult) {
-    BgStatusResultMap[_BGRequestID] = _BgStatusResult;
+    BgStatusResultMap.Set(_BGRequestID, _BgStatusResult);
 }
 
 bool RPCManager::UnRegisterBgAPIProcess(long _BGRequestID) {
-    if (BgStatusResultMap.find(_BGRequestID) == BgStatusResultMap.end()) {
-        return false;
-    }
+    return BgStatusResultMap.Erase(_BGRequestID);
+}
 
-    BgStatusResultMap.erase(_BGRequestID);
-    return true;
+nlohmann::json* RPCManager::GetBgAPIProcess(long _BGRequestID) {
+    nlohmann::json* BgStatusResult = nullptr;
+    BgStatusResultMap.Find(_BGRequestID, BgStatusResult);
+    return BgStatusResult;
+}
+
+void RPCManager::FreezeRoutes() {
+    std::unique_lock<std::shared_mutex> Lock(RoutesMutex_);
+    if (RoutesFrozen_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    FrozenRequestHandlers_.Build(RequestHandlers_);
+    FrozenJSONRequestHandlers_.Build(JSONRequestHandlers_);
+    RoutesFrozen_.store(true, std::memory_order_release);
+    Logger_->Log("Froze Route Table With '" + std::to_string(FrozenRequestHandlers_.Size()) + "' Routes", 4);
 }
 
 // void RPCManager::AddRequestHandler(std::string _RouteName, RouteAndHandler _Handler) {
     // RequestHandlers_.insert(std::pair<std::string, std::function<std::string>&>(_RouteName, _Handler));
 // }
 
-void RPCManager::AddRoute(std::string _RouteHandle, std::function<std::string(std::string _JSONRequest)> _Function) {
+void RPCManager::AddRoute(std::string _RouteHandle, StringHandler _Function) {
+    if (RoutesFrozen_.load(std::memory_order_acquire)) {
+        Logger_->Log("Error, Cannot Register Route '" + _RouteHandle + "' After The Route Table Was Frozen", 8);
+        return;
+    }
     Logger_->Log("Registering Callback For Route '" + _RouteHandle + "'", 4);
-    RequestHandlers_.insert(std::pair<std::string, std::function<std::string(std::string _JSONRequest)>>(_RouteHandle, _Function));
+    RouteMetrics* Metrics = Metrics_.Get(_RouteHandle);
+    auto TimedFunction = [Metrics, _Function](std::string _JSONRequest) {
+        auto Start = std::chrono::steady_clock::now();
+        size_t BytesIn = _JSONRequest.size();
+        std::string Response = _Function(std::move(_JSONRequest));
+        Metrics->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count(), IsErrorResponse(Response), BytesIn, Response.size());
+        return Response;
+    };
+    std::unique_lock<std::shared_mutex> Lock(RoutesMutex_);
+    RequestHandlers_.insert(std::pair<std::string, StringHandler>(_RouteHandle, TimedFunction));
     // RouteAndHandler Handler;
     // Handler.Route_ = _RouteHandle;
     // Handler.Handler_ = _Function;
     // AddRequestHandler(_RouteHandle, Handler);
 }
 
+void RPCManager::AddJSONRoute(std::string _RouteHandle, JSONHandler _Function) {
+    if (RoutesFrozen_.load(std::memory_order_acquire)) {
+        Logger_->Log("Error, Cannot Register Route '" + _RouteHandle + "' After The Route Table Was Frozen", 8);
+        return;
+    }
+    // Requests passed in place have no size, only their calls and latency are counted.
+    RouteMetrics* Metrics = Metrics_.Get(_RouteHandle);
+    auto TimedFunction = [Metrics, _Function](const nlohmann::json& _JSONRequest) {
+        auto Start = std::chrono::steady_clock::now();
+        nlohmann::json Response = _Function(_JSONRequest);
+        auto StatusCode = Response.find("StatusCode");
+        bool Error = (StatusCode != Response.end()) && (*StatusCode != 0);
+        Metrics->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count(), Error, 0, 0);
+        return Response;
+    };
+    {
+        std::unique_lock<std::shared_mutex> Lock(RoutesMutex_);
+        JSONRequestHandlers_.insert(std::pair<std::string, JSONHandler>(_RouteHandle, TimedFunction));
+    }
+    AddRoute(_RouteHandle, [_Function](std::string _JSONRequest) {
+        return _Function(nlohmann::json::parse(_JSONRequest)).dump();
+    });
+}
+
+void RPCManager::AddBinaryRoute(std::string _RouteHandle, std::function<BinaryResponse(std::string _JSONRequest)> _Function) {
+    RouteMetrics* Metrics = Metrics_.Get(_RouteHandle);
+    AddRoute(_RouteHandle, Logger_, [Metrics, _Function](std::string _JSONRequest) {
+        auto Start = std::chrono::steady_clock::now();
+        size_t BytesIn = _JSONRequest.size();
+        BinaryResponse Response = _Function(std::move(_JSONRequest));
+        Metrics->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count(), std::get<0>(Response) != 0, BytesIn, std::get<2>(Response).size());
+        return Response;
+    });
+}
 
 bool BadReqID(int ReqID) {
     // *** TODO: Add some rules here for ReqIDs that should be refused.
@@ -137,7 +245,7 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
         int ReqID = -1;
         //int SimulationID = -1;
         std::string ReqFunc;
-        nlohmann::json ReqParams;
+        const nlohmann::json* ReqParams = nullptr;
         nlohmann::json ReqResponseJSON;
         //std::string Response;
 
@@ -149,7 +257,7 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
             //    SimulationID = req_value.template get<int>();
             } else {
                 ReqFunc = req_key;
-                ReqParams = req_value;
+                ReqParams = &req_value;
             }
         }
         // if (BadReqID(ReqID)) { // e.g. < highest request ID already handled
@@ -157,37 +265,19 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
         //     ReqResponseJSON["StatusCode"] = 1; // bad request id
         // } else {
 
-        // Typically would call a specific handler from here, but let's just keep parsing.
-        auto it = RequestHandlers_.find(ReqFunc);
-        if (it == RequestHandlers_.end()) {
-            Logger_->Log("Error, No Handler Exists For Call " + ReqFunc, 7);
-            ReqResponseJSON["ReqID"] = ReqID;
-            ReqResponseJSON["StatusCode"] = 1; // unknown request *** TODO: use the right code
-            //Response = ReqResponseJSON.dump();
-        } else {
-            if (!it->second) {
-                ReqResponseJSON["ReqID"] = ReqID;
-                Logger_->Log("Error, Handler Is Null For Call " + ReqFunc + ", Continuing Anyway", 7);
-                // ReqResponseJSON["StatusCode"] = 1; // not a valid NES request *** TODO: use the right code
-            } else {
-                // Logger_->Log("DEBUG -> Got Request For '" + ReqFunc + "'", 0);
-                if (_SimulationIDOverride != -1) {
-                    ReqParams["SimulationID"] = _SimulationIDOverride;
-                }
-                std::string Response = it->second(ReqParams.dump()); // Calls the handler.
-                // *** TODO: Either:
-                //     a) Convert handlers to return nlohmann::json objects so that we
-                //        can easily add ReqResponseJSON["ReqID"] = ReqID here, or,
-                //     b) Convert Response back to a ReqResponseJSON here in order to
-                //        add that... (This is more work, lower performance...)
-                //     Right now, we do b) (sadly...)
-                ReqResponseJSON = nlohmann::json::parse(Response);
-                ReqResponseJSON["ReqID"] = ReqID;
-            }
+        // Requests are passed in place unless the SimulationID is replaced.
+        nlohmann::json OverriddenParams;
+        if ((_SimulationIDOverride != -1) && (ReqParams != nullptr)) {
+            OverriddenParams = *ReqParams;
+            OverriddenParams["SimulationID"] = _SimulationIDOverride;
+            ReqParams = &OverriddenParams;
         }
 
+        ReqResponseJSON = HandleRequest(ReqFunc, ReqParams);
+        ReqResponseJSON["ReqID"] = ReqID;
+
         // }
-        ResponseJSON.push_back(ReqResponseJSON);
+        ResponseJSON.push_back(std::move(ReqResponseJSON));
 
     }
 
@@ -205,6 +295,58 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
 }
 
 
+nlohmann::json RPCManager::HandleRequest(const std::string& _Route, const nlohmann::json* _Request) {
+
+    // Once frozen, the handlers are looked up in the flat tables, which are
+    // never changed again and are read by all RPC threads without locking.
+    // Before that, the handlers are copied under the lock, so that handlers
+    // which handle requests themselves do not take it again.
+    const JSONHandler* JSONFunction = nullptr;
+    const StringHandler* Function = nullptr;
+    JSONHandler JSONFunctionCopy;
+    StringHandler FunctionCopy;
+    if (RoutesFrozen_.load(std::memory_order_acquire)) {
+        JSONFunction = FrozenJSONRequestHandlers_.Find(_Route);
+        Function = FrozenRequestHandlers_.Find(_Route);
+    } else {
+        std::shared_lock<std::shared_mutex> Lock(RoutesMutex_);
+        auto JSONIt = JSONRequestHandlers_.find(_Route);
+        if (JSONIt != JSONRequestHandlers_.end()) {
+            JSONFunctionCopy = JSONIt->second;
+            JSONFunction = &JSONFunctionCopy;
+        }
+        auto It = RequestHandlers_.find(_Route);
+        if (It != RequestHandlers_.end()) {
+            FunctionCopy = It->second;
+            Function = &FunctionCopy;
+        }
+    }
+
+    // Handlers of JSON routes are called without serializing the request
+    // and parsing their response.
+    if ((_Request != nullptr) && (JSONFunction != nullptr) && *JSONFunction) {
+        return (*JSONFunction)(*_Request);
+    }
+
+    // Typically would call a specific handler from here, but let's just keep parsing.
+    nlohmann::json ResponseJSON;
+    if (Function == nullptr) {
+        Logger_->Log("Error, No Handler Exists For Call " + _Route, 7);
+        ResponseJSON["StatusCode"] = 1; // unknown request *** TODO: use the right code
+    } else if (!*Function) {
+        Logger_->Log("Error, Handler Is Null For Call " + _Route + ", Continuing Anyway", 7);
+        // ResponseJSON["StatusCode"] = 1; // not a valid NES request *** TODO: use the right code
+    } else {
+        // Logger_->Log("DEBUG -> Got Request For '" + _Route + "'", 0);
+        std::string Response = (*Function)((_Request != nullptr) ? _Request->dump() : "null"); // Calls the handler.
+        // Routes that are not yet added with AddJSONRoute return a
+        // string, which is converted back to JSON here.
+        ResponseJSON = nlohmann::json::parse(Response);
+    }
+    return ResponseJSON;
+}
+
+
 std::string RPCManager::SetupCallback(std::string _JSONRequest) {
 
     nlohmann::json Params = nlohmann::json::parse(_JSONRequest);
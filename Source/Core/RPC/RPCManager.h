@@ -11,8 +11,16 @@
 #pragma once
 
 // Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 #include <rpc/server.h>
@@ -22,6 +30,8 @@
 // Internal Libraries (BG convention: use <> instead of "")
 #include <RPC/StaticRoutes.h>
 #include <RPC/RouteAndHandler.h>
+#include <RPC/RouteMetrics.h>
+#include <RPC/ConcurrentTables.h>
 
 #include <BG/Common/Logger/Logger.h>
 
@@ -35,6 +45,16 @@ namespace BG {
 namespace NES {
 namespace API {
 
+//! Handler of a route that takes and returns parsed JSON, see AddJSONRoute.
+typedef std::function<nlohmann::json(const nlohmann::json& _JSONRequest)> JSONHandler;
+
+//! Handler of a route that takes and returns serialized JSON, see AddRoute.
+typedef std::function<std::string(std::string _JSONRequest)> StringHandler;
+
+//! Response of a binary route: StatusCode, size of the whole file and the
+//! bytes, which are sent as a msgpack bin instead of base64 in JSON.
+typedef std::tuple<int, uint64_t, std::vector<char>> BinaryResponse;
+
 /**
  * @brief Manages the NES remote procedure call (RPC) host.
  *
@@ -46,16 +66,28 @@ class RPCManager {
 private:
 
     Config::Config* Config_; /**Pointer to configuration struct owned by rest of system*/
+    RouteMetricsRegistry Metrics_; /**Calls, errors, bytes and latencies of every route, declared before the server so that it outlives its handlers*/
     std::unique_ptr<rpc::server> RPCServer_; /**Instance of RPC Server from rpclib*/
     BG::Common::Logger::LoggingSystem* Logger_ = nullptr; /**Pointer to the instance of the logging system*/
 
     std::unique_ptr<SafeClient> APIClient_; /**Instance of the smartclient, allows us to talk back to the API's RPC server */
 
 
-    std::map<std::string, std::function<std::string(std::string _JSONRequest)>> RequestHandlers_;
+    std::map<std::string, StringHandler> RequestHandlers_;
+    std::map<std::string, JSONHandler> JSONRequestHandlers_; /**Routes that NESRequest calls without serializing their requests and responses*/
+    std::shared_mutex RoutesMutex_;                          /**Guards the handler maps while routes are added, until FreezeRoutes()*/
+    std::atomic<bool> RoutesFrozen_{false};                  /**Set once the frozen tables are built, after which they are read without locks*/
+    FrozenRouteTable<StringHandler> FrozenRequestHandlers_;
+    FrozenRouteTable<JSONHandler> FrozenJSONRequestHandlers_;
+
+    std::chrono::steady_clock::time_point StartTime_;        /**For the uptime reported with the metrics*/
+    std::thread MetricsDumpThread_;                          /**Writes the metrics to Config::MetricsDumpPath_ periodically, if set*/
+    std::mutex MetricsDumpMutex_;
+    std::condition_variable MetricsDumpCondition_;
+    bool StopMetricsDump_ = false;
 
-    long BgRequestID = 0; // The next ID to use for a background request.
-    std::map<long, nlohmann::json*> BgStatusResultMap;
+    std::atomic<long> BgRequestID{0}; // The next ID to use for a background request.
+    ShardedTable<long, nlohmann::json*> BgStatusResultMap; /**Status/Result objects of running background requests, used from any RPC thread*/
 
    /**
      * @brief Adds the given route 
@@ -65,6 +97,12 @@ private:
      */
     void AddRequestHandler(std::string _RouteName, RouteAndHandler _Handler);
 
+    /**
+     * @brief Writes the metrics to _Path every _Interval_s seconds until the
+     * RPCManager is destroyed, then once more.
+     */
+    void MetricsDumpLoop(std::string _Path, int _Interval_s);
+
 
 
 public:
@@ -105,6 +143,24 @@ public:
      */
     bool UnRegisterBgAPIProcess(long _BGRequestID);
 
+    /**
+     * @brief Returns the Status/Result object registered for a background API
+     *        request, nullptr if there is none.
+     */
+    nlohmann::json* GetBgAPIProcess(long _BGRequestID);
+
+    /**
+     * @brief Builds the flat lookup tables of the routes added so far, which
+     * HandleRequest then reads without locking. Call this once all routes are
+     * added, routes can not be added afterwards.
+     */
+    void FreezeRoutes();
+
+    /**
+     * @brief Metrics of all routes that were called, see Diagnostic/GetMetrics.
+     */
+    nlohmann::json GetMetrics(const nlohmann::json& _JSONRequest);
+
     /**
      * @brief Called by the API service shortly after initialization, and allows the system to talk back to the API and request other calls.
     */
@@ -113,11 +169,33 @@ public:
  
     /**
      * @brief Adds a route to the NES RPC Handler.
+     * Calls of every route are counted in the route metrics.
      * 
      * @param _RouteHandle 
      * @param _Function 
      */
-    void AddRoute(std::string _RouteHandle, std::function<std::string(std::string _JSONRequest)> _Function);
+    void AddRoute(std::string _RouteHandle, StringHandler _Function);
+
+    /**
+     * @brief Adds a route whose handler takes and returns parsed JSON.
+     * NESRequest passes it the sub-request in place and adds its response to
+     * the batch response as is. The route is also added as a string route,
+     * through an adapter that parses the request and serializes the response.
+     *
+     * @param _RouteHandle
+     * @param _Function
+     */
+    void AddJSONRoute(std::string _RouteHandle, JSONHandler _Function);
+
+    /**
+     * @brief Binds a route that returns binary data directly on the RPC
+     * server. Such routes are called by their name instead of through "NES",
+     * as their responses can not be part of a JSON batch response.
+     *
+     * @param _RouteHandle
+     * @param _Function
+     */
+    void AddBinaryRoute(std::string _RouteHandle, std::function<BinaryResponse(std::string _JSONRequest)> _Function);
 
 
     /**
@@ -132,6 +210,17 @@ public:
 
     std::string NESRequest(std::string _JSONRequest, int _SimulationIDOverride = -1); // Generic JSON-based NES requests.
 
+    /**
+     * @brief Calls the handler of one request, as NESRequest does for each
+     * request of a batch.
+     *
+     * @param _Route Name of the route.
+     * @param _Request Parameters of the request, nullptr if it has none.
+     * @return The response of the handler, or a StatusCode of 1 if there is
+     * no handler for _Route.
+     */
+    nlohmann::json HandleRequest(const std::string& _Route, const nlohmann::json* _Request);
+
 
     /**
      * @brief Registers a callback to the API service.
@@ -0,0 +1,145 @@
+//=================================//
+// This file is part of BrainGenix //
+//=================================//
+
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <RPC/RouteMetrics.h>
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+
+size_t LatencyHistogram::BucketIndex(uint64_t _Latency_ns) {
+    if (_Latency_ns < _LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return _Latency_ns;
+    }
+    // Bucket of the power of two, then of the bits below the leading one.
+    int MSB = 63 - __builtin_clzll(_Latency_ns);
+    int Shift = MSB - _LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return (Shift + 1) * _LATENCY_HISTOGRAM_SUB_BUCKETS + ((_Latency_ns >> Shift) & (_LATENCY_HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::BucketLowerBound_ns(size_t _Index) {
+    if (_Index < _LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return _Index;
+    }
+    size_t Shift = _Index / _LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t SubBucket = _Index % _LATENCY_HISTOGRAM_SUB_BUCKETS;
+    return (_LATENCY_HISTOGRAM_SUB_BUCKETS + SubBucket) << Shift;
+}
+
+void LatencyHistogram::Record(uint64_t _Latency_ns) {
+    Buckets_[BucketIndex(_Latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    Sum_ns_.fetch_add(_Latency_ns, std::memory_order_relaxed);
+    uint64_t Max = Max_ns_.load(std::memory_order_relaxed);
+    while ((_Latency_ns > Max) && !Max_ns_.compare_exchange_weak(Max, _Latency_ns, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::Count() const {
+    uint64_t Total = 0;
+    for (const std::atomic<uint64_t>& Bucket : Buckets_) {
+        Total += Bucket.load(std::memory_order_relaxed);
+    }
+    return Total;
+}
+
+uint64_t LatencyHistogram::Percentile_ns(double _Percentile) const {
+    // Buckets may be incremented while reading, which only shifts the result
+    // by the calls that are being recorded.
+    std::array<uint64_t, _LATENCY_HISTOGRAM_BUCKETS> Counts;
+    uint64_t Total = 0;
+    for (size_t i = 0; i < Counts.size(); i++) {
+        Counts[i] = Buckets_[i].load(std::memory_order_relaxed);
+        Total += Counts[i];
+    }
+    if (Total == 0) {
+        return 0;
+    }
+    uint64_t Rank = std::max<uint64_t>(1, uint64_t(std::ceil(_Percentile / 100.0 * Total)));
+    uint64_t Cumulative = 0;
+    for (size_t i = 0; i < Counts.size(); i++) {
+        Cumulative += Counts[i];
+        if (Cumulative >= Rank) {
+            return BucketLowerBound_ns(i);
+        }
+    }
+    return BucketLowerBound_ns(Counts.size() - 1);
+}
+
+void RouteMetrics::Record(uint64_t _Latency_ns, bool _Error, uint64_t _BytesIn, uint64_t _BytesOut) {
+    Calls.fetch_add(1, std::memory_order_relaxed);
+    if (_Error) {
+        Errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    BytesIn.fetch_add(_BytesIn, std::memory_order_relaxed);
+    BytesOut.fetch_add(_BytesOut, std::memory_order_relaxed);
+    Latency.Record(_Latency_ns);
+}
+
+nlohmann::json RouteMetrics::ToJSON() const {
+    uint64_t NumCalls = Calls.load(std::memory_order_relaxed);
+    nlohmann::json MetricsJSON;
+    MetricsJSON["Calls"] = NumCalls;
+    MetricsJSON["Errors"] = Errors.load(std::memory_order_relaxed);
+    MetricsJSON["BytesIn"] = BytesIn.load(std::memory_order_relaxed);
+    MetricsJSON["BytesOut"] = BytesOut.load(std::memory_order_relaxed);
+    MetricsJSON["LatencyMean_us"] = (NumCalls > 0) ? 1e-3 * Latency.Sum_ns() / NumCalls : 0.0;
+    MetricsJSON["LatencyP50_us"] = 1e-3 * Latency.Percentile_ns(50.0);
+    MetricsJSON["LatencyP90_us"] = 1e-3 * Latency.Percentile_ns(90.0);
+    MetricsJSON["LatencyP99_us"] = 1e-3 * Latency.Percentile_ns(99.0);
+    MetricsJSON["LatencyP999_us"] = 1e-3 * Latency.Percentile_ns(99.9);
+    MetricsJSON["LatencyMax_us"] = 1e-3 * Latency.Max_ns();
+    return MetricsJSON;
+}
+
+RouteMetrics* RouteMetricsRegistry::Get(const std::string& _Route) {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    std::unique_ptr<RouteMetrics>& Metrics = Routes_[_Route];
+    if (!Metrics) {
+        Metrics = std::make_unique<RouteMetrics>();
+    }
+    return Metrics.get();
+}
+
+nlohmann::json RouteMetricsRegistry::ToJSON() const {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    nlohmann::json RoutesJSON = nlohmann::json::object();
+    for (const auto& [Route, Metrics] : Routes_) {
+        if (Metrics->Calls.load(std::memory_order_relaxed) > 0) {
+            RoutesJSON[Route] = Metrics->ToJSON();
+        }
+    }
+    return RoutesJSON;
+}
+
+bool IsErrorResponse(const std::string& _Response) {
+    // Batch responses hold one StatusCode per request, so every one is checked.
+    static const std::string Key = "\"StatusCode\":";
+    for (size_t Position = _Response.find(Key); Position != std::string::npos; Position = _Response.find(Key, Position)) {
+        Position += Key.size();
+        while ((Position < _Response.size()) && (_Response[Position] == ' ')) {
+            Position++;
+        }
+        bool IsZero = (Position < _Response.size()) && (_Response[Position] == '0')
+            && ((Position + 1 == _Response.size()) || !std::isdigit(static_cast<unsigned char>(_Response[Position + 1])));
+        if (!IsZero) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,106 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the per-route call metrics reported by Diagnostic/GetMetrics.
+    Additional Notes: Recording only does relaxed atomic increments, so handlers running on any
+                      number of RPC threads do not wait for each other. Latencies are counted in
+                      log buckets, 8 per power of two, so percentiles are within 12.5%.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+//! log2 of the number of buckets per power of two.
+#define _LATENCY_HISTOGRAM_SUB_BUCKET_BITS 3
+#define _LATENCY_HISTOGRAM_SUB_BUCKETS (1 << _LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+//! Enough buckets for any uint64_t latency in ns.
+#define _LATENCY_HISTOGRAM_BUCKETS ((64 - _LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1) * _LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * @brief Lock-free histogram of latencies in ns, in HDR-style log buckets.
+ *
+ */
+class LatencyHistogram {
+public:
+    void Record(uint64_t _Latency_ns);
+
+    uint64_t Count() const;
+    uint64_t Max_ns() const { return Max_ns_.load(std::memory_order_relaxed); }
+    uint64_t Sum_ns() const { return Sum_ns_.load(std::memory_order_relaxed); }
+
+    //! Lower bound of the bucket that holds the _Percentile (0 to 100)
+    //! percentile of the recorded latencies, 0 if none are recorded.
+    uint64_t Percentile_ns(double _Percentile) const;
+
+    static size_t BucketIndex(uint64_t _Latency_ns);
+    static uint64_t BucketLowerBound_ns(size_t _Index);
+
+private:
+    std::array<std::atomic<uint64_t>, _LATENCY_HISTOGRAM_BUCKETS> Buckets_{};
+    std::atomic<uint64_t> Max_ns_{0};
+    std::atomic<uint64_t> Sum_ns_{0};
+};
+
+/**
+ * @brief Counters of the calls of one route.
+ *
+ */
+struct RouteMetrics {
+    std::atomic<uint64_t> Calls{0};
+    std::atomic<uint64_t> Errors{0};   /**Calls that responded with a StatusCode other than 0*/
+    std::atomic<uint64_t> BytesIn{0};  /**Of requests that arrived as strings*/
+    std::atomic<uint64_t> BytesOut{0}; /**Of responses that left as strings or binary data*/
+    LatencyHistogram Latency;
+
+    void Record(uint64_t _Latency_ns, bool _Error, uint64_t _BytesIn, uint64_t _BytesOut);
+
+    nlohmann::json ToJSON() const;
+};
+
+/**
+ * @brief Metrics of all routes by name.
+ *
+ * Routes are added while registering handlers, which keep a pointer to their
+ * metrics, so the lock is only taken to add routes and to report.
+ */
+class RouteMetricsRegistry {
+public:
+    //! Returns the metrics of _Route, which stay valid as long as the registry.
+    RouteMetrics* Get(const std::string& _Route);
+
+    //! Metrics of all routes that were called at least once, by route name.
+    nlohmann::json ToJSON() const;
+
+private:
+    mutable std::mutex Mutex_;
+    std::map<std::string, std::unique_ptr<RouteMetrics>> Routes_;
+};
+
+//! Tells if the serialized JSON response _Response has a StatusCode other
+//! than 0 anywhere, e.g. in any request of a batch, without parsing it.
+bool IsErrorResponse(const std::string& _Response);
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,91 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the route metrics.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RPC/RouteMetrics.h>
+
+
+TEST(RouteMetricsTest, test_BucketIndex_within_eighth_of_value) {
+    using BG::NES::API::LatencyHistogram;
+    size_t previousIndex = 0;
+    for (uint64_t value : std::vector<uint64_t>{ 0, 1, 7, 8, 9, 15, 16, 17, 1000, 123456789, UINT64_MAX }) {
+        size_t index = LatencyHistogram::BucketIndex(value);
+        ASSERT_LT(index, _LATENCY_HISTOGRAM_BUCKETS);
+        ASSERT_GE(index, previousIndex);
+        previousIndex = index;
+
+        uint64_t lowerBound = LatencyHistogram::BucketLowerBound_ns(index);
+        ASSERT_LE(lowerBound, value);
+        ASSERT_LE(value - lowerBound, lowerBound / 8);
+        ASSERT_EQ(LatencyHistogram::BucketIndex(lowerBound), index);
+    }
+}
+
+TEST(RouteMetricsTest, test_Percentile_of_recorded_latencies) {
+    BG::NES::API::LatencyHistogram histogram;
+    ASSERT_EQ(histogram.Percentile_ns(50.0), 0);
+
+    for (int i = 0; i < 99; i++) {
+        histogram.Record(1000);
+    }
+    histogram.Record(1000000);
+
+    ASSERT_EQ(histogram.Count(), 100);
+    ASSERT_EQ(histogram.Max_ns(), 1000000);
+    ASSERT_EQ(histogram.Percentile_ns(50.0), BG::NES::API::LatencyHistogram::BucketLowerBound_ns(BG::NES::API::LatencyHistogram::BucketIndex(1000)));
+    ASSERT_EQ(histogram.Percentile_ns(99.0), histogram.Percentile_ns(50.0));
+    ASSERT_GT(histogram.Percentile_ns(100.0), 900000);
+}
+
+TEST(RouteMetricsTest, test_Record_from_threads_counts_all_calls) {
+    BG::NES::API::RouteMetricsRegistry registry;
+    BG::NES::API::RouteMetrics* metrics = registry.Get("Route");
+    ASSERT_EQ(registry.Get("Route"), metrics);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([metrics, t]() {
+            for (int i = 0; i < 1000; i++) {
+                metrics->Record(100 * (i + 1), (i % 10) == 0, 10, 20);
+            }
+        });
+    }
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+
+    nlohmann::json metricsJSON = registry.ToJSON();
+    ASSERT_EQ(metricsJSON["Route"]["Calls"], 4000);
+    ASSERT_EQ(metricsJSON["Route"]["Errors"], 400);
+    ASSERT_EQ(metricsJSON["Route"]["BytesIn"], 40000);
+    ASSERT_EQ(metricsJSON["Route"]["BytesOut"], 80000);
+    ASSERT_EQ(metricsJSON["Route"]["LatencyMax_us"], 100.0);
+
+    // Routes without calls are left out.
+    registry.Get("Uncalled");
+    ASSERT_FALSE(registry.ToJSON().contains("Uncalled"));
+}
+
+TEST(RouteMetricsTest, test_IsErrorResponse_default) {
+    ASSERT_FALSE(BG::NES::API::IsErrorResponse("{\"ShapeID\":3,\"StatusCode\":0}"));
+    ASSERT_FALSE(BG::NES::API::IsErrorResponse("{\"StatusCode\": 0}"));
+    ASSERT_FALSE(BG::NES::API::IsErrorResponse("[]"));
+    ASSERT_TRUE(BG::NES::API::IsErrorResponse("{\"StatusCode\":2}"));
+    ASSERT_TRUE(BG::NES::API::IsErrorResponse("{\"StatusCode\":05}"));
+
+    // A batch fails if any of its requests failed.
+    ASSERT_FALSE(BG::NES::API::IsErrorResponse("[{\"StatusCode\":0},{\"StatusCode\":0}]"));
+    ASSERT_TRUE(BG::NES::API::IsErrorResponse("[{\"StatusCode\":0},{\"ShapeID\":3,\"StatusCode\":1}]"));
+}
@@ -61,6 +61,8 @@ void BSNeuron::SetSpontaneousActivity(float mean, float stdev, int Seed) {
     float b = 2.0*mean;
     this->DtSpontDist = std::make_shared<Distributions::TruncNorm>(a, b, mean, stdev);
     this->DtSpontDist->SetSeed(Seed);
+    this->SpontKey = (uint64_t(uint32_t(this->ID)) << 32) | uint32_t(Seed);
+    this->SpontDraws = 0;
 };
 
 //! Keeps track of the membrane potential and the time of update.
@@ -202,17 +204,13 @@ void BSNeuron::UpdateVm(float t_ms, bool recording) {
     // 3. Calculate membrane potential
     this->Vm_mV = this->VRest_mV + VSpikeT_mV + VAHPT_mV + VPSPT_mV;
 
-    // 4. Add voltage elevation to FIFO buffer for phospherescence convolution
-    if (!this->FIFO.empty()) {
-        // We replace [0], i.e. drop the one at the end and push to front.
-        // this->FIFO.pop_back();
-        // this->FIFO.push_front(this->Vm_mV - this->VRest_mV);
-        // *** TESTING: Newest at back of FIFO (as in SignalFunctions.py demo)
-        this->FIFO.pop_front();
+    // 4. Advance the calcium fluorescence filter
+    if (this->CaFilterEnabled) {
         // Flipping sign of Vdiff, clipping at 0, scaling by V_AHP (see SignalFunctions.py demo)
         float v = this->VRest_mV - this->Vm_mV;
         v = v < 0.0 ? 0.0 : v / (-this->VAHP_mV);
-        this->FIFO.push_back(v);
+        this->CaStateRise = this->CaAlphaRise * this->CaStateRise + v;
+        this->CaStateDecay = this->CaAlphaDecay * this->CaStateDecay + v;
     }
 
     if (recording)
@@ -245,7 +243,9 @@ void BSNeuron::SpontaneousActivity(float t_ms) {
         if (this->TSpontNext_ms >= 0) this->TAct_ms.push_back(t_ms);
 
         // Obtain interval to the next spontaneous event from the distribution.
-        float dt_spont = this->DtSpontDist->RandomSample(1)[0]; // Generate 1 random sample in a vector, take the 0th element.
+        // The draw only depends on (seed, neuron ID, draw number), not on the
+        // order in which neurons are updated.
+        float dt_spont = this->DtSpontDist->CounterSample(this->SpontKey, this->SpontDraws++);
         this->TSpontNext_ms = t_ms + dt_spont;
     }
 };
@@ -277,61 +277,24 @@ void BSNeuron::Update(float t_ms, bool recording) {
     this->T_ms = t_ms;
 };
 
-//! Sets the initial value of the FIFO and prepares a buffer for convolvedFIFO.
-//! FIFO_dt_ms == 0.0 means used a FIFO of size 1.
-void BSNeuron::SetFIFO(float FIFO_ms, float FIFO_dt_ms, size_t reversed_kernel_size) {
-    assert(FIFO_ms >= 0.0 && FIFO_dt_ms >= 0.0);
-
-    size_t fifoSize = FIFO_dt_ms == 0.0 ? 1 : FIFO_ms / FIFO_dt_ms + 1;
-
-    for (size_t i = 0; i < fifoSize; ++i) this->FIFO.emplace_back(0.0);
-
-    size_t convolvedFIFO_size = this->FIFO.size() + reversed_kernel_size - 1;
-    this->ConvolvedFIFO.resize(convolvedFIFO_size, 0.0);
+//! Each step the filter computes y(n) = CaScale * (D(n) - R(n)) with
+//! R(n) = CaAlphaRise * R(n-1) + v(n) and D(n) = CaAlphaDecay * D(n-1) + v(n),
+//! so its impulse response is CaScale * (exp(-t/TauDecay) - exp(-t/TauRise)),
+//! the same double exponential as the fluorescence kernel.
+void BSNeuron::SetCaFilter(float TauRise_ms, float TauDecay_ms, float Dt_ms, float Scale) {
+    assert(TauRise_ms >= 0.0 && TauDecay_ms >= 0.0 && Dt_ms >= 0.0);
+
+    this->CaFilterEnabled = true;
+    this->CaAlphaRise = exp(-Dt_ms / TauRise_ms);
+    this->CaAlphaDecay = exp(-Dt_ms / TauDecay_ms);
+    this->CaScale = Scale;
+    this->CaStateRise = 0.0;
+    this->CaStateDecay = 0.0;
 };
 
-//! NOTE: SetFIFO must be called first, otherwise the FIFO is not
-//!       updated in UpdateVm.
-//! NOTE: We flip signal FIFO, because most recent is in [0] and kernel
-//!       has specific time-order.
-//!       (Alternatively, we could flip the prepared kernel and take
-//!       care to view [0] as most recent in covolution result.)
-//! NOTE: For efficiency (see Convolve1D), we provide a reversed kernel
-//!       that was reversed and stored during initialization.
-//! The FIFO buffer contains a record of the difference between Vm and Vrest
-//! at current and preceding time points.
-void BSNeuron::UpdateConvolvedFIFO(const std::vector<float> & reversed_kernel) {
-    assert(!reversed_kernel.empty());
-
-    // *** TESTING non-reversal of anything (see SignalFuctions.py)
-    // Reverse signal FIFO:
-    // std::vector<float> CaSignal(this->FIFO.size(), 0.0);
-    // std::reverse_copy(this->FIFO.begin(), this->FIFO.end(), CaSignal.begin());
-
-    // Convolve with kernel:
-    if (SignalFunctions::Convolve1D(FIFO, reversed_kernel, this->ConvolvedFIFO)) {
-
-        // Record Ca value with offset and record time-point:
-        // Convolution results applicable to recent Vdiff are at end of ConvolvedFIFO (see SignalFunctions.py)
-        this->CaSamples.emplace_back(ConvolvedFIFO[ConvolvedFIFO.size()-10]); //+1.0);
-// if (ID==0) {
-//     std::cout << "DEBUG --> New Convolved value: " << this->CaSamples.back() << '\n';
-//     std::cout << "Kernel: ";
-//     for (auto & v : reversed_kernel) {
-//         std::cout << v << ' ';
-//     }
-//     std::cout << "\nFIFO: ";
-//     for (auto & v : FIFO) {
-//         std::cout << v << ' ';
-//     }
-//     std::cout << "\nConvolved: ";
-//     for (auto & v : ConvolvedFIFO) {
-//         std::cout << v << ' ';
-//     }
-//     std::cout << '\n';
-// }
-        this->TCaSamples_ms.emplace_back(this->T_ms);
-    }
+void BSNeuron::RecordCaSample() {
+    this->CaSamples.emplace_back(this->CaScale * (this->CaStateDecay - this->CaStateRise));
+    this->TCaSamples_ms.emplace_back(this->T_ms);
 };
 
 void BSNeuron::InputReceptorAdded(CoreStructs::ReceptorData RData) {
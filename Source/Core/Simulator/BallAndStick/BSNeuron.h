@@ -87,12 +87,21 @@ public:
 
     std::vector<float> TRecorded_ms{};
     std::vector<float> VmRecorded_mV{};
-    std::deque<float> FIFO{};
-    std::vector<float> ConvolvedFIFO{};
+
+    // Two-pole IIR filter whose impulse response is the fluorescence kernel
+    // CaScale * (exp(-t / TauDecay) - exp(-t / TauRise)), see SetCaFilter().
+    bool CaFilterEnabled = false;
+    float CaAlphaRise = 0.0;  /**Per-step decay factor exp(-Dt / TauRise)*/
+    float CaAlphaDecay = 0.0; /**Per-step decay factor exp(-Dt / TauDecay)*/
+    float CaScale = 0.0;      /**Kernel normalization, 1 / sum of the sampled kernel*/
+    float CaStateRise = 0.0;
+    float CaStateDecay = 0.0;
     std::vector<CoreStructs::ReceptorData> ReceptorDataVec{};
     std::vector<CoreStructs::ReceptorData> TransmitterDataVec{};
 
     std::shared_ptr<Distributions::Distribution> DtSpontDist{}; //! Distribution for delta t spontaneous (time changed since last spontaneous activity).
+    uint64_t SpontKey = 0;   //! Key of the counter-based stream of spontaneous intervals, from the seed and the neuron ID.
+    uint64_t SpontDraws = 0; //! Number of intervals drawn from that stream, the counter of the next one.
 
 protected:
     BSNeuron(int _ID) {
@@ -159,19 +168,15 @@ public:
     //! and the time of update.
     void Update(float t_ms, bool recording);
 
-    //! NOTE: SetFIFO must be called first, otherwise the FIFO is not
+    //! Records the current output of the calcium filter as a Ca sample.
+    //! NOTE: SetCaFilter must be called first, otherwise the filter is not
     //!       updated in UpdateVm.
-    //! NOTE: We flip signal FIFO, because most recent is in [0] and kernel
-    //!       has specific time-order.
-    //!       (Alternatively, we could flip the prepared kernel and take
-    //!       care to view [0] as most recent in covolution result.)
-    //! NOTE: For efficiency (see Convolve1D), we provide a reversed kernel
-    //!       that was reversed and stored during initialization.
-    void UpdateConvolvedFIFO(const std::vector<float> & reversed_kernel);
-
-    //! Sets the initial value of the FIFO and prepares a buffer for convolvedFIFO.
-    //! FIFO_dt_ms == 0.0 means used a FIFO of size 1.
-    void SetFIFO(float FIFO_ms, float FIFO_dt_ms, size_t reversed_kernel_size);
+    void RecordCaSample();
+
+    //! Enables the calcium filter, which convolves the clipped and scaled
+    //! Vm deviation with the double exponential fluorescence kernel in O(1)
+    //! per step, and resets its state.
+    void SetCaFilter(float TauRise_ms, float TauDecay_ms, float Dt_ms, float Scale);
 
     virtual void InputReceptorAdded(CoreStructs::ReceptorData RData);
 
@@ -49,8 +49,7 @@ struct BSNeuronTest : testing::Test {
     }
 
     void Simulate() {
-        std::vector<float> reversed_kernel(10, 0.0);
-        testBSNeuron->SetFIFO(1.1, 0.1, reversed_kernel.size());
+        testBSNeuron->SetCaFilter(0.2, 0.5, 0.1, 1.0);
         testBSNeuron->SetSpontaneousActivity(0.5, 5.0, 0);
 
         for (float val : times_ms)
@@ -263,47 +262,37 @@ TEST_F(BSNeuronTest, test_Update_default) {
     ASSERT_TRUE(testBSNeuron->TSpontNext_ms >= 0.0);
 }
 
-TEST_F(BSNeuronTest, test_SetFIFO_default) {
-    // Immediately after set up, size of FIFO has not been set
-    ASSERT_EQ(testBSNeuron->FIFO.size(), 0);
+TEST_F(BSNeuronTest, test_SetCaFilter_default) {
+    // Immediately after set up, the Ca filter is not enabled
+    ASSERT_FALSE(testBSNeuron->CaFilterEnabled);
 
-    float FIFO_ms = 1.1, dt_ms = 0.1;
-    size_t expectedFIFOSize = FIFO_ms / dt_ms + 1;
+    testBSNeuron->SetCaFilter(0.2, 0.5, 0.1, 2.0);
 
-    std::vector<float> reversed_kernel(10, 0.0);
-    testBSNeuron->SetFIFO(1.1, 0.1, reversed_kernel.size());
-
-    ASSERT_EQ(testBSNeuron->FIFO.size(), expectedFIFOSize);
+    ASSERT_TRUE(testBSNeuron->CaFilterEnabled);
+    ASSERT_NEAR(testBSNeuron->CaAlphaRise, std::exp(-0.1 / 0.2), tol);
+    ASSERT_NEAR(testBSNeuron->CaAlphaDecay, std::exp(-0.1 / 0.5), tol);
+    ASSERT_EQ(testBSNeuron->CaScale, 2.0);
+    ASSERT_EQ(testBSNeuron->CaStateRise, 0.0);
+    ASSERT_EQ(testBSNeuron->CaStateDecay, 0.0);
 }
 
-TEST_F(BSNeuronTest, test_UpdateConvolvedFIFO_default) {
-    std::vector<float> reversed_kernel = {1.0, 0.0, -1.0};
-    std::vector<float> expectedConvolvedFIFO{};
-    std::deque<float> FIFO{};
-
+TEST_F(BSNeuronTest, test_RecordCaSample_default) {
     // Simulate
     Simulate();
 
-    testBSNeuron->UpdateConvolvedFIFO(reversed_kernel);
-
-    std::reverse_copy(testBSNeuron->FIFO.begin(), testBSNeuron->FIFO.end(), FIFO.begin());
+    testBSNeuron->RecordCaSample();
 
-    for (size_t i = 0; i < FIFO.size(); ++i) {
-        FIFO[i] *= -1.0;
-        if (FIFO[i] < 0.0)
-            FIFO[i] = 0.0;
+    // The filter output must equal the convolution of the clipped and
+    // scaled Vm deviation with the double exponential kernel.
+    float expected = 0.0;
+    size_t numSteps = testBSNeuron->VmRecorded_mV.size();
+    for (size_t m = 0; m < numSteps; ++m) {
+        float v = testBSNeuron->VRest_mV - testBSNeuron->VmRecorded_mV[numSteps - 1 - m];
+        v = v < 0.0 ? 0.0 : v / (-testBSNeuron->VAHP_mV);
+        expected += v * BG::NES::Simulator::SignalFunctions::DoubleExponentExpr(1.0, 0.2, 0.5, 0.1 * m);
     }
 
-    expectedConvolvedFIFO.resize(FIFO.size(), 0.0);
-
-    BG::NES::Simulator::SignalFunctions::Convolve1D(FIFO, reversed_kernel, expectedConvolvedFIFO);
-
-    ASSERT_EQ(testBSNeuron->ConvolvedFIFO.size(), expectedConvolvedFIFO.size());
-    for (size_t i = 0; i < testBSNeuron->ConvolvedFIFO.size(); ++i)
-        ASSERT_NEAR(testBSNeuron->ConvolvedFIFO[i], expectedConvolvedFIFO[i],
-                    tol);
-
-    ASSERT_EQ(testBSNeuron->CaSamples.back(),
-              testBSNeuron->ConvolvedFIFO.back() + 1.0f);
+    ASSERT_EQ(testBSNeuron->CaSamples.size(), 1);
+    ASSERT_NEAR(testBSNeuron->CaSamples.back(), expected, tol);
     ASSERT_EQ(testBSNeuron->TCaSamples_ms.back(), 1.6f);
 }
@@ -0,0 +1,537 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the BSNeuronArrays struct.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include <Simulator/BallAndStick/BSNeuronArrays.h>
+#include <Simulator/Structs/SignalFunctions.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace BallAndStick {
+
+bool BSNeuronArrays::Supports(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons) {
+    for (const auto & neuron_ptr : _Neurons) {
+        if (!neuron_ptr) return false;
+        if (neuron_ptr->Class_ < CoreStructs::_BSNeuron) return false;
+    }
+    return true;
+}
+
+void BSNeuronArrays::GatherFromNeurons(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons, float _T_ms) {
+    assert(Supports(_Neurons));
+
+    size_t NumNeurons = _Neurons.size();
+
+    NeuronPtrs.resize(NumNeurons);
+    VRest_mV.resize(NumNeurons);
+    VAct_mV.resize(NumNeurons);
+    VAHP_mV.resize(NumNeurons);
+    TauAHP_ms.resize(NumNeurons);
+    Vm_mV.resize(NumNeurons);
+    VSpike_mV.assign(NumNeurons, 0.0);
+    VAHPt_mV.assign(NumNeurons, 0.0);
+    DtAct_ms.resize(NumNeurons);
+    TLastSpike_ms.resize(NumNeurons);
+    TLastSpikePrev_ms.resize(NumNeurons);
+    HasSpiked.resize(NumNeurons);
+    HasSpikedPrev.resize(NumNeurons);
+    InAbsRef.resize(NumNeurons);
+    HasSpont.resize(NumNeurons);
+    TSpontNext_ms.resize(NumNeurons);
+    SpontDraws.resize(NumNeurons);
+    TNextDirectStim_ms.resize(NumNeurons);
+    Dirty.assign(NumNeurons, 0);
+    CaFilterEnabled.resize(NumNeurons);
+    CaAlphaRise.resize(NumNeurons);
+    CaAlphaDecay.resize(NumNeurons);
+    CaStateRise.resize(NumNeurons);
+    CaStateDecay.resize(NumNeurons);
+    InOffset.assign(NumNeurons + 1, 0);
+    InSrcNeuron.clear();
+    InActive.clear();
+    InAmp.clear();
+    InTauRise_ms.clear();
+    InTauDecay_ms.clear();
+    InExpiry_ms.clear();
+    InLive.clear();
+    InAlphaRise.clear();
+    InAlphaDecay.clear();
+    LiveIn.assign(NumNeurons, {});
+    LiveInSorted.assign(NumNeurons, 0);
+    Candidates.clear();
+    Candidates.reserve(NumNeurons);
+    TLastStep_ms = -1.0;
+
+    for (size_t i = 0; i < NumNeurons; i++) {
+        BSNeuron* Neuron = static_cast<BSNeuron*>(_Neurons[i].get());
+        NeuronPtrs[i] = Neuron;
+
+        VRest_mV[i] = Neuron->VRest_mV;
+        VAct_mV[i] = Neuron->VAct_mV;
+        VAHP_mV[i] = Neuron->VAHP_mV;
+        TauAHP_ms[i] = Neuron->TauAHP_ms;
+
+        Vm_mV[i] = Neuron->Vm_mV;
+        DtAct_ms[i] = Neuron->_dt_act_ms;
+        HasSpiked[i] = !Neuron->TAct_ms.empty();
+        TLastSpike_ms[i] = Neuron->TAct_ms.empty() ? 0.0 : Neuron->TAct_ms.back();
+        InAbsRef[i] = Neuron->in_absref;
+        HasSpont[i] = (Neuron->TauSpont_ms.stdev != 0) && (Neuron->DtSpontDist != nullptr);
+        TSpontNext_ms[i] = Neuron->TSpontNext_ms;
+        SpontDraws[i] = Neuron->SpontDraws;
+        TNextDirectStim_ms[i] = Neuron->TDirectStim_ms.empty() ? _NO_DIRECT_STIM_ms : Neuron->TDirectStim_ms.front();
+
+        CaFilterEnabled[i] = Neuron->CaFilterEnabled;
+        CaAlphaRise[i] = Neuron->CaAlphaRise;
+        CaAlphaDecay[i] = Neuron->CaAlphaDecay;
+        CaStateRise[i] = Neuron->CaStateRise;
+        CaStateDecay[i] = Neuron->CaStateDecay;
+
+        // The amplitude is constant between runs, so it is divided out once here
+        // instead of in every step as in BSNeuron::VPSPT_mV.
+        for (const auto & receptorData : Neuron->ReceptorDataVec) {
+            float Conductance_nS = receptorData.ReceptorPtr->Conductance_nS;
+            InSrcNeuron.push_back(receptorData.SrcNeuronID);
+            InActive.push_back(Conductance_nS != 0.0);
+            InAmp.push_back((Conductance_nS != 0.0) ? Neuron->IPSP_nA / Conductance_nS : 0.0);
+            InTauRise_ms.push_back(receptorData.ReceptorPtr->TimeConstantRise_ms);
+            InTauDecay_ms.push_back(receptorData.ReceptorPtr->TimeConstantDecay_ms);
+
+            // Both exponentials of DoubleExponentExpr() are below the epsilon
+            // after -ln(epsilon) of the larger time constant.
+            float TauMax_ms = std::max(receptorData.ReceptorPtr->TimeConstantRise_ms, receptorData.ReceptorPtr->TimeConstantDecay_ms);
+            InExpiry_ms.push_back(-log(_PSP_EXPIRY_EPSILON) * TauMax_ms);
+
+            InAlphaRise.push_back(exp(-Dt_ms / receptorData.ReceptorPtr->TimeConstantRise_ms));
+            InAlphaDecay.push_back(exp(-Dt_ms / receptorData.ReceptorPtr->TimeConstantDecay_ms));
+        }
+        InOffset[i + 1] = InSrcNeuron.size();
+    }
+    InLive.assign(InSrcNeuron.size(), 0);
+
+    // Output receptors, built from the input receptors by counting sort on the
+    // source, so that each spike event knows which receptors it reaches.
+    OutOffset.assign(NumNeurons + 1, 0);
+    for (int Src : InSrcNeuron) OutOffset[Src + 1]++;
+    for (size_t i = 0; i < NumNeurons; i++) OutOffset[i + 1] += OutOffset[i];
+    OutDstNeuron.resize(InSrcNeuron.size());
+    OutReceptor.resize(InSrcNeuron.size());
+    std::vector<size_t> OutFill(OutOffset.begin(), OutOffset.end() - 1);
+    for (size_t i = 0; i < NumNeurons; i++) {
+        for (size_t r = InOffset[i]; r < InOffset[i + 1]; r++) {
+            size_t o = OutFill[InSrcNeuron[r]]++;
+            OutDstNeuron[o] = i;
+            OutReceptor[o] = r;
+        }
+    }
+
+    // Receptors of neurons that have spiked before may still be non-zero,
+    // stale ones are dropped again in the first step.
+    for (size_t i = 0; i < NumNeurons; i++) {
+        for (size_t r = InOffset[i]; r < InOffset[i + 1]; r++) {
+            if (!InActive[r] || !HasSpiked[InSrcNeuron[r]]) continue;
+            InLive[r] = 1;
+            LiveIn[i].push_back(r);
+        }
+        LiveInSorted[i] = LiveIn[i].size();
+    }
+    RebuildReceptorState(_T_ms - Dt_ms);
+
+    // Prev is the spike state at the start of a step, it is kept up to date
+    // at the end of every step from here on.
+    TLastSpikePrev_ms = TLastSpike_ms;
+    HasSpikedPrev = HasSpiked;
+
+    UpdatePartitions();
+}
+
+/**
+ * Sets the recursive PSP state to its value at t_ms, i.e. after the step at
+ * t_ms, summed over all spikes up to then that have not expired yet.
+ */
+void BSNeuronArrays::RebuildReceptorState(float t_ms) {
+    if (PSPIntegration != PSPINTEGRATION_RECURSIVE) {
+        InStateRise.clear();
+        InStateDecay.clear();
+        return;
+    }
+
+    InStateRise.assign(InSrcNeuron.size(), 0.0);
+    InStateDecay.assign(InSrcNeuron.size(), 0.0);
+    for (size_t i = 0; i < NeuronPtrs.size(); i++) {
+        for (uint32_t r : LiveIn[i]) {
+            const std::vector<float> & TAct_ms = NeuronPtrs[InSrcNeuron[r]]->TAct_ms;
+            for (auto it = TAct_ms.rbegin(); it != TAct_ms.rend(); ++it) {
+                float dt_ms = t_ms - *it;
+                if (dt_ms > InExpiry_ms[r]) break;
+                if (dt_ms < 0.0) continue;
+                InStateRise[r] += InAmp[r] * exp(-dt_ms / InTauRise_ms[r]);
+                InStateDecay[r] += InAmp[r] * exp(-dt_ms / InTauDecay_ms[r]);
+            }
+        }
+    }
+}
+
+void BSNeuronArrays::SetNumThreads(size_t _NumThreads) {
+    NumThreads = std::max<size_t>(_NumThreads, 1);
+    UpdatePartitions();
+}
+
+/**
+ * Splits the neurons into contiguous partitions of about equal work, counted
+ * as one unit per neuron plus one per input receptor. Small networks are not
+ * split, as the barriers would cost more than the update itself.
+ */
+void BSNeuronArrays::UpdatePartitions() {
+    const size_t NumNeurons = NeuronPtrs.size();
+    size_t NumPartitions = std::min(NumThreads, std::max<size_t>(NumNeurons / _MIN_NEURONS_PER_PARTITION, 1));
+
+    PartitionBegin.assign(NumPartitions + 1, NumNeurons);
+    PartitionBegin[0] = 0;
+    size_t TotalWork = NumNeurons + (InOffset.empty() ? 0 : InOffset.back());
+    size_t i = 0;
+    for (size_t p = 1; p < NumPartitions; p++) {
+        size_t TargetWork = (TotalWork * p) / NumPartitions;
+        while ((i < NumNeurons) && (i + InOffset[i] < TargetWork)) i++;
+        PartitionBegin[p] = i;
+    }
+    PartitionCandidates.resize(NumPartitions);
+
+    if (NumPartitions <= 1) {
+        Team.reset();
+    } else if (!Team || (Team->Size() != NumPartitions)) {
+        Team = std::make_unique<Util::WorkerTeam>(NumPartitions);
+    }
+}
+
+void BSNeuronArrays::ScatterVm() {
+    for (size_t i = 0; i < NeuronPtrs.size(); i++) {
+        NeuronPtrs[i]->Vm_mV = Vm_mV[i];
+    }
+}
+
+void BSNeuronArrays::ScatterCa(float t_ms) {
+    for (size_t i = 0; i < NeuronPtrs.size(); i++) {
+        BSNeuron* Neuron = NeuronPtrs[i];
+        Neuron->T_ms = t_ms;
+        Neuron->CaStateRise = CaStateRise[i];
+        Neuron->CaStateDecay = CaStateDecay[i];
+    }
+}
+
+void BSNeuronArrays::ScatterToNeurons() {
+    ScatterVm();
+    if (TLastStep_ms >= 0.0) ScatterCa(TLastStep_ms);
+    for (size_t i = 0; i < NeuronPtrs.size(); i++) {
+        BSNeuron* Neuron = NeuronPtrs[i];
+        Neuron->_has_spiked = HasSpiked[i];
+        Neuron->in_absref = InAbsRef[i];
+        Neuron->_dt_act_ms = DtAct_ms[i];
+        Neuron->TSpontNext_ms = TSpontNext_ms[i];
+        Neuron->SpontDraws = SpontDraws[i];
+    }
+}
+
+/**
+ * Same as step 1 of BSNeuron::Update(). Only touches the neuron objects of
+ * its own range, so partitions can apply direct stimulation concurrently.
+ */
+void BSNeuronArrays::ApplyDirectStim(float t_ms, size_t _Begin, size_t _End) {
+    for (size_t i = _Begin; i < _End; i++) {
+        if (TNextDirectStim_ms[i] > t_ms) continue;
+
+        std::deque<float> & TDirectStim_ms = NeuronPtrs[i]->TDirectStim_ms;
+        float tFire_ms = TDirectStim_ms.front();
+        NeuronPtrs[i]->TAct_ms.push_back(tFire_ms);
+        TDirectStim_ms.pop_front();
+        TNextDirectStim_ms[i] = TDirectStim_ms.empty() ? _NO_DIRECT_STIM_ms : TDirectStim_ms.front();
+
+        TLastSpike_ms[i] = tFire_ms;
+        HasSpiked[i] = 1;
+        Dirty[i] = 1; // A self-connection sees the stimulation.
+    }
+}
+
+//! Same as BSNeuron::VSpikeT_mV() and BSNeuron::VAHPT_mV().
+void BSNeuronArrays::UpdateOwnPotentials(float t_ms, size_t _Begin, size_t _End) {
+    for (size_t i = _Begin; i < _End; i++) {
+        if (!HasSpiked[i]) {
+            VSpike_mV[i] = 0.0;
+            VAHPt_mV[i] = 0.0;
+            continue;
+        }
+        float dtAct_ms = t_ms - TLastSpike_ms[i];
+        bool absref = (dtAct_ms <= _TAU_ABS_ms);
+        DtAct_ms[i] = dtAct_ms;
+        InAbsRef[i] = absref;
+        VSpike_mV[i] = absref ? _VSPIKE_ABS_REF_mV : 0.0;
+        float vAHPt = VAHP_mV[i] * exp(-dtAct_ms / TauAHP_ms[i]);
+        VAHPt_mV[i] = absref ? 0.0 : vAHPt;
+    }
+}
+
+/**
+ * Merges the receptors appended to the live list of a neuron since it was
+ * last sorted into the ascending part.
+ */
+void BSNeuronArrays::SortLive(size_t _NeuronIdx) {
+    std::vector<uint32_t> & Live = LiveIn[_NeuronIdx];
+    auto Appended = Live.begin() + LiveInSorted[_NeuronIdx];
+    if (Appended != Live.end()) {
+        std::sort(Appended, Live.end());
+        std::inplace_merge(Live.begin(), Appended, Live.end());
+    }
+    LiveInSorted[_NeuronIdx] = Live.size();
+}
+
+/**
+ * Same as BSNeuron::VPSPT_mV(), visiting only the live receptors in the same
+ * order. The others contribute exactly zero. With _UseCurrent set, sources up
+ * to and including this neuron are seen with their spike state from this
+ * step, as they would have been updated already in the list-of-neurons method.
+ */
+float BSNeuronArrays::PSPFromSpikeState(size_t _NeuronIdx, float t_ms, bool _UseCurrent) const {
+    float vPSPt_mV = 0.0;
+    for (uint32_t r : LiveIn[_NeuronIdx]) {
+        size_t Src = InSrcNeuron[r];
+        bool Current = _UseCurrent && (Src <= _NeuronIdx);
+        if (!(Current ? HasSpiked[Src] : HasSpikedPrev[Src])) continue;
+
+        float dtPSP_ms = t_ms - (Current ? TLastSpike_ms[Src] : TLastSpikePrev_ms[Src]);
+        vPSPt_mV += SignalFunctions::DoubleExponentExpr(InAmp[r], InTauRise_ms[r], InTauDecay_ms[r], dtPSP_ms);
+    }
+    return vPSPt_mV;
+}
+
+//! Sum of the recursive PSP state of the live receptors of a neuron.
+float BSNeuronArrays::PSPFromReceptorState(size_t _NeuronIdx) const {
+    float vPSPt_mV = 0.0;
+    for (uint32_t r : LiveIn[_NeuronIdx]) {
+        vPSPt_mV += InStateDecay[r] - InStateRise[r];
+    }
+    return vPSPt_mV;
+}
+
+/**
+ * Also drops receptors whose PSP has expired. A receptor whose source spikes
+ * again in this step is made live again in the resolution phase, before any
+ * neuron that would see that spike is recomputed. With recursive integration
+ * the state of the live receptors is advanced by one step here.
+ */
+void BSNeuronArrays::UpdatePSP(float t_ms, size_t _Begin, size_t _End) {
+    const bool Recursive = (PSPIntegration == PSPINTEGRATION_RECURSIVE);
+    for (size_t i = _Begin; i < _End; i++) {
+        SortLive(i);
+        std::vector<uint32_t> & Live = LiveIn[i];
+        size_t NumLive = 0;
+        for (uint32_t r : Live) {
+            size_t Src = InSrcNeuron[r];
+            if (HasSpikedPrev[Src] && ((t_ms - TLastSpikePrev_ms[Src]) > InExpiry_ms[r])) {
+                InLive[r] = 0;
+                if (Recursive) {
+                    InStateRise[r] = 0.0;
+                    InStateDecay[r] = 0.0;
+                }
+                continue;
+            }
+            if (Recursive) {
+                InStateRise[r] *= InAlphaRise[r];
+                InStateDecay[r] *= InAlphaDecay[r];
+            }
+            Live[NumLive++] = r;
+        }
+        Live.resize(NumLive);
+        LiveInSorted[i] = NumLive;
+
+        float vPSPt_mV = Recursive ? PSPFromReceptorState(i) : PSPFromSpikeState(i, t_ms, false);
+        Vm_mV[i] = VRest_mV[i] + VSpike_mV[i] + VAHPt_mV[i] + vPSPt_mV;
+    }
+}
+
+/**
+ * Collects the neurons of a range whose spike state may change in this step.
+ * These are pushed in increasing order, so the per-partition lists joined in
+ * partition order already are a valid min-heap.
+ */
+void BSNeuronArrays::FindCandidates(float t_ms, size_t _Begin, size_t _End, std::vector<int>& _Candidates) const {
+    _Candidates.clear();
+    for (size_t i = _Begin; i < _End; i++) {
+        bool Threshold = !InAbsRef[i] && (Vm_mV[i] >= VAct_mV[i]);
+        bool Spont = !InAbsRef[i] && HasSpont[i] && (t_ms >= TSpontNext_ms[i]);
+        if (Dirty[i] || Threshold || Spont) _Candidates.push_back(i);
+    }
+}
+
+void BSNeuronArrays::AddSpike(size_t _NeuronIdx, float t_ms) {
+    NeuronPtrs[_NeuronIdx]->TAct_ms.push_back(t_ms);
+    TLastSpike_ms[_NeuronIdx] = t_ms;
+    HasSpiked[_NeuronIdx] = 1;
+}
+
+bool BSNeuronArrays::SpikeStateChanged(size_t _NeuronIdx) const {
+    return (HasSpiked[_NeuronIdx] != HasSpikedPrev[_NeuronIdx]) || (TLastSpike_ms[_NeuronIdx] != TLastSpikePrev_ms[_NeuronIdx]);
+}
+
+/**
+ * Makes the output receptors of a neuron whose spike state changed live.
+ * With recursive integration the new spike is also added to their state.
+ * Must be called once per step and neuron at most.
+ */
+void BSNeuronArrays::DeliverSpikeEvents(size_t _NeuronIdx, float t_ms) {
+    const bool Recursive = (PSPIntegration == PSPINTEGRATION_RECURSIVE);
+    float dtSpike_ms = t_ms - TLastSpike_ms[_NeuronIdx]; // Non-zero for direct stimulation in the past.
+    for (size_t o = OutOffset[_NeuronIdx]; o < OutOffset[_NeuronIdx + 1]; o++) {
+        uint32_t r = OutReceptor[o];
+        if (!InActive[r]) continue;
+
+        if (Recursive) {
+            InStateRise[r] += (dtSpike_ms > 0.0) ? InAmp[r] * exp(-dtSpike_ms / InTauRise_ms[r]) : InAmp[r];
+            InStateDecay[r] += (dtSpike_ms > 0.0) ? InAmp[r] * exp(-dtSpike_ms / InTauDecay_ms[r]) : InAmp[r];
+        }
+
+        if (InLive[r]) continue;
+        InLive[r] = 1;
+        LiveIn[OutDstNeuron[o]].push_back(r);
+    }
+}
+
+/**
+ * Same as BSNeuron::DetectThreshold() and BSNeuron::SpontaneousActivity(),
+ * visited in neuron order. Spontaneous intervals come from per-neuron
+ * counter-based streams, so they match the list-of-neurons method and do
+ * not depend on the visiting order.
+ * A neuron whose spike state changed makes its higher-index targets dirty,
+ * because those would have seen the new state in the list-of-neurons method.
+ * Spike events of direct stimulation are delivered before the neuron itself
+ * is recomputed, as a self-connection sees the stimulation.
+ */
+void BSNeuronArrays::ResolveSpikes(float t_ms) {
+    int LastNeuron = -1;
+    while (!Candidates.empty()) {
+        std::pop_heap(Candidates.begin(), Candidates.end(), std::greater<int>());
+        int i = Candidates.back();
+        Candidates.pop_back();
+        if (i == LastNeuron) continue;
+        LastNeuron = i;
+
+        bool Delivered = false;
+        if (Dirty[i]) {
+            if (SpikeStateChanged(i)) {
+                DeliverSpikeEvents(i, t_ms);
+                Delivered = true;
+            }
+            SortLive(i);
+            float vPSPt_mV = (PSPIntegration == PSPINTEGRATION_RECURSIVE) ? PSPFromReceptorState(i) : PSPFromSpikeState(i, t_ms, true);
+            Vm_mV[i] = VRest_mV[i] + VSpike_mV[i] + VAHPt_mV[i] + vPSPt_mV;
+            Dirty[i] = 0;
+        }
+
+        float TDelivered_ms = TLastSpike_ms[i];
+        if (!InAbsRef[i]) {
+            if (Vm_mV[i] >= VAct_mV[i]) AddSpike(i, t_ms);
+
+            if (HasSpont[i] && (t_ms >= TSpontNext_ms[i])) {
+                if (TSpontNext_ms[i] >= 0) AddSpike(i, t_ms);
+                float dt_spont = NeuronPtrs[i]->DtSpontDist->CounterSample(NeuronPtrs[i]->SpontKey, SpontDraws[i]++);
+                TSpontNext_ms[i] = t_ms + dt_spont;
+            }
+        }
+
+        if (!SpikeStateChanged(i)) continue;
+        if (!Delivered || (TLastSpike_ms[i] != TDelivered_ms)) DeliverSpikeEvents(i, t_ms);
+
+        for (size_t o = OutOffset[i]; o < OutOffset[i + 1]; o++) {
+            int Dst = OutDstNeuron[o];
+            if ((Dst <= i) || Dirty[Dst]) continue;
+            Dirty[Dst] = 1;
+            Candidates.push_back(Dst);
+            std::push_heap(Candidates.begin(), Candidates.end(), std::greater<int>());
+        }
+    }
+}
+
+//! Same as step 4 of BSNeuron::UpdateVm() and BSNeuron::Record().
+void BSNeuronArrays::UpdateCaAndRecord(float t_ms, bool recording, size_t _Begin, size_t _End) {
+    for (size_t i = _Begin; i < _End; i++) {
+        if (!CaFilterEnabled[i]) continue;
+        float v = VRest_mV[i] - Vm_mV[i];
+        v = v < 0.0 ? 0.0 : v / (-VAHP_mV[i]);
+        CaStateRise[i] = CaAlphaRise[i] * CaStateRise[i] + v;
+        CaStateDecay[i] = CaAlphaDecay[i] * CaStateDecay[i] + v;
+    }
+
+    if (!recording) return;
+    for (size_t i = _Begin; i < _End; i++) {
+        NeuronPtrs[i]->TRecorded_ms.emplace_back(t_ms);
+        NeuronPtrs[i]->VmRecorded_mV.emplace_back(Vm_mV[i]);
+    }
+}
+
+/**
+ * Compute phase of a partition. Reads the spike state of other partitions
+ * only through the Prev arrays, which are not written during this phase.
+ */
+void BSNeuronArrays::ComputePartition(size_t _Partition, float t_ms) {
+    size_t Begin = PartitionBegin[_Partition];
+    size_t End = PartitionBegin[_Partition + 1];
+    ApplyDirectStim(t_ms, Begin, End);
+    UpdateOwnPotentials(t_ms, Begin, End);
+    UpdatePSP(t_ms, Begin, End);
+    FindCandidates(t_ms, Begin, End, PartitionCandidates[_Partition]);
+}
+
+//! Publish phase of a partition, also makes this step's spike state the Prev state of the next step.
+void BSNeuronArrays::PublishPartition(size_t _Partition, float t_ms, bool recording) {
+    size_t Begin = PartitionBegin[_Partition];
+    size_t End = PartitionBegin[_Partition + 1];
+    UpdateCaAndRecord(t_ms, recording, Begin, End);
+    std::copy(TLastSpike_ms.begin() + Begin, TLastSpike_ms.begin() + End, TLastSpikePrev_ms.begin() + Begin);
+    std::copy(HasSpiked.begin() + Begin, HasSpiked.begin() + End, HasSpikedPrev.begin() + Begin);
+}
+
+/**
+ * Partitions are computed and published in parallel when a worker team is
+ * available. Spike resolution stays serial on the calling thread, so the
+ * within-step ordering and the random streams are the same for any number
+ * of threads, and results are bit-identical to serial execution.
+ */
+void BSNeuronArrays::Step(float t_ms, bool recording) {
+    assert(t_ms >= 0.0);
+    const size_t NumPartitions = PartitionCandidates.size();
+
+    if (Team) {
+        Team->Run([this, t_ms](size_t _Partition) { ComputePartition(_Partition, t_ms); });
+    } else {
+        for (size_t p = 0; p < NumPartitions; p++) ComputePartition(p, t_ms);
+    }
+
+    Candidates.clear();
+    for (const auto & PartCandidates : PartitionCandidates) {
+        Candidates.insert(Candidates.end(), PartCandidates.begin(), PartCandidates.end());
+    }
+    ResolveSpikes(t_ms);
+
+    if (Team) {
+        Team->Run([this, t_ms, recording](size_t _Partition) { PublishPartition(_Partition, t_ms, recording); });
+    } else {
+        for (size_t p = 0; p < NumPartitions; p++) PublishPartition(p, t_ms, recording);
+    }
+
+    TLastStep_ms = t_ms;
+}
+
+}; // namespace BallAndStick
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
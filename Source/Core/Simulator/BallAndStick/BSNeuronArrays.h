@@ -0,0 +1,204 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the BSNeuronArrays struct, a structure-of-arrays
+                 copy of the dynamic state of ball-and-stick neurons that is stepped
+                 in tight loops instead of through per-neuron virtual Update() calls.
+    Additional Notes: The update order and arithmetic of BSNeuron::Update() are
+                      reproduced exactly, so spikes and recordings are identical to
+                      the list-of-neurons method.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/BallAndStick/BSNeuron.h>
+#include <Simulator/Structs/Neuron.h>
+#include <Util/WorkerTeam.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace BallAndStick {
+
+//! Time value used for "no pending direct stimulation".
+#define _NO_DIRECT_STIM_ms std::numeric_limits<float>::infinity()
+
+//! Size of a PSP, relative to its amplitude, below which it counts as expired.
+//! Far below the float resolution of a membrane potential, so dropping it does not show in Vm.
+#define _PSP_EXPIRY_EPSILON 1e-10
+
+//! Ways of integrating postsynaptic potentials.
+//! PSPINTEGRATION_LATEST_SPIKE evaluates DoubleExponentExpr() for the latest
+//! presynaptic spike in every step, the same as BSNeuron::VPSPT_mV().
+//! PSPINTEGRATION_RECURSIVE keeps a decaying rise and decay state per receptor
+//! that is multiplied by a constant factor each step and incremented by every
+//! arriving spike, so overlapping PSPs add up and no exp() is evaluated.
+enum PSPIntegrationMethods { PSPINTEGRATION_LATEST_SPIKE, PSPINTEGRATION_RECURSIVE, NUMPSPINTEGRATIONMETHODS };
+
+//! Smallest number of neurons worth giving to a separate thread.
+#define _MIN_NEURONS_PER_PARTITION 512
+
+/**
+ * @brief Structure-of-arrays neuron state for the array simulation method.
+ *
+ * Neuron state is gathered from the BSNeuron objects at the start of a run,
+ * stepped in contiguous arrays, and scattered back at the end of the run.
+ * Spike times, direct stimulation and recordings are written to the neuron
+ * objects as they happen, so all other consumers keep working unchanged.
+ *
+ * A step is carried out in phases:
+ * 1. Compute (per partition): apply pending direct stimulation, compute
+ *    VSpike, VAHP and VPSP from the spike state at the start of the step
+ *    (tight loops over arrays) and collect spike candidates.
+ *    VPSP only visits live receptors, see below.
+ * 2. Resolve (serial): threshold crossings and spontaneous activity in
+ *    neuron order. The list-of-neurons method updates neurons one at a
+ *    time, so a neuron sees spikes of lower-index sources from the same
+ *    step. Only neurons with such a source (marked dirty) have their VPSP
+ *    recomputed.
+ * 3. Publish (per partition): advance Ca filters, write recording data, and snapshot
+ *    the spike state for the next step.
+ *
+ * Neurons are split into contiguous partitions, one per thread of a
+ * persistent worker team. Phases are separated by the team's barrier.
+ *
+ * Spikes are delivered as events: a change of spike state makes all output
+ * receptors of the neuron live, i.e. adds them to the live list of their
+ * target. A receptor is dropped from the list again once its PSP kernel has
+ * decayed below _PSP_EXPIRY_EPSILON of its amplitude (about 23 time constants),
+ * so the per-step PSP cost follows the recent spikes times fan-out instead of
+ * the number of receptors.
+ * New live receptors are appended, and each list is put back in ascending
+ * order once before it is next summed, so the sums keep the order of
+ * BSNeuron::VPSPT_mV().
+ */
+struct BSNeuronArrays {
+
+    std::vector<BSNeuron*> NeuronPtrs; /**Neuron objects, index is neuron ID*/
+
+    // Per-neuron parameters
+    std::vector<float> VRest_mV;
+    std::vector<float> VAct_mV;
+    std::vector<float> VAHP_mV;
+    std::vector<float> TauAHP_ms;
+
+    // Per-neuron dynamic state
+    std::vector<float> Vm_mV;
+    std::vector<float> VSpike_mV;
+    std::vector<float> VAHPt_mV;
+    std::vector<float> DtAct_ms;
+    std::vector<float> TLastSpike_ms;     /**Latest entry of TAct_ms, valid if HasSpiked*/
+    std::vector<float> TLastSpikePrev_ms; /**TLastSpike_ms at the start of the step*/
+    std::vector<uint8_t> HasSpiked;
+    std::vector<uint8_t> HasSpikedPrev;
+    std::vector<uint8_t> InAbsRef;
+    std::vector<uint8_t> HasSpont;
+    std::vector<float> TSpontNext_ms;
+    std::vector<uint64_t> SpontDraws; /**Counter of the next spontaneous interval, see BSNeuron::SpontDraws*/
+    std::vector<float> TNextDirectStim_ms;
+    std::vector<uint8_t> Dirty; /**VPSP must be recomputed in the resolution phase*/
+
+    // Calcium fluorescence filters, see BSNeuron::SetCaFilter()
+    std::vector<uint8_t> CaFilterEnabled;
+    std::vector<float> CaAlphaRise;
+    std::vector<float> CaAlphaDecay;
+    std::vector<float> CaStateRise;
+    std::vector<float> CaStateDecay;
+
+    // Input receptors of each neuron (CSR, in ReceptorDataVec order)
+    std::vector<size_t> InOffset;
+    std::vector<int> InSrcNeuron;
+    std::vector<uint8_t> InActive;  /**Conductance is non-zero*/
+    std::vector<float> InAmp;       /**IPSP_nA / Conductance_nS*/
+    std::vector<float> InTauRise_ms;
+    std::vector<float> InTauDecay_ms;
+    std::vector<float> InExpiry_ms; /**Time after a spike beyond which the PSP is below _PSP_EXPIRY_EPSILON*/
+    std::vector<uint8_t> InLive;    /**Receptor is in the LiveIn list of its target*/
+    std::vector<float> InAlphaRise;  /**Per-step decay factor of InStateRise, PSPINTEGRATION_RECURSIVE only*/
+    std::vector<float> InAlphaDecay; /**Per-step decay factor of InStateDecay, PSPINTEGRATION_RECURSIVE only*/
+    std::vector<float> InStateRise;  /**Sum of amp * exp(-dt / TauRise) over arrived spikes*/
+    std::vector<float> InStateDecay; /**Sum of amp * exp(-dt / TauDecay) over arrived spikes*/
+
+    std::vector<std::vector<uint32_t>> LiveIn; /**Receptors of each neuron that may have a non-zero PSP*/
+    std::vector<size_t> LiveInSorted;          /**Length of the ascending prefix of LiveIn, the rest was appended since*/
+
+    // Output receptors of each neuron (CSR, grouped by source from the input receptors)
+    std::vector<size_t> OutOffset;
+    std::vector<int> OutDstNeuron;
+    std::vector<uint32_t> OutReceptor; /**Index into the input receptor arrays*/
+
+    std::vector<int> Candidates; /**Neurons that may change spike state in this step, min-heap*/
+
+    size_t NumThreads = 1; /**Requested number of threads, see SetNumThreads()*/
+    std::vector<size_t> PartitionBegin; /**First neuron of each partition, followed by Size()*/
+    std::vector<std::vector<int>> PartitionCandidates; /**Candidates found by each partition*/
+    std::unique_ptr<Util::WorkerTeam> Team; /**Null when stepping on the calling thread only*/
+
+    float TLastStep_ms = -1.0; /**Time of the latest step, negative if no step was taken since gathering*/
+
+    PSPIntegrationMethods PSPIntegration = PSPINTEGRATION_LATEST_SPIKE; /**Set before gathering*/
+    float Dt_ms = 1.0; /**Step size, used by PSPINTEGRATION_RECURSIVE*/
+
+    size_t Size() const { return NeuronPtrs.size(); }
+
+    //! Returns true if every neuron can be handled by the array method.
+    static bool Supports(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons);
+
+    //! Copies parameters, connectivity and dynamic state from the neuron objects.
+    //! Must be called before a run, as conductances and state may have been
+    //! modified through the API in between runs. _T_ms is the time of the
+    //! next step, recursive PSP state is rebuilt from the spike history up to
+    //! the step before it.
+    void GatherFromNeurons(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons, float _T_ms = 0.0);
+
+    //! Writes dynamic state back to the neuron objects.
+    void ScatterToNeurons();
+
+    //! Writes only membrane potentials back.
+    void ScatterVm();
+
+    //! Writes only Ca filter states and update times back, e.g. for calcium imaging.
+    void ScatterCa(float t_ms);
+
+    //! Sets the number of threads used by Step(), including the calling thread.
+    //! Fewer are used if the network is too small to be worth splitting.
+    void SetNumThreads(size_t _NumThreads);
+
+    //! Carries out one simulation step at time t_ms.
+    void Step(float t_ms, bool recording);
+
+protected:
+    void UpdatePartitions();
+    void ComputePartition(size_t _Partition, float t_ms);
+    void PublishPartition(size_t _Partition, float t_ms, bool recording);
+
+    void ApplyDirectStim(float t_ms, size_t _Begin, size_t _End);
+    void UpdateOwnPotentials(float t_ms, size_t _Begin, size_t _End);
+    void SortLive(size_t _NeuronIdx);
+    float PSPFromSpikeState(size_t _NeuronIdx, float t_ms, bool _UseCurrent) const;
+    float PSPFromReceptorState(size_t _NeuronIdx) const;
+    void RebuildReceptorState(float t_ms);
+    void UpdatePSP(float t_ms, size_t _Begin, size_t _End);
+    void FindCandidates(float t_ms, size_t _Begin, size_t _End, std::vector<int>& _Candidates) const;
+    void AddSpike(size_t _NeuronIdx, float t_ms);
+    bool SpikeStateChanged(size_t _NeuronIdx) const;
+    void DeliverSpikeEvents(size_t _NeuronIdx, float t_ms);
+    void ResolveSpikes(float t_ms);
+    void UpdateCaAndRecord(float t_ms, bool recording, size_t _Begin, size_t _End);
+
+};
+
+}; // namespace BallAndStick
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
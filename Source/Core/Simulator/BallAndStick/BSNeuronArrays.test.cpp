@@ -0,0 +1,216 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the BSNeuronArrays struct.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/BallAndStick/BSNeuronArrays.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+
+
+/**
+ * @brief Test class for unit tests for the BSNeuronArrays struct.
+ * Builds the same small network twice, so that the neuron arrays method
+ * can be compared with the list-of-neurons method.
+ */
+struct BSNeuronArraysTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> listSimulation{};
+    std::unique_ptr<BG::NES::Simulator::Simulation> arraysSimulation{};
+
+    int NumNeurons = 12;
+
+    void BuildNetwork(BG::NES::Simulator::Simulation & sim) {
+        using namespace BG::NES::Simulator;
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere soma(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+            int ShapeID = sim.AddSphere(soma);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = ShapeID;
+            compartment.MembranePotential_mV = -60.0;
+            compartment.SpikeThreshold_mV = -50.0;
+            compartment.DecayTime_ms = 30.0;
+            compartment.RestingPotential_mV = -60.0;
+            compartment.AfterHyperpolarizationAmplitude_mV = -20.0;
+            int CompartmentID = sim.AddSCCompartment(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { CompartmentID };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            sim.AddSCNeuron(neuron);
+        }
+
+        // Forward and backward connections, so that sources both before and
+        // after their targets in the neuron list are exercised.
+        for (int i = 0; i < NumNeurons; i++) {
+            for (int Offset : { 1, 3, -2 }) {
+                Connections::Receptor receptor;
+                receptor.SourceCompartmentID = i;
+                receptor.DestinationCompartmentID = (i + Offset + NumNeurons) % NumNeurons;
+                receptor.Conductance_nS = 30.0 + 5.0 * (i % 4);
+                receptor.TimeConstantRise_ms = 2.0;
+                receptor.TimeConstantDecay_ms = 15.0;
+                std::strcpy(receptor.Neurotransmitter, "AMPA");
+                sim.AddReceptor(receptor);
+            }
+        }
+
+        for (auto & neuron_ptr : sim.Neurons) {
+            static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get())->SetCaFilter(5.0, 20.0, sim.Dt_ms, 0.1);
+        }
+
+        sim.Neurons.at(0)->AddSpecificAPTime(2.0);
+        sim.Neurons.at(5)->AddSpecificAPTime(40.0);
+        sim.SetRecordAll(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    void SetUp() {
+        listSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        listSimulation->SimulationMethod = BG::NES::Simulator::SIMMETHOD_LIST_OF_NEURONS;
+        BuildNetwork(*listSimulation);
+
+        arraysSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        arraysSimulation->SimulationMethod = BG::NES::Simulator::SIMMETHOD_NEURON_ARRAYS;
+        BuildNetwork(*arraysSimulation);
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(BSNeuronArraysTest, test_Supports_default) {
+    ASSERT_TRUE(BG::NES::Simulator::BallAndStick::BSNeuronArrays::Supports(arraysSimulation->Neurons));
+}
+
+TEST_F(BSNeuronArraysTest, test_GatherFromNeurons_default) {
+    BG::NES::Simulator::BallAndStick::BSNeuronArrays arrays;
+    arrays.GatherFromNeurons(arraysSimulation->Neurons);
+
+    ASSERT_EQ(arrays.Size(), NumNeurons);
+    ASSERT_EQ(arrays.InOffset.back(), 3 * NumNeurons);
+    ASSERT_EQ(arrays.OutOffset.back(), 3 * NumNeurons);
+    ASSERT_EQ(arrays.TNextDirectStim_ms.at(0), 2.0);
+
+    // Receptors expire after -ln(epsilon), about 23, decay time constants.
+    ASSERT_NEAR(arrays.InExpiry_ms.at(0), -log(_PSP_EXPIRY_EPSILON) * 15.0, 1e-3);
+
+    // No neuron has spiked yet, so no receptor is live.
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_TRUE(arrays.LiveIn.at(i).empty());
+    }
+}
+
+TEST_F(BSNeuronArraysTest, test_Step_spike_events_make_receptors_live) {
+    BG::NES::Simulator::BallAndStick::BSNeuronArrays arrays;
+    arrays.GatherFromNeurons(arraysSimulation->Neurons);
+    arrays.Step(2.0, false);
+
+    // The direct stimulation of neuron 0 reaches neurons 1, 3 and 10.
+    for (int Dst : { 1, 3, 10 }) {
+        ASSERT_EQ(arrays.LiveIn.at(Dst).size(), 1);
+        ASSERT_EQ(arrays.InSrcNeuron.at(arrays.LiveIn.at(Dst).at(0)), 0);
+    }
+    ASSERT_TRUE(arrays.LiveIn.at(2).empty());
+}
+
+TEST_F(BSNeuronArraysTest, test_RunFor_same_as_list_of_neurons) {
+    // Split into several runs to exercise gathering and scattering.
+    for (int run = 0; run < 3; run++) {
+        listSimulation->RunFor(50.0);
+        arraysSimulation->RunFor(50.0);
+    }
+
+    ASSERT_GT(listSimulation->TotalSpikes(), 0);
+    ASSERT_EQ(listSimulation->TotalSpikes(), arraysSimulation->TotalSpikes());
+
+    for (int i = 0; i < NumNeurons; i++) {
+        auto listNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(listSimulation->Neurons.at(i).get());
+        auto arraysNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(arraysSimulation->Neurons.at(i).get());
+
+        ASSERT_EQ(listNeuron->TAct_ms, arraysNeuron->TAct_ms);
+        ASSERT_EQ(listNeuron->VmRecorded_mV, arraysNeuron->VmRecorded_mV);
+        ASSERT_EQ(listNeuron->Vm_mV, arraysNeuron->Vm_mV);
+        ASSERT_EQ(listNeuron->in_absref, arraysNeuron->in_absref);
+        ASSERT_EQ(listNeuron->CaStateRise, arraysNeuron->CaStateRise);
+        ASSERT_EQ(listNeuron->CaStateDecay, arraysNeuron->CaStateDecay);
+    }
+}
+
+TEST_F(BSNeuronArraysTest, test_RunFor_parallel_same_as_serial) {
+    // Large enough to be split into several partitions.
+    NumNeurons = 4 * _MIN_NEURONS_PER_PARTITION;
+
+    auto serialSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+    serialSimulation->NumThreads = 1;
+    BuildNetwork(*serialSimulation);
+
+    auto parallelSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+    parallelSimulation->NumThreads = 4;
+    BuildNetwork(*parallelSimulation);
+
+    for (int run = 0; run < 2; run++) {
+        serialSimulation->RunFor(50.0);
+        parallelSimulation->RunFor(50.0);
+    }
+
+    ASSERT_EQ(parallelSimulation->NeuronArrays.PartitionBegin.size(), 5);
+    ASSERT_GT(serialSimulation->TotalSpikes(), 0);
+    ASSERT_EQ(serialSimulation->TotalSpikes(), parallelSimulation->TotalSpikes());
+
+    for (int i = 0; i < NumNeurons; i++) {
+        auto serialNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(serialSimulation->Neurons.at(i).get());
+        auto parallelNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(parallelSimulation->Neurons.at(i).get());
+
+        ASSERT_EQ(serialNeuron->TAct_ms, parallelNeuron->TAct_ms);
+        ASSERT_EQ(serialNeuron->VmRecorded_mV, parallelNeuron->VmRecorded_mV);
+        ASSERT_EQ(serialNeuron->CaStateRise, parallelNeuron->CaStateRise);
+        ASSERT_EQ(serialNeuron->CaStateDecay, parallelNeuron->CaStateDecay);
+    }
+}
+
+TEST_F(BSNeuronArraysTest, test_RunFor_recursive_PSP_matches_single_spike) {
+    arraysSimulation->PSPIntegration = BG::NES::Simulator::BallAndStick::PSPINTEGRATION_RECURSIVE;
+    listSimulation->RunFor(30.0);
+    arraysSimulation->RunFor(30.0);
+
+    // Until a second spike overlaps the first PSPs, summing all spikes is the
+    // same as taking the latest one.
+    float TSecondSpike_ms = 30.0;
+    for (int i = 0; i < NumNeurons; i++) {
+        for (float t_ms : listSimulation->Neurons.at(i)->TAct_ms) {
+            if (t_ms > 2.0) TSecondSpike_ms = std::min(TSecondSpike_ms, t_ms);
+        }
+    }
+    ASSERT_GT(TSecondSpike_ms, 3.0);
+
+    for (int i = 0; i < NumNeurons; i++) {
+        auto listNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(listSimulation->Neurons.at(i).get());
+        auto arraysNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(arraysSimulation->Neurons.at(i).get());
+        for (size_t s = 0; (s < listNeuron->TRecorded_ms.size()) && (listNeuron->TRecorded_ms.at(s) < TSecondSpike_ms); s++) {
+            ASSERT_NEAR(listNeuron->VmRecorded_mV.at(s), arraysNeuron->VmRecorded_mV.at(s), 1e-3);
+        }
+    }
+}
@@ -44,6 +44,14 @@ class Distribution {
     //! Generates a random sample from the distribution of size numSamples.
     virtual std::vector<float> RandomSample(size_t numSamples) = 0;
 
+    //! Generates a single random sample from the distribution, without allocating.
+    virtual float RandomSample() = 0;
+
+    //! Generates sample number _Counter of the counter-based stream _Key.
+    //! This is a pure function of its arguments, so it needs no shared
+    //! generator state and is safe to call from several threads.
+    virtual float CounterSample(uint64_t _Key, uint64_t _Counter) const = 0;
+
     //! Probability distribution function
     virtual std::vector<float> PDF(std::vector<float> x) = 0;
     virtual float PDF(float x) = 0;
@@ -1,5 +1,7 @@
 #include <Simulator/Distributions/Generic.h>
 
+#include <sstream>
+
 
 
 namespace BG {
@@ -26,6 +28,28 @@ float Generic::NormalRandomFloat() {
     return NormalDistFloat_(Gen_);
 }
 
+std::string Generic::GetState() const {
+    std::stringstream State;
+    State << Gen_ << ' ' << UniformDistInt_ << ' ' << UniformDistFloat_ << ' ' << NormalDistFloat_;
+    return State.str();
+}
+
+bool Generic::SetState(const std::string & _State) {
+    std::stringstream State(_State);
+    std::mt19937 Gen;
+    std::uniform_int_distribution<int> UniformDistInt;
+    std::uniform_real_distribution<float> UniformDistFloat;
+    std::normal_distribution<float> NormalDistFloat;
+    State >> Gen >> UniformDistInt >> UniformDistFloat >> NormalDistFloat;
+    if (State.fail()) return false;
+
+    Gen_ = Gen;
+    UniformDistInt_ = UniformDistInt;
+    UniformDistFloat_ = UniformDistFloat;
+    NormalDistFloat_ = NormalDistFloat;
+    return true;
+}
+
 }; // namespace Distributions
 }; // namespace Simulator
 }; // namespace NES
@@ -16,6 +16,7 @@
 #include <cmath>
 
 #include <random>
+#include <string>
 
 namespace BG {
 namespace NES {
@@ -64,6 +65,21 @@ class Generic {
      */
     float NormalRandomFloat();
 
+    /**
+     * @brief Serializes the generator and distribution states, so that a
+     * restored generator continues the same sequence.
+     * 
+     * @return Text representation of the state.
+     */
+    std::string GetState() const;
+
+    /**
+     * @brief Restores a state returned by GetState().
+     * 
+     * @return true on success, false if the state could not be parsed.
+     */
+    bool SetState(const std::string & _State);
+
 };
 
 }; // namespace Distributions
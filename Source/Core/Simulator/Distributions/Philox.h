@@ -0,0 +1,78 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the Philox4x32-10 counter-based random number generator.
+    Additional Notes: Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11).
+                      A block of random bits is a pure function of a key and a counter, so
+                      streams need no shared state and any element can be generated directly.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Distributions {
+
+/**
+ * @brief Philox4x32 with 10 rounds, maps a 128 bit counter and a 64 bit key
+ * to 128 random bits.
+ *
+ */
+struct Philox4x32 {
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static Counter Block(Counter _Counter, Key _Key) {
+        for (int Round = 0; Round < 10; Round++) {
+            uint64_t Product0 = uint64_t(0xD2511F53) * _Counter[0];
+            uint64_t Product1 = uint64_t(0xCD9E8D57) * _Counter[2];
+            _Counter = {
+                uint32_t(Product1 >> 32) ^ _Counter[1] ^ _Key[0],
+                uint32_t(Product1),
+                uint32_t(Product0 >> 32) ^ _Counter[3] ^ _Key[1],
+                uint32_t(Product0)
+            };
+            _Key[0] += 0x9E3779B9;
+            _Key[1] += 0xBB67AE85;
+        }
+        return _Counter;
+    }
+};
+
+//! Converts 32 random bits to a float uniformly distributed in (0, 1].
+inline float UniformFromBits(uint32_t _Bits) {
+    return (float(_Bits >> 8) + 1.0f) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Four standard normal samples for element _Index of the stream
+ * _Stream of _Key, by the Box-Muller transform of one Philox block.
+ *
+ */
+inline std::array<float, 4> StandardNormalBlock(uint64_t _Key, uint64_t _Stream, uint32_t _Index) {
+    Philox4x32::Counter Bits = Philox4x32::Block(
+        { uint32_t(_Stream), uint32_t(_Stream >> 32), _Index, 0 },
+        { uint32_t(_Key), uint32_t(_Key >> 32) });
+
+    std::array<float, 4> Normals;
+    for (int p = 0; p < 2; p++) {
+        float Radius = std::sqrt(-2.0f * std::log(UniformFromBits(Bits[2 * p])));
+        float Angle = float(2.0 * M_PI) * UniformFromBits(Bits[2 * p + 1]);
+        Normals[2 * p] = Radius * std::cos(Angle);
+        Normals[2 * p + 1] = Radius * std::sin(Angle);
+    }
+    return Normals;
+}
+
+}; // namespace Distributions
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -1,4 +1,5 @@
 #include <Simulator/Distributions/TruncNorm.h>
+#include <Simulator/Distributions/Philox.h>
 
 #include <iostream>
 
@@ -61,20 +62,34 @@ TruncNorm::TruncNorm(float _a, float _b, float _loc, float _scale) {
 
 //! Generates a random sample from the distribution of size numSamples.
 std::vector<float> TruncNorm::RandomSample(size_t numSamples) {
-    // Standard normal distribution
-    static std::normal_distribution<float> _stdNormalDist; // Note this is static! Created only once, initialized only on first call.
-    std::vector<float> randomSample;
-
-    while (randomSample.size() < numSamples) {
-        float val = this->loc + _stdNormalDist(this->_Gen) * this->scale;
-        if (val < this->a || val > this->b)
-            continue;
-        randomSample.emplace_back(val);
+    std::vector<float> randomSample(numSamples);
+    for (float & val : randomSample) {
+        val = this->RandomSample();
     }
-
     return randomSample;
 };
 
+//! Generates a single random sample from the distribution by rejection.
+float TruncNorm::RandomSample() {
+    while (true) {
+        float val = this->loc + this->_StdNormalDist(this->_Gen) * this->scale;
+        if (val >= this->a && val <= this->b)
+            return val;
+    }
+};
+
+//! Generates sample number _Counter of the counter-based stream _Key by
+//! rejection, drawing four normal candidates per Philox block.
+float TruncNorm::CounterSample(uint64_t _Key, uint64_t _Counter) const {
+    for (uint32_t block = 0; ; block++) {
+        for (float z : StandardNormalBlock(_Key, _Counter, block)) {
+            float val = this->loc + z * this->scale;
+            if (val >= this->a && val <= this->b)
+                return val;
+        }
+    }
+};
+
 //! Probability distribution function
 std::vector<float> TruncNorm::PDF(std::vector<float> x) {
     std::vector<float> pdf;
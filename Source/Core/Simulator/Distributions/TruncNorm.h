@@ -26,6 +26,9 @@ namespace Distributions {
  *
  */
 class TruncNorm : public Distribution {
+  private:
+    std::normal_distribution<float> _StdNormalDist; //! Standard normal distribution.
+
   public:
     float a; //! Lower bound of the distribution.
     float b; //! Upper bound of the distribution.
@@ -37,6 +40,12 @@ class TruncNorm : public Distribution {
     //! Generates a random sample from the distribution of size numSamples.
     std::vector<float> RandomSample(size_t numSamples);
 
+    //! Generates a single random sample from the distribution.
+    float RandomSample();
+
+    //! Generates sample number _Counter of the counter-based stream _Key.
+    float CounterSample(uint64_t _Key, uint64_t _Counter) const;
+
     //! Probability distribution function
     std::vector<float> PDF(std::vector<float> x);
     float PDF(float x);
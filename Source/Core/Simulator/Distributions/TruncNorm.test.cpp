@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <Simulator/Distributions/TruncNorm.h>
+#include <Simulator/Distributions/Philox.h>
 
 
 /**
@@ -46,6 +47,44 @@ TEST_F( TruncNormTest, test_RandomSample_default ) {
         ASSERT_TRUE((0.1f <= val) && (val <= 2.0f));
 }
 
+TEST_F( TruncNormTest, test_RandomSample_scalar ) {
+    for (int i = 0; i < 100; i++) {
+        float val = testTruncNorm->RandomSample();
+        ASSERT_TRUE((0.1f <= val) && (val <= 2.0f));
+    }
+}
+
+TEST_F( TruncNormTest, test_Philox4x32_known_answers ) {
+    // Known answer tests of the Random123 reference implementation.
+    using Philox = BG::NES::Simulator::Distributions::Philox4x32;
+    ASSERT_EQ(Philox::Block({ 0, 0, 0, 0 }, { 0, 0 }),
+              Philox::Counter({ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+    ASSERT_EQ(Philox::Block({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }),
+              Philox::Counter({ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+    ASSERT_EQ(Philox::Block({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }),
+              Philox::Counter({ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+}
+
+TEST_F( TruncNormTest, test_CounterSample_default ) {
+    // Samples depend only on key and counter, not on previous calls or the seed.
+    float first = testTruncNorm->CounterSample(7, 0);
+    testTruncNorm->RandomSample(10);
+    testTruncNorm->SetSeed(seed + 1);
+    ASSERT_EQ(testTruncNorm->CounterSample(7, 0), first);
+    ASSERT_NE(testTruncNorm->CounterSample(7, 1), first);
+    ASSERT_NE(testTruncNorm->CounterSample(8, 0), first);
+
+    // Samples are in bounds and follow the distribution.
+    const int numSamples = 20000;
+    double sum = 0.0;
+    for (uint64_t counter = 0; counter < numSamples; counter++) {
+        float val = testTruncNorm->CounterSample(7, counter);
+        ASSERT_TRUE((0.1f <= val) && (val <= 2.0f));
+        sum += val;
+    }
+    ASSERT_NEAR(sum / numSamples, testTruncNorm->Mean(), 0.02);
+}
+
 TEST_F( TruncNormTest, test_PDF_default ) {
     std::vector<float> x = {0.1f, 1.0f, 2.0f};
     std::vector<float> pdf = testTruncNorm->PDF(x);
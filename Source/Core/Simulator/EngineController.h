@@ -36,9 +36,13 @@ namespace BG {
 namespace NES {
 namespace Simulator {
 
+//! Longest time the engine thread waits for work before it checks whether
+//! it should stop, StopThreads is set without notifying the simulations.
+#define _ENGINE_STOP_CHECK_INTERVAL_MS 100
 
 /**
  * @brief This function is what is the target of the new worker thread, and handles setting up a new engine for this simulation, as well as monitoring it and invoking the util functions as needed.
+ * It sleeps on the work condition of the simulation until Simulation::RequestWork() is called, so a task starts as soon as it is requested.
  * 
  */
 void SimulationEngineThread(BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Sim, VSDA::RenderPool* _RenderPool, VisualizerPool* _VisualizerPool, std::atomic<bool>* _StopThreads);
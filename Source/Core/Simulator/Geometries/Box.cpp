@@ -207,6 +207,10 @@ void Box::WriteToVoxelArray(VSDA::Calcium::VoxelArray* _Array, VSDA::Calcium::Vo
 // }
 
 bool BoxBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
+    return GetCullingBox(_WorldInfo).IsIntersecting(_Region);
+}
+
+BoundingBox BoxBase::GetCullingBox(VSDA::WorldInfo& _WorldInfo) {
     
     // We're going to make this a really conservative bounding box
     // This bounding box probably extends past what is reasonable
@@ -220,7 +224,7 @@ bool BoxBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
     MyBB.bb_point2[0] = RotatedCenter.x + Dims_um.x;
     MyBB.bb_point2[1] = RotatedCenter.y + Dims_um.y;
     MyBB.bb_point2[2] = RotatedCenter.z + Dims_um.z;
-    return MyBB.IsIntersecting(_Region);
+    return MyBB;
 }
 
 
@@ -43,6 +43,7 @@ struct BoxBase: Geometry {
     virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo);
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo); // not used - bad don't use this it does not do rotation or work at all!!!
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo);
+    virtual BoundingBox GetCullingBox(VSDA::WorldInfo& _WorldInfo);
 };
 
 /**
@@ -323,10 +323,14 @@ void Cylinder::WriteToVoxelArray(VSDA::Calcium::VoxelArray* _Array, VSDA::Calciu
 
 
 bool CylinderBase::IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo) {
-    return false;
+    return CylinderFrame(*this, _WorldInfo).IsPointInside(_Position_um.x, _Position_um.y, _Position_um.z);
 }
 
 bool CylinderBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
+    return GetCullingBox(_WorldInfo).IsIntersecting(_Region);
+}
+
+BoundingBox CylinderBase::GetCullingBox(VSDA::WorldInfo& _WorldInfo) {
     // We're going to make this a really conservative bounding box
     // This bounding box probably extends past what is reasonable
     BoundingBox MyBB;
@@ -340,9 +344,157 @@ bool CylinderBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldIn
     MyBB.bb_point2[0] = End1Rot.x + End1Radius_um;
     MyBB.bb_point2[1] = End1Rot.y + End1Radius_um;
     MyBB.bb_point2[2] = End1Rot.z + End1Radius_um;
-    return MyBB.IsIntersecting(_Region);
+    return MyBB;
+}
+
+
+CylinderFrame::CylinderFrame(const CylinderBase& _Cylinder, VSDA::WorldInfo& _WorldInfo) {
+    Vec3D End0 = _Cylinder.End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+    Vec3D End1 = _Cylinder.End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+
+    End0_um[0] = End0.x;
+    End0_um[1] = End0.y;
+    End0_um[2] = End0.z;
+    double Difference[3] = {double(End1.x) - End0.x, double(End1.y) - End0.y, double(End1.z) - End0.z};
+    Length_um = sqrt(Difference[0] * Difference[0] + Difference[1] * Difference[1] + Difference[2] * Difference[2]);
+    End0Radius_um = _Cylinder.End0Radius_um;
+    MaxRadius_um = std::max(_Cylinder.End0Radius_um, _Cylinder.End1Radius_um);
+    if (Length_um > 0.) {
+        for (int i = 0; i < 3; i++) {
+            Axis[i] = Difference[i] / Length_um;
+        }
+        Slope = (double(_Cylinder.End1Radius_um) - _Cylinder.End0Radius_um) / Length_um;
+    }
+}
+
+bool CylinderFrame::IsPointInside(double _X_um, double _Y_um, double _Z_um, double _Inset_um) const {
+    if (Length_um <= 0.) {
+        return false;
+    }
+    double T_um, AxisDistance2_um2;
+    Project(_X_um, _Y_um, _Z_um, &T_um, &AxisDistance2_um2);
+    if (T_um < 0. || T_um > Length_um) {
+        return false;
+    }
+    double Radius_um = RadiusAt_um(T_um) - _Inset_um;
+    return Radius_um >= 0. && AxisDistance2_um2 <= Radius_um * Radius_um;
 }
 
+bool CylinderFrame::SolveRowSpan(double _Y_um, double _Z_um, double _Inset_um, double* _StartX_um, double* _EndX_um) const {
+    if (Length_um <= 0.) {
+        return false;
+    }
+
+    // Points on the row are (X, _Y_um, _Z_um). With D the offset from end 0 at X = 0, a point's position on the
+    // axis is T = D.Axis + X * Axis[0], and it is inside the (infinite) cone if |D + X|^2 - T^2 - R(T)^2 <= 0.
+    // That is a quadratic A*X^2 + B*X + C <= 0, which is then clipped to the part of the row with 0 <= T <= Length_um.
+    double D[3] = {-End0_um[0], _Y_um - End0_um[1], _Z_um - End0_um[2]};
+    double TD = D[0] * Axis[0] + D[1] * Axis[1] + D[2] * Axis[2];
+    double RD = End0Radius_um - _Inset_um + Slope * TD;
+    double AX = Axis[0];
+    double A = 1. - (1. + Slope * Slope) * AX * AX;
+    double B = 2. * (D[0] - TD * AX - Slope * AX * RD);
+    double C = D[0] * D[0] + D[1] * D[1] + D[2] * D[2] - TD * TD - RD * RD;
+
+    // Part of the row between the ends
+    double SlabStart = -INFINITY;
+    double SlabEnd = INFINITY;
+    if (std::abs(AX) > 1e-12) {
+        SlabStart = -TD / AX;
+        SlabEnd = (Length_um - TD) / AX;
+        if (SlabStart > SlabEnd) {
+            std::swap(SlabStart, SlabEnd);
+        }
+    } else if (TD < 0. || TD > Length_um) {
+        return false;
+    }
+
+    // The frustum is convex, so its intersection with the row is a single interval. When A < 0 the quadratic's
+    // solutions are the outside of its roots, but the part past one of them belongs to the mirrored cone beyond the
+    // apex, which is clipped away by the slab.
+    double Start = SlabStart;
+    double End = SlabEnd;
+    if (std::abs(A) < 1e-12) {
+        if (std::abs(B) < 1e-12) {
+            if (C > 0.) {
+                return false;
+            }
+        } else if (B > 0.) {
+            End = std::min(End, -C / B);
+        } else {
+            Start = std::max(Start, -C / B);
+        }
+    } else {
+        double Discriminant = B * B - 4. * A * C;
+        if (Discriminant < 0.) {
+            if (A > 0.) {
+                return false;
+            }
+        } else {
+            double Root = sqrt(Discriminant);
+            double X0 = (-B - Root) / (2. * A);
+            double X1 = (-B + Root) / (2. * A);
+            if (X0 > X1) {
+                std::swap(X0, X1);
+            }
+            if (A > 0.) {
+                Start = std::max(Start, X0);
+                End = std::min(End, X1);
+            } else {
+                bool LowerPart = SlabStart <= X0;
+                bool UpperPart = SlabEnd >= X1;
+                if (!LowerPart && !UpperPart) {
+                    return false;
+                }
+                Start = LowerPart ? SlabStart : std::max(SlabStart, X1);
+                End = UpperPart ? SlabEnd : std::min(SlabEnd, X0);
+            }
+        }
+    }
+
+    if (Start > End || std::isinf(Start) || std::isinf(End)) {
+        return false;
+    }
+    *_StartX_um = Start;
+    *_EndX_um = End;
+    return true;
+}
+
+bool CylinderFrame::GetLayerYRange(double _Z_um, double* _StartY_um, double* _EndY_um) const {
+    if (Length_um <= 0.) {
+        return false;
+    }
+
+    // The part of the axis whose discs can reach this layer
+    double ExtentZ_um = DiscExtent_um(2);
+    double StartT_um = 0.;
+    double EndT_um = Length_um;
+    if (std::abs(Axis[2]) > 1e-12) {
+        double T0 = (_Z_um - ExtentZ_um - End0_um[2]) / Axis[2];
+        double T1 = (_Z_um + ExtentZ_um - End0_um[2]) / Axis[2];
+        StartT_um = std::max(StartT_um, std::min(T0, T1));
+        EndT_um = std::min(EndT_um, std::max(T0, T1));
+        if (StartT_um > EndT_um) {
+            return false;
+        }
+    } else if (std::abs(_Z_um - End0_um[2]) > ExtentZ_um) {
+        return false;
+    }
+
+    double Y0 = End0_um[1] + StartT_um * Axis[1];
+    double Y1 = End0_um[1] + EndT_um * Axis[1];
+    double ExtentY_um = DiscExtent_um(1);
+    *_StartY_um = std::min(Y0, Y1) - ExtentY_um;
+    *_EndY_um = std::max(Y0, Y1) + ExtentY_um;
+    return true;
+}
+
+void CylinderFrame::GetZRange(double* _StartZ_um, double* _EndZ_um) const {
+    double Z1 = End0_um[2] + Length_um * Axis[2];
+    double ExtentZ_um = DiscExtent_um(2);
+    *_StartZ_um = std::min(End0_um[2], Z1) - ExtentZ_um;
+    *_EndZ_um = std::max(End0_um[2], Z1) + ExtentZ_um;
+}
 
 
 }; // namespace Geometries
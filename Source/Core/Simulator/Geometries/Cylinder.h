@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <tuple>
@@ -49,6 +50,76 @@ struct CylinderBase: Geometry {
     virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo);
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo);
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo);
+    virtual BoundingBox GetCullingBox(VSDA::WorldInfo& _WorldInfo);
+};
+
+/**
+ * @brief The local frame of a (world rotated) cylinder or truncated cone, computed once per shape
+ * so that rasterizers don't have to redo the axis, its length and its normalization for every voxel.
+ * A point is inside if its projection on the axis is between the ends, and its distance
+ * from the axis is at most the radius there, which goes linearly from End0Radius_um to the end 1 radius.
+ *
+ */
+struct CylinderFrame {
+    double End0_um[3] = {0., 0., 0.}; //! Rotated position of end 0
+    double Axis[3] = {0., 0., 0.};    //! Unit vector from end 0 to end 1
+    double Length_um = 0.;            //! Distance between the ends, the frame is empty if this is 0
+    double End0Radius_um = 0.;
+    double Slope = 0.;                //! Change of the radius per micrometer along the axis
+    double MaxRadius_um = 0.;
+
+    CylinderFrame(const CylinderBase& _Cylinder, VSDA::WorldInfo& _WorldInfo);
+
+    //! Returns the position along the axis, and the squared distance from the axis, of the given point.
+    inline void Project(double _X_um, double _Y_um, double _Z_um, double* _T_um, double* _AxisDistance2_um2) const {
+        double DX = _X_um - End0_um[0];
+        double DY = _Y_um - End0_um[1];
+        double DZ = _Z_um - End0_um[2];
+        double T = DX * Axis[0] + DY * Axis[1] + DZ * Axis[2];
+        *_T_um = T;
+        *_AxisDistance2_um2 = std::max(0., DX * DX + DY * DY + DZ * DZ - T * T);
+    }
+
+    //! Radius of the shape at the given position along the axis.
+    inline double RadiusAt_um(double _T_um) const {
+        return End0Radius_um + Slope * _T_um;
+    }
+
+    //! Returns true if the point is inside the shape shrunk (radially) by _Inset_um.
+    bool IsPointInside(double _X_um, double _Y_um, double _Z_um, double _Inset_um = 0.) const;
+
+    /**
+     * @brief Solves for the X interval of the row at (_Y_um, _Z_um) that is inside the shape shrunk
+     * (radially) by _Inset_um. The shrunk shape must still have a radius >= 0 at both ends.
+     *
+     * @param _Y_um
+     * @param _Z_um
+     * @param _Inset_um
+     * @param _StartX_um
+     * @param _EndX_um
+     * @return true if the row crosses the shape, and the interval is set.
+     * @return false if it doesn't.
+     */
+    bool SolveRowSpan(double _Y_um, double _Z_um, double _Inset_um, double* _StartX_um, double* _EndX_um) const;
+
+    /**
+     * @brief Returns the Y interval of the rows at _Z_um that might cross the shape.
+     *
+     * @param _Z_um
+     * @param _StartY_um
+     * @param _EndY_um
+     * @return true if the layer at _Z_um might cross the shape
+     * @return false if it doesn't.
+     */
+    bool GetLayerYRange(double _Z_um, double* _StartY_um, double* _EndY_um) const;
+
+    //! Returns the Z interval that the shape extends over.
+    void GetZRange(double* _StartZ_um, double* _EndZ_um) const;
+
+    //! Half the extent of the end discs along the given world axis (0, 1, 2 = X, Y, Z).
+    inline double DiscExtent_um(int _WorldAxis) const {
+        return MaxRadius_um * sqrt(std::max(0., 1. - Axis[_WorldAxis] * Axis[_WorldAxis]));
+    }
 };
 
 /**
@@ -81,3 +81,20 @@ TEST_F(CylinderTest, test_GetRotation_rad_default) {
 
     ASSERT_EQ(expectedRot_rad, gotRot_rad);
 }
+
+TEST_F(CylinderTest, test_IsPointInShape_default) {
+    BG::NES::VSDA::WorldInfo info;
+    info.WorldRotationOffsetX_rad = 0.0f;
+    info.WorldRotationOffsetY_rad = 0.0f;
+    info.WorldRotationOffsetZ_rad = 0.0f;
+
+    // The axis goes along Y from y=0.2 (radius 0.5) to y=10.2 (radius 1.2)
+    ASSERT_TRUE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.1, 0.3, 0.3), info));
+    ASSERT_TRUE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.5, 0.3, 0.3), info));
+    ASSERT_FALSE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.7, 0.3, 0.3), info));
+    ASSERT_TRUE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(1.2, 10.1, 0.3), info));
+    ASSERT_TRUE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.1, 5.2, 1.1), info));
+    ASSERT_FALSE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.1, 5.2, 1.3), info));
+    ASSERT_FALSE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.1, 0.1, 0.3), info));
+    ASSERT_FALSE(testCylinder->IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(0.1, 10.3, 0.3), info));
+}
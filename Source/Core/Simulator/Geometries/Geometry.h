@@ -65,6 +65,10 @@ struct Geometry {
      */
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) = 0;
 
+    //! Gets the box that IsInsideRegion tests against the region, so that
+    //! shapes can be culled through a BoundingVolumeHierarchy instead.
+    virtual BoundingBox GetCullingBox(VSDA::WorldInfo& _WorldInfo) = 0;
+
     /**
      * @brief Checks if the given world space position is in this shape.
      * 
@@ -58,7 +58,11 @@ bool SphereBase::IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo)
 
 
 bool SphereBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
-    return GetBoundingBox(_WorldInfo).IsIntersecting(_Region);
+    return GetCullingBox(_WorldInfo).IsIntersecting(_Region);
+}
+
+BoundingBox SphereBase::GetCullingBox(VSDA::WorldInfo& _WorldInfo) {
+    return GetBoundingBox(_WorldInfo);
 }
 
 
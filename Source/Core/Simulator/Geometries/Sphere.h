@@ -40,6 +40,7 @@ struct SphereBase: Geometry {
     virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo);
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo);
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo);
+    virtual BoundingBox GetCullingBox(VSDA::WorldInfo& _WorldInfo);
 
     std::string str() const {
         std::stringstream ss;
@@ -65,6 +65,7 @@ struct Wedge : Geometry {
     virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo) { return BoundingBox(); } // ** FIX THIS!
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo) { return true; } // ***FIX THIS!
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) { return true; } // ***FIX THIS!
+    virtual BoundingBox GetCullingBox(VSDA::WorldInfo& _WorldInfo) { return BoundingBox{ { -INFINITY, -INFINITY, -INFINITY }, { INFINITY, INFINITY, INFINITY } }; } // Inside every region, as above.
 
     //! Returns a point cloud that can be used to fill voxels representing the cylinder.
     // std::vector<Vec3D> GetPointCloud(float _VoxelScale);
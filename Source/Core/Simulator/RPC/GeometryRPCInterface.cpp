@@ -24,9 +24,12 @@ GeometryRPCInterface::GeometryRPCInterface(BG::Common::Logger::LoggingSystem* _L
     Simulations_ = _Simulations;
 
     // Register Callbacks
-    _RPCManager->AddRoute("Simulation/Geometry/Sphere/Create",   std::bind(&GeometryRPCInterface::SphereCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Geometry/Cylinder/Create", std::bind(&GeometryRPCInterface::CylinderCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Geometry/Box/Create",      std::bind(&GeometryRPCInterface::BoxCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Sphere/Create",   std::bind(&GeometryRPCInterface::SphereCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Cylinder/Create", std::bind(&GeometryRPCInterface::CylinderCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Box/Create",      std::bind(&GeometryRPCInterface::BoxCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Sphere/BulkCreate",   std::bind(&GeometryRPCInterface::SphereBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Cylinder/BulkCreate", std::bind(&GeometryRPCInterface::CylinderBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Box/BulkCreate",      std::bind(&GeometryRPCInterface::BoxBulkCreate, this, std::placeholders::_1));
 
 }
 
@@ -34,7 +37,7 @@ GeometryRPCInterface::~GeometryRPCInterface() {
 
 }
 
-std::string GeometryRPCInterface::SphereCreate(std::string _JSONRequest) {
+nlohmann::json GeometryRPCInterface::SphereCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Sphere/Create", Simulations_);
     if (Handle.HasError()) {
@@ -55,7 +58,7 @@ std::string GeometryRPCInterface::SphereCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("ShapeID", S.ID);
 }
 
-std::string GeometryRPCInterface::CylinderCreate(std::string _JSONRequest) {
+nlohmann::json GeometryRPCInterface::CylinderCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Cylinder/Create", Simulations_);
     if (Handle.HasError()) {
@@ -78,7 +81,7 @@ std::string GeometryRPCInterface::CylinderCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("ShapeID", S.ID);
 }
 
-std::string GeometryRPCInterface::BoxCreate(std::string _JSONRequest) {
+nlohmann::json GeometryRPCInterface::BoxCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Box/Create", Simulations_);
     if (Handle.HasError()) {
@@ -100,6 +103,89 @@ std::string GeometryRPCInterface::BoxCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("ShapeID", S.ID);
 }
 
+nlohmann::json GeometryRPCInterface::SphereBulkCreate(const nlohmann::json& _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Sphere/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Record: Radius_um, CenterPos (float32 each)
+    int Count = 0;
+    std::string Bytes;
+    if (!Handle.GetParPackedRecords("Data", 4*sizeof(float), Count, Bytes)) {
+        return Handle.ErrResponse();
+    }
+
+    API::PackedRecordReader Reader(Bytes);
+    std::vector<Geometries::Sphere> Spheres(Count);
+    for (Geometries::Sphere& S : Spheres) {
+        S.Radius_um = Reader.Float32();
+        S.Center_um = Reader.Vec3();
+    }
+    Handle.SetBulkNames(Spheres);
+
+    int FirstID = Handle.Sim()->AddSpheres(Spheres);
+
+    return Handle.BulkResponse(FirstID, Count);
+}
+
+nlohmann::json GeometryRPCInterface::CylinderBulkCreate(const nlohmann::json& _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Cylinder/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Record: Point1Radius_um, Point1Pos, Point2Radius_um, Point2Pos (float32 each)
+    int Count = 0;
+    std::string Bytes;
+    if (!Handle.GetParPackedRecords("Data", 8*sizeof(float), Count, Bytes)) {
+        return Handle.ErrResponse();
+    }
+
+    API::PackedRecordReader Reader(Bytes);
+    std::vector<Geometries::Cylinder> Cylinders(Count);
+    for (Geometries::Cylinder& S : Cylinders) {
+        S.End0Radius_um = Reader.Float32();
+        S.End0Pos_um = Reader.Vec3();
+        S.End1Radius_um = Reader.Float32();
+        S.End1Pos_um = Reader.Vec3();
+    }
+    Handle.SetBulkNames(Cylinders);
+
+    int FirstID = Handle.Sim()->AddCylinders(Cylinders);
+
+    return Handle.BulkResponse(FirstID, Count);
+}
+
+nlohmann::json GeometryRPCInterface::BoxBulkCreate(const nlohmann::json& _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Box/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Record: CenterPos, Scale, Rotation in rad (float32 each)
+    int Count = 0;
+    std::string Bytes;
+    if (!Handle.GetParPackedRecords("Data", 9*sizeof(float), Count, Bytes)) {
+        return Handle.ErrResponse();
+    }
+
+    API::PackedRecordReader Reader(Bytes);
+    std::vector<Geometries::Box> Boxes(Count);
+    for (Geometries::Box& S : Boxes) {
+        S.Center_um = Reader.Vec3();
+        S.Dims_um = Reader.Vec3();
+        S.Rotations_rad = Reader.Vec3();
+    }
+    Handle.SetBulkNames(Boxes);
+
+    int FirstID = Handle.Sim()->AddBoxes(Boxes);
+
+    return Handle.BulkResponse(FirstID, Count);
+}
 
 }; // Close Namespace Simulator
 }; // Close Namespace NES
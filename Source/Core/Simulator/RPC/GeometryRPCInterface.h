@@ -80,9 +80,18 @@ public:
      * @param _JSONRequest 
      * @return std::string 
      */
-    std::string SphereCreate(std::string _JSONRequest);
-    std::string CylinderCreate(std::string _JSONRequest);
-    std::string BoxCreate(std::string _JSONRequest);
+    nlohmann::json SphereCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json CylinderCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json BoxCreate(const nlohmann::json& _JSONRequest);
+
+    /**
+     * @brief Bulk variants of the routes above, each takes "Count" shapes as
+     * base64 encoded packed little-endian records in "Data" and returns the
+     * first of their consecutive IDs. See Docs/API.md for the record layouts.
+     */
+    nlohmann::json SphereBulkCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json CylinderBulkCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json BoxBulkCreate(const nlohmann::json& _JSONRequest);
 
 };
 
@@ -27,23 +27,25 @@ ModelRPCInterface::ModelRPCInterface(BG::Common::Logger::LoggingSystem* _Logger,
     Simulations_ = _Simulations;
 
     // Register Callbacks
-    _RPCManager->AddRoute("Simulation/Staple/Create",                 std::bind(&ModelRPCInterface::StapleCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Receptor/Create",               std::bind(&ModelRPCInterface::ReceptorCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Staple/Create",                 std::bind(&ModelRPCInterface::StapleCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Receptor/Create",               std::bind(&ModelRPCInterface::ReceptorCreate, this, std::placeholders::_1));
 
-    _RPCManager->AddRoute("Simulation/Neuron/BS/Create",              std::bind(&ModelRPCInterface::BSNeuronCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Compartments/BS/Create",        std::bind(&ModelRPCInterface::BSCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/BS/Create",              std::bind(&ModelRPCInterface::BSNeuronCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/BS/Create",        std::bind(&ModelRPCInterface::BSCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Receptor/BulkCreate",           std::bind(&ModelRPCInterface::ReceptorBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/BS/BulkCreate",    std::bind(&ModelRPCInterface::BSBulkCreate, this, std::placeholders::_1));
    
-    _RPCManager->AddRoute("Simulation/Neuron/SC/Create",              std::bind(&ModelRPCInterface::SCNeuronCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Compartments/SC/Create",        std::bind(&ModelRPCInterface::SCCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/SC/Create",              std::bind(&ModelRPCInterface::SCNeuronCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/SC/Create",        std::bind(&ModelRPCInterface::SCCreate, this, std::placeholders::_1));
 
-    _RPCManager->AddRoute("Simulation/PatchClampDAC/Create",          std::bind(&ModelRPCInterface::PatchClampDACCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampDAC/SetOutputList",   std::bind(&ModelRPCInterface::PatchClampDACSetOutputList, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/Create",          std::bind(&ModelRPCInterface::PatchClampADCCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/SetSampleRate",   std::bind(&ModelRPCInterface::PatchClampADCSetSampleRate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/GetRecordedData", std::bind(&ModelRPCInterface::PatchClampADCGetRecordedData, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampDAC/Create",          std::bind(&ModelRPCInterface::PatchClampDACCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampDAC/SetOutputList",   std::bind(&ModelRPCInterface::PatchClampDACSetOutputList, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/Create",          std::bind(&ModelRPCInterface::PatchClampADCCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/SetSampleRate",   std::bind(&ModelRPCInterface::PatchClampADCSetSampleRate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/GetRecordedData", std::bind(&ModelRPCInterface::PatchClampADCGetRecordedData, this, std::placeholders::_1));
 
-    _RPCManager->AddRoute("Simulation/SetSpecificAPTimes",            std::bind(&ModelRPCInterface::SetSpecificAPTimes, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/SetSpontaneousActivity",        std::bind(&ModelRPCInterface::SetSpontaneousActivity, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/SetSpecificAPTimes",            std::bind(&ModelRPCInterface::SetSpecificAPTimes, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/SetSpontaneousActivity",        std::bind(&ModelRPCInterface::SetSpontaneousActivity, this, std::placeholders::_1));
 
 
 }
@@ -52,7 +54,7 @@ ModelRPCInterface::~ModelRPCInterface() {
 
 }
 
-std::string ModelRPCInterface::StapleCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::StapleCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Staple/Create", Simulations_);
     if (Handle.HasError()) {
@@ -96,7 +98,7 @@ std::string ModelRPCInterface::StapleCreate(std::string _JSONRequest) {
  * 3. Connect RData with the SrcNeuronPtr as well.
  * 4. Update the SrcNeuron type by receptor type.
  */
-std::string ModelRPCInterface::ReceptorCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::ReceptorCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Receptor/Create", Simulations_);
     if (Handle.HasError()) {
@@ -133,7 +135,7 @@ std::string ModelRPCInterface::ReceptorCreate(std::string _JSONRequest) {
  * Form: A shape.
  * Function: Some parameters.
  */
-std::string ModelRPCInterface::BSCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::BSCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/BS/Create", Simulations_);
     if (Handle.HasError()) {
@@ -153,11 +155,95 @@ std::string ModelRPCInterface::BSCreate(std::string _JSONRequest) {
     }
 
     C.ID = Handle.Sim()->AddSCCompartment(C);
+    if (C.ID<0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
 
     // Return Result ID
     return Handle.ResponseWithID("CompartmentID", C.ID);
 }
 
+/**
+ * Creates a batch of receptors that share a neurotransmitter, either all of
+ * them or none, if any compartment does not belong to a neuron.
+ */
+nlohmann::json ModelRPCInterface::ReceptorBulkCreate(const nlohmann::json& _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Receptor/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Record: SourceCompartmentID, DestinationCompartmentID, ReceptorMorphology (int32 each),
+    //         Conductance_nS, TimeConstantRise_ms, TimeConstantDecay_ms (float32 each)
+    int Count = 0;
+    std::string Bytes;
+    std::string neurotransmitter_cache;
+    if ((!Handle.GetParPackedRecords("Data", 3*sizeof(int32_t) + 3*sizeof(float), Count, Bytes))
+        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache))) {
+        return Handle.ErrResponse();
+    }
+
+    API::PackedRecordReader Reader(Bytes);
+    std::vector<Connections::Receptor> NewReceptors(Count);
+    for (Connections::Receptor& C : NewReceptors) {
+        C.SourceCompartmentID = Reader.Int32();
+        C.DestinationCompartmentID = Reader.Int32();
+        C.ShapeID = Reader.Int32();
+        C.Conductance_nS = Reader.Float32();
+        C.TimeConstantRise_ms = Reader.Float32();
+        C.TimeConstantDecay_ms = Reader.Float32();
+        C.safeset_Neurotransmitter(neurotransmitter_cache.c_str());
+    }
+    Handle.SetBulkNames(NewReceptors);
+
+    int FirstID = Handle.Sim()->AddReceptors(NewReceptors);
+    if (FirstID<0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    return Handle.BulkResponse(FirstID, Count);
+}
+
+/**
+ * Creates a batch of BS Compartments, either all of them or none, if any
+ * shape does not exist.
+ */
+nlohmann::json ModelRPCInterface::BSBulkCreate(const nlohmann::json& _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/BS/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Record: ShapeID (int32), MembranePotential_mV, SpikeThreshold_mV, DecayTime_ms,
+    //         RestingPotential_mV, AfterHyperpolarizationAmplitude_mV (float32 each)
+    int Count = 0;
+    std::string Bytes;
+    if (!Handle.GetParPackedRecords("Data", sizeof(int32_t) + 5*sizeof(float), Count, Bytes)) {
+        return Handle.ErrResponse();
+    }
+
+    API::PackedRecordReader Reader(Bytes);
+    std::vector<Compartments::BS> NewCompartments(Count);
+    for (Compartments::BS& C : NewCompartments) {
+        C.ShapeID = Reader.Int32();
+        C.MembranePotential_mV = Reader.Float32();
+        C.SpikeThreshold_mV = Reader.Float32();
+        C.DecayTime_ms = Reader.Float32();
+        C.RestingPotential_mV = Reader.Float32();
+        C.AfterHyperpolarizationAmplitude_mV = Reader.Float32();
+    }
+    Handle.SetBulkNames(NewCompartments);
+
+    int FirstID = Handle.Sim()->AddSCCompartments(NewCompartments);
+    if (FirstID<0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    return Handle.BulkResponse(FirstID, Count);
+}
+
 /*
 As of 2024-01-12 the method to add a neuron that will be run in a
 simulation is:
@@ -169,7 +255,7 @@ OR
 1. Create a NeuralCircuit.
 2. Tell the NeuralCircuit to create a neuron.
 */
-std::string ModelRPCInterface::BSNeuronCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::BSNeuronCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/BS/Create", Simulations_);
     if (Handle.HasError()) {
@@ -215,7 +301,7 @@ std::string ModelRPCInterface::BSNeuronCreate(std::string _JSONRequest) {
  * Form: A shape.
  * Function: Some parameters.
  */
-std::string ModelRPCInterface::SCCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SCCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/SC/Create", Simulations_);
     if (Handle.HasError()) {
@@ -248,7 +334,7 @@ std::string ModelRPCInterface::SCCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("CompartmentID", C.ID);
 }
 
-std::string ModelRPCInterface::SCNeuronCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SCNeuronCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/SC/Create", Simulations_);
     if (Handle.HasError()) {
@@ -286,7 +372,7 @@ std::string ModelRPCInterface::SCNeuronCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("NeuronID", C.ID);
 }
 
-std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampDACCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/OatchClampDAC/Create", Simulations_);
     if (Handle.HasError()) {
@@ -320,7 +406,7 @@ std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
  *   ]
  * }
  */
-std::string ModelRPCInterface::PatchClampDACSetOutputList(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampDACSetOutputList(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampDAC/SetOutputList", Simulations_);
     if (Handle.HasError()) {
@@ -361,7 +447,7 @@ std::string ModelRPCInterface::PatchClampDACSetOutputList(std::string _JSONReque
     return Handle.ErrResponse(); // ok
 }
 
-std::string ModelRPCInterface::PatchClampADCCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCCreate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/Create", Simulations_);
     if (Handle.HasError()) {
@@ -384,7 +470,7 @@ std::string ModelRPCInterface::PatchClampADCCreate(std::string _JSONRequest) {
     return Handle.ResponseWithID("PatchClampADCID", T.ID);
 }
 
-std::string ModelRPCInterface::PatchClampADCSetSampleRate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCSetSampleRate(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/SetSampleRate", Simulations_);
     if (Handle.HasError()) {
@@ -411,7 +497,7 @@ std::string ModelRPCInterface::PatchClampADCSetSampleRate(std::string _JSONReque
     return Handle.ErrResponse(); // ok
 }
 
-std::string ModelRPCInterface::PatchClampADCGetRecordedData(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCGetRecordedData(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/GetRecordedData", Simulations_);
     if (Handle.HasError()) {
@@ -446,7 +532,7 @@ std::string ModelRPCInterface::PatchClampADCGetRecordedData(std::string _JSONReq
  *   ]
  * }
  */
-std::string ModelRPCInterface::SetSpecificAPTimes(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SetSpecificAPTimes(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetSpecificAPTimes", Simulations_);
     if (Handle.HasError()) {
@@ -496,7 +582,7 @@ std::string ModelRPCInterface::SetSpecificAPTimes(std::string _JSONRequest) {
  *   "StatusCode": <status-code>,
  * }
  */
-std::string ModelRPCInterface::SetSpontaneousActivity(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SetSpontaneousActivity(const nlohmann::json& _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetSpontaneousActivity", Simulations_);
     if (Handle.HasError()) {
@@ -80,24 +80,33 @@ public:
      * @param _JSONRequest 
      * @return std::string 
      */
-    std::string StapleCreate(std::string _JSONRequest);
-    std::string ReceptorCreate(std::string _JSONRequest);
+    nlohmann::json StapleCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json ReceptorCreate(const nlohmann::json& _JSONRequest);
 
-    std::string BSCreate(std::string _JSONRequest);
-    std::string BSNeuronCreate(std::string _JSONRequest);
+    nlohmann::json BSCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json BSNeuronCreate(const nlohmann::json& _JSONRequest);
 
-    std::string SCCreate(std::string _JSONRequest);
-    std::string SCNeuronCreate(std::string _JSONRequest);
+    /**
+     * @brief Bulk variants of ReceptorCreate and BSCreate, each takes "Count"
+     * objects as base64 encoded packed little-endian records in "Data" and
+     * returns the first of their consecutive IDs. See Docs/API.md for the
+     * record layouts.
+     */
+    nlohmann::json ReceptorBulkCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json BSBulkCreate(const nlohmann::json& _JSONRequest);
+
+    nlohmann::json SCCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json SCNeuronCreate(const nlohmann::json& _JSONRequest);
 
-    std::string PatchClampDACCreate(std::string _JSONRequest);
-    std::string PatchClampDACSetOutputList(std::string _JSONRequest);
+    nlohmann::json PatchClampDACCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json PatchClampDACSetOutputList(const nlohmann::json& _JSONRequest);
 
-    std::string PatchClampADCCreate(std::string _JSONRequest);
-    std::string PatchClampADCSetSampleRate(std::string _JSONRequest);
-    std::string PatchClampADCGetRecordedData(std::string _JSONRequest);
+    nlohmann::json PatchClampADCCreate(const nlohmann::json& _JSONRequest);
+    nlohmann::json PatchClampADCSetSampleRate(const nlohmann::json& _JSONRequest);
+    nlohmann::json PatchClampADCGetRecordedData(const nlohmann::json& _JSONRequest);
 
-    std::string SetSpecificAPTimes(std::string _JSONRequest);
-    std::string SetSpontaneousActivity(std::string _JSONRequest);
+    nlohmann::json SetSpecificAPTimes(const nlohmann::json& _JSONRequest);
+    nlohmann::json SetSpontaneousActivity(const nlohmann::json& _JSONRequest);
 
 };
 
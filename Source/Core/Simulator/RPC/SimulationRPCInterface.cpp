@@ -4,12 +4,14 @@
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
+#include <Util/FileChunk.h>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 #include <cpp-base64/base64.h>
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <chrono>
@@ -47,6 +49,7 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
     _RPCManager->AddRoute("Simulation/Reset",                     std::bind(&SimulationRPCInterface::SimulationReset, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/SetRandomSeed",             std::bind(&SimulationRPCInterface::SimulationSetSeed, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/SetRunMethod",              std::bind(&SimulationRPCInterface::SimulationSetRunMethod, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/RunFor",                    std::bind(&SimulationRPCInterface::SimulationRunFor, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/RecordAll",                 std::bind(&SimulationRPCInterface::SimulationRecordAll, this, std::placeholders::_1));
@@ -58,6 +61,7 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
     _RPCManager->AddRoute("Simulation/GetSpikeTimes",             std::bind(&SimulationRPCInterface::SimulationGetSpikeTimes, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetRecording",              std::bind(&SimulationRPCInterface::SimulationGetRecording, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetStatus",                 std::bind(&SimulationRPCInterface::SimulationGetStatus, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/WaitFor",                   std::bind(&SimulationRPCInterface::SimulationWaitFor, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetGeoCenter",              std::bind(&SimulationRPCInterface::SimulationGetGeoCenter, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetBoundingBox",            std::bind(&SimulationRPCInterface::SimulationGetBoundingBox, this, std::placeholders::_1));
 
@@ -67,14 +71,19 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
 
     _RPCManager->AddRoute("Simulation/Save",                      std::bind(&SimulationRPCInterface::SimulationSave, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetSave",                   std::bind(&SimulationRPCInterface::SimulationGetSave, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/GetSaveChunk",              std::bind(&SimulationRPCInterface::SimulationGetSaveChunk, this, std::placeholders::_1));
+    _RPCManager->AddBinaryRoute("Simulation/GetSaveChunkRaw",     std::bind(&SimulationRPCInterface::SimulationGetSaveChunkRaw, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/Load",                      std::bind(&SimulationRPCInterface::SimulationLoad, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/SaveModel",                 std::bind(&SimulationRPCInterface::SimulationSaveModel, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/LoadModel",                 std::bind(&SimulationRPCInterface::SimulationLoadModel, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/SaveCheckpoint",            std::bind(&SimulationRPCInterface::SimulationSaveCheckpoint, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/LoadCheckpoint",            std::bind(&SimulationRPCInterface::SimulationLoadCheckpoint, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/GetSomaPositions",          std::bind(&SimulationRPCInterface::GetSomaPositions, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetConnectome",             std::bind(&SimulationRPCInterface::GetConnectome, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetAbstractConnectome",     std::bind(&SimulationRPCInterface::GetAbstractConnectome, this, std::placeholders::_1));
+    _RPCManager->AddBinaryRoute("Simulation/GetAbstractConnectomeRaw", std::bind(&SimulationRPCInterface::GetAbstractConnectomeRaw, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("ManTaskStatus",                        std::bind(&SimulationRPCInterface::ManTaskStatus, this, std::placeholders::_1));
 
@@ -112,6 +121,26 @@ bool LoadFileIntoString(const std::string& FilePath, std::string& FileContents)
     return true;    
 }
 
+//! Reads the optional downsampling parameters of the recording routes,
+//! Optional_Decimation (int >= 1) and Optional_MinMax (bool).
+bool GetOptionalColumnSignal(API::HandlerData& Handle, Tools::ColumnSignal& _Signal) {
+    nlohmann::json::iterator DecimationIterator;
+    if (Handle.FindPar("Optional_Decimation", DecimationIterator, true)) {
+        if (!DecimationIterator.value().is_number_integer() || (DecimationIterator.value().template get<int>() < 1)) {
+            return false;
+        }
+        _Signal.Factor = DecimationIterator.value().template get<int>();
+    }
+    nlohmann::json::iterator MinMaxIterator;
+    if (Handle.FindPar("Optional_MinMax", MinMaxIterator, true)) {
+        if (!MinMaxIterator.value().is_boolean()) {
+            return false;
+        }
+        _Signal.Mode = MinMaxIterator.value().template get<bool>() ? Tools::DOWNSAMPLE_MINMAX : Tools::DOWNSAMPLE_DECIMATE;
+    }
+    return true;
+}
+
 // A API::ManagerTaskData struct must have been prepared and the thread already launched.
 int SimulationRPCInterface::AddManagerTask(std::unique_ptr<API::ManagerTaskData>& TaskData) {
     // Get Task ID
@@ -163,11 +192,20 @@ void SimulationRPCInterface::SimLoadingTask(API::ManagerTaskData& TaskData) {
     // *** Not sure if we should prepend with "std::string loadresponse = " to keep the full
     //     record of the loading requests in the task output JSON.
 
+    // Saves in the request log format are read here, older saves were read into InputData.
+    RequestLog Requests;
+    if ((!TaskData.InputPath.empty()) && (!Requests.Load(TaskData.InputPath))) {
+        Logger_->Log("Unable to Read Simulation Save File " + TaskData.InputPath, 8);
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
     // Build New Simulation Object
     Simulations_.push_back(std::make_unique<Simulation>(Logger_));
     Simulation* Sim = Simulations_[Simulations_.size() - 1].get();
     assert(Sim != nullptr);
     Sim->Name = "Loaded Simulation";
+    Sim->NumThreads = Config_->SimulationNumThreads_;
     Sim->CurrentTask = SIMULATION_NONE;
     Sim->ID = Simulations_.size() - 1;
     Sim->SetRandomSeed(0);
@@ -180,7 +218,15 @@ void SimulationRPCInterface::SimLoadingTask(API::ManagerTaskData& TaskData) {
     size_t NewSimID = Sim->ID;
     TaskData.ReplaceSimulationID = NewSimID;
 
-    RPCManager_->NESRequest(TaskData.InputData, NewSimID);
+    if (TaskData.InputPath.empty()) {
+        RPCManager_->NESRequest(TaskData.InputData, NewSimID);
+    } else {
+        // Each request is handed to its handler as decoded, without a batch to parse.
+        Requests.ForEach([&](const std::string& _Route, nlohmann::json& _Request) {
+            _Request["SimulationID"] = NewSimID;
+            RPCManager_->HandleRequest(_Route, &_Request);
+        });
+    }
     TaskData.OutputData["SimulationID"] = TaskData.ReplaceSimulationID;
     TaskData.SetStatus(API::ManagerTaskStatus::Success);
     Logger_->Log("Loading Simulation " + std::to_string(TaskData.ReplaceSimulationID) + " Completed", 2);
@@ -223,6 +269,7 @@ std::string SimulationRPCInterface::SimulationCreate(std::string _JSONRequest) {
     Simulation* Sim = Simulations_[Simulations_.size() - 1].get();
     assert(Sim != nullptr);
     Sim->Name = SimulationName;
+    Sim->NumThreads = Config_->SimulationNumThreads_;
     Sim->SetRandomSeed(0);
     Sim->CurrentTask = SIMULATION_NONE;
     Sim->ID = Simulations_.size() - 1;
@@ -241,8 +288,7 @@ std::string SimulationRPCInterface::SimulationReset(std::string _JSONRequest) {
         return Handle.ErrResponse();
     }
 
-    Handle.Sim()->CurrentTask = SIMULATION_RESET; // request a reset be done
-    Handle.Sim()->WorkRequested = true;
+    Handle.Sim()->RequestWork(SIMULATION_RESET); // request a reset be done
 
     // Return Result ID
     return Handle.ErrResponse(); // ok
@@ -269,6 +315,46 @@ std::string SimulationRPCInterface::SimulationSetSeed(std::string _JSONRequest)
     return Handle.ErrResponse(); // ok
 }
 
+std::string SimulationRPCInterface::SimulationSetRunMethod(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetRunMethod", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    int Method;
+    if (!Handle.GetParInt("Method", Method)) {
+        return Handle.ErrResponse();
+    }
+    if ((Method < 0) || (Method >= NUMSIMMETHODS)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    nlohmann::json::iterator NumThreadsIterator;
+    if (Handle.FindPar("Optional_NumThreads", NumThreadsIterator, true)) {
+        if (!NumThreadsIterator.value().is_number_integer() || (NumThreadsIterator.value().template get<int>() < 0)) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        Handle.Sim()->NumThreads = NumThreadsIterator.value().template get<int>();
+    }
+
+    nlohmann::json::iterator PSPIntegrationIterator;
+    if (Handle.FindPar("Optional_PSPIntegration", PSPIntegrationIterator, true)) {
+        if (!PSPIntegrationIterator.value().is_number_integer()) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        int PSPIntegration = PSPIntegrationIterator.value().template get<int>();
+        if ((PSPIntegration < 0) || (PSPIntegration >= BallAndStick::NUMPSPINTEGRATIONMETHODS)) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        Handle.Sim()->PSPIntegration = BallAndStick::PSPIntegrationMethods(PSPIntegration);
+    }
+
+    Handle.Sim()->SimulationMethod = SimulationMethods(Method);
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
 
 // This request starts at Simulation Task.
 std::string SimulationRPCInterface::SimulationRunFor(std::string _JSONRequest) {
@@ -283,8 +369,7 @@ std::string SimulationRPCInterface::SimulationRunFor(std::string _JSONRequest) {
         return Handle.ErrResponse();
     }
     Handle.Sim()->RunTimes_ms = RunTime;
-    Handle.Sim()->CurrentTask = SIMULATION_RUNFOR; // request work be done
-    Handle.Sim()->WorkRequested = true;
+    Handle.Sim()->RequestWork(SIMULATION_RUNFOR); // request work be done
 
     // Return Result ID
     return Handle.ErrResponse(); // ok
@@ -301,6 +386,36 @@ std::string SimulationRPCInterface::SimulationRecordAll(std::string _JSONRequest
     if (!Handle.GetParFloat("MaxRecordTime_ms", MaxRecordTime)) {
         return Handle.ErrResponse();
     }
+
+    nlohmann::json::iterator RecordingFileIterator;
+    if (Handle.FindPar("Optional_RecordingFile", RecordingFileIterator, true)) {
+        if (!RecordingFileIterator.value().is_string()) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        Tools::ColumnSignal Signal;
+        if (!GetOptionalColumnSignal(Handle, Signal)) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+
+        // Per neuron overrides as [NeuronID, Decimation, MinMax] triples
+        std::map<int, Tools::ColumnSignal> NeuronSignals;
+        nlohmann::json::iterator NeuronDownsamplingIterator;
+        if (Handle.FindPar("Optional_NeuronDownsampling", NeuronDownsamplingIterator, true)) {
+            if (!NeuronDownsamplingIterator.value().is_array()) {
+                return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            }
+            for (auto & Triple : NeuronDownsamplingIterator.value()) {
+                if (!Triple.is_array() || (Triple.size() != 3) || !Triple[0].is_number_integer() || !Triple[1].is_number_integer() || !Triple[2].is_boolean() || (Triple[1].template get<int>() < 1)) {
+                    return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+                }
+                Tools::ColumnSignal& NeuronSignal = NeuronSignals[Triple[0].template get<int>()];
+                NeuronSignal.Factor = Triple[1].template get<int>();
+                NeuronSignal.Mode = Triple[2].template get<bool>() ? Tools::DOWNSAMPLE_MINMAX : Tools::DOWNSAMPLE_DECIMATE;
+            }
+        }
+        Handle.Sim()->SetRecordingFile(RecordingFileIterator.value().template get<std::string>(), Signal, NeuronSignals);
+    }
+
     Handle.Sim()->SetRecordAll(MaxRecordTime);
 
     // Return Result ID
@@ -406,7 +521,7 @@ std::string SimulationRPCInterface::SimulationGetStatus(std::string _JSONRequest
     // Return JSON
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = 0; // ok
-    ResponseJSON["IsSimulating"] = (bool)(Handle.Sim()->IsProcessing || Handle.Sim()->WorkRequested || Handle.Sim()->IsRendering);
+    ResponseJSON["IsSimulating"] = Handle.Sim()->IsBusy();
     ResponseJSON["RealWorldTimeRemaining_ms"] = 0.0;
     ResponseJSON["RealWorldTimeElapsed_ms"] = 0.0;
     ResponseJSON["InSimulationTime_ms"] = Handle.Sim()->T_ms;
@@ -415,6 +530,33 @@ std::string SimulationRPCInterface::SimulationGetStatus(std::string _JSONRequest
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
+std::string SimulationRPCInterface::SimulationWaitFor(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/WaitFor", &Simulations_, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    float Timeout_ms;
+    if (!Handle.GetParFloat("Timeout_ms", Timeout_ms)) {
+        return Handle.ErrResponse();
+    }
+    if (Timeout_ms < 0.0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    Timeout_ms = std::min(Timeout_ms, float(_SIMULATION_WAITFOR_MAX_TIMEOUT_MS));
+
+    // Blocks this RPC thread only, the engine thread wakes it when the task is done.
+    bool Idle = Handle.Sim()->WaitUntilIdle(std::chrono::milliseconds(int64_t(Timeout_ms)));
+
+    // Waiting does not change the simulation, so the request is not stored.
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = int(Handle.GetStatus());
+    ResponseJSON["IsSimulating"] = !Idle;
+    ResponseJSON["InSimulationTime_ms"] = Handle.Sim()->T_ms;
+    return ResponseJSON.dump();
+}
+
 
 std::string SimulationRPCInterface::SimulationSave(std::string _JSONRequest) {
 
@@ -426,7 +568,17 @@ std::string SimulationRPCInterface::SimulationSave(std::string _JSONRequest) {
     //std::cout << "Number of stored requests: " << Handle.Sim()->NumStoredRequests() << "\n\n";
     //std::cout << Handle.Sim()->StoredRequestsToString() << '\n';
 
-    std::string SavedSimName = Handle.Sim()->StoredRequestsSave();
+    // Runs of single create requests are saved as bulk create requests, unless disabled.
+    bool Compact = true;
+    nlohmann::json::iterator CompactIterator;
+    if (Handle.FindPar("Optional_Compact", CompactIterator, true)) {
+        if (!CompactIterator.value().is_boolean()) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        Compact = CompactIterator.value().template get<bool>();
+    }
+
+    std::string SavedSimName = Handle.Sim()->StoredRequestsSave(Compact);
     if (SavedSimName.empty()) {
         return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
     }
@@ -449,18 +601,7 @@ std::string SimulationRPCInterface::SimulationGetSave(std::string _JSONRequest)
     std::string SaveName;
     Handle.GetParString("SaveHandle", SaveName);
 
-    // Minor security feature (probably still exploitable, so be warned!)
-    // We just remove .. from the incoming handle for the image, since they're just files right now
-    // as such, if we didnt strip that, then people could read any files on the server!
-    // Also, we prepend a '.' so people can't try and get to the root
-    std::string Pattern = "..";
-    std::string::size_type i = SaveName.find(Pattern);
-    while (i != std::string::npos) {
-        Logger_->Log("Detected '..' In SaveName, It's Possible That Someone Is Trying To Do Something Nasty", 8);
-        SaveName.erase(i, Pattern.length());
-        i = SaveName.find(Pattern, i);
-    }
-    std::string SafeHandle = "SavedSimulations/" + SaveName + ".NES";
+    std::string SafeHandle = Util::SafeFilePath(Logger_, SaveName, "SavedSimulations/", ".NES");
 
 
     // Now Check If The Handle Is Valid, If So, Load It
@@ -491,6 +632,40 @@ std::string SimulationRPCInterface::SimulationGetSave(std::string _JSONRequest)
 
 
 
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "SaveHandle": <str>,
+ *   "Offset": <bytes>,
+ *   "Length": <bytes>
+ * }
+ */
+std::string SimulationRPCInterface::SimulationGetSaveChunk(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSaveChunk", &Simulations_, true, true);
+    std::string SaveName;
+    Util::FileChunk Chunk;
+    if ((Handle.HasError())
+        || (!Handle.GetParString("SaveHandle", SaveName))
+        || (!Handle.GetFileChunk(Util::SafeFilePath(Logger_, SaveName, "SavedSimulations/", ".NES"), Chunk))) {
+        return Handle.ErrResponse();
+    }
+
+    return Handle.ChunkResponse("SaveData", Chunk);
+}
+
+API::BinaryResponse SimulationRPCInterface::SimulationGetSaveChunkRaw(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSaveChunkRaw", &Simulations_, true, true);
+    std::string SaveName;
+    Util::FileChunk Chunk;
+    if (!Handle.HasError() && Handle.GetParString("SaveHandle", SaveName)) {
+        Handle.GetFileChunk(Util::SafeFilePath(Logger_, SaveName, "SavedSimulations/", ".NES"), Chunk);
+    }
+
+    return API::BinaryResponse(int(Handle.GetStatus()), Chunk.FileSize, std::move(Chunk.Data));
+}
+
 /**
  * This can be a long task (from a computer's perspective) and can lead to
  * connection closing without a response if the handler response does not
@@ -519,8 +694,12 @@ std::string SimulationRPCInterface::SimulationLoad(std::string _JSONRequest) {
     // Prepare data structure to run the actual Simulation loading in a task
     std::unique_ptr<API::ManagerTaskData> LoadTaskData = std::make_unique<API::ManagerTaskData>();
 
-    // Check if save file exists and load its request contents into the task data
-    if (!LoadFileIntoString("SavedSimulations/"+SavedSimName+".NES", LoadTaskData->InputData)) {
+    // Check if save file exists and load its request contents into the task data,
+    // request logs are read by the task itself.
+    std::string SavePath = "SavedSimulations/"+SavedSimName+".NES";
+    if (RequestLog::IsRequestLogFile(SavePath)) {
+        LoadTaskData->InputPath = SavePath;
+    } else if (!LoadFileIntoString(SavePath, LoadTaskData->InputData)) {
         Logger_->Log("Unable to Read Simulation Save File " + SavedSimName, 8);
         return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
     }
@@ -598,6 +777,71 @@ std::string SimulationRPCInterface::SimulationLoadModel(std::string _JSONRequest
     return Handle.ErrResponse(); // ok
 }
 
+/**
+ * This saves the dynamic state of a Simulation, so that a run can be continued
+ * from it later on the same model, see Simulation::SaveCheckpoint().
+ */
+std::string SimulationRPCInterface::SimulationSaveCheckpoint(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SaveCheckpoint", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Get the Checkpoint File Name
+    std::string CheckpointName;
+    if (!Handle.GetParString("Name", CheckpointName)) {
+        return Handle.ErrResponse();
+    }
+
+    // The state must not change while it is written.
+    if (Handle.Sim()->IsProcessing || Handle.Sim()->WorkRequested) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    Logger_->Log("Saving Simulation Checkpoint " + CheckpointName, 2);
+
+    if (!Handle.Sim()->SaveCheckpoint(CheckpointName)) {
+        Logger_->Log("Failed to save simulation checkpoint as "+CheckpointName, 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    Logger_->Log("Saved simulation checkpoint to "+CheckpointName, 3);
+    return Handle.ErrResponse(); // ok
+}
+
+/**
+ * This restores the dynamic state of a Simulation from a checkpoint. The
+ * neuronal circuit model must already be built or loaded.
+ */
+std::string SimulationRPCInterface::SimulationLoadCheckpoint(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LoadCheckpoint", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Get the Checkpoint File Name
+    std::string CheckpointName;
+    if (!Handle.GetParString("Name", CheckpointName)) {
+        return Handle.ErrResponse();
+    }
+
+    if (Handle.Sim()->IsProcessing || Handle.Sim()->WorkRequested) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    Logger_->Log("Loading Simulation Checkpoint " + CheckpointName, 2);
+
+    if (!Handle.Sim()->LoadCheckpoint(CheckpointName)) {
+        Logger_->Log("Failed to load simulation checkpoint "+CheckpointName, 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    Logger_->Log("Loaded simulation checkpoint "+CheckpointName, 3);
+    return Handle.ErrResponse(); // ok
+}
+
 std::string SimulationRPCInterface::SimulationGetGeoCenter(std::string _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetGeoCenter", &Simulations_);
@@ -756,6 +1000,13 @@ std::string SimulationRPCInterface::AttachRecordingElectrodes(std::string _JSONR
         if (!Handle.GetParFloat("noise_level", E.NoiseLevel, ElectodeData)) {
             Handle.ErrResponse();
         }
+        nlohmann::json::iterator CutoffIterator;
+        if (Handle.FindPar("distance_cutoff_um", CutoffIterator, ElectodeData, true)) {
+            if (!CutoffIterator.value().is_number() || (CutoffIterator.value().template get<float>() < 0.0)) {
+                return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            }
+            E.DistanceCutoff_um = CutoffIterator.value().template get<float>();
+        }
         nlohmann::json::iterator SitesIterator;
         if (!Handle.FindPar("sites", SitesIterator, ElectodeData)) {
             Handle.ErrResponse();
@@ -926,6 +1177,16 @@ std::string SimulationRPCInterface::SetRecordInstruments(std::string _JSONReques
     if (!Handle.GetParFloat("MaxRecordTime_ms", MaxRecordTime)) {
         return Handle.ErrResponse();
     }
+
+    nlohmann::json::iterator RecordingFileIterator;
+    if (Handle.FindPar("Optional_RecordingFile", RecordingFileIterator, true)) {
+        Tools::ColumnSignal Signal;
+        if (!RecordingFileIterator.value().is_string() || !GetOptionalColumnSignal(Handle, Signal)) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        Handle.Sim()->SetInstrumentsRecordingFile(RecordingFileIterator.value().template get<std::string>(), Signal);
+    }
+
     Handle.Sim()->SetRecordInstruments(MaxRecordTime);
 
     // Return Result ID
@@ -990,6 +1251,29 @@ std::string SimulationRPCInterface::GetAbstractConnectome(std::string _JSONReque
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "SimulationID": <SimID>,
+ *   "NonZero": <bool>
+ * }
+ *
+ * Responds with [StatusCode, NumConnections, bin], see
+ * Simulation::GetAbstractConnectomeBinary for the records in bin.
+ */
+API::BinaryResponse SimulationRPCInterface::GetAbstractConnectomeRaw(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetAbstractConnectomeRaw", &Simulations_);
+    bool NonZero;
+    if (Handle.HasError() || !Handle.GetParBool("NonZero", NonZero)) {
+        return API::BinaryResponse(int(Handle.GetStatus()), 0, std::vector<char>());
+    }
+
+    std::vector<char> Data = Handle.Sim()->GetAbstractConnectomeBinary(NonZero);
+    uint64_t NumConnections = Data.size() / sizeof(AbstractConnection);
+    return API::BinaryResponse(int(API::BGStatusCode::BGStatusSuccess), NumConnections, std::move(Data));
+}
+
 /**
  * Expects _JSONRequest:
  * {
@@ -56,6 +56,9 @@ namespace BG {
 namespace NES {
 namespace Simulator {
 
+//! Upper bound on the Timeout_ms of Simulation/WaitFor, so that a waiting client does not hold an RPC thread indefinitely.
+#define _SIMULATION_WAITFOR_MAX_TIMEOUT_MS 30000
+
 
 /**
  * @brief This class provides the infrastructure to run simulations.
@@ -121,16 +124,22 @@ public:
     std::string SimulationCreate(std::string _JSONRequest);
     std::string SimulationReset(std::string _JSONRequest);
     std::string SimulationSetSeed(std::string _JSONRequest);
+    std::string SimulationSetRunMethod(std::string _JSONRequest);
     std::string SimulationRunFor(std::string _JSONRequest);
     std::string SimulationRecordAll(std::string _JSONRequest);
     std::string SimulationGetSpikeTimes(std::string _JSONRequest);
     std::string SimulationGetRecording(std::string _JSONRequest);
     std::string SimulationGetStatus(std::string _JSONRequest);
+    std::string SimulationWaitFor(std::string _JSONRequest);
     std::string SimulationSave(std::string _JSONRequest);
     std::string SimulationGetSave(std::string _JSONRequest);
+    std::string SimulationGetSaveChunk(std::string _JSONRequest);
+    API::BinaryResponse SimulationGetSaveChunkRaw(std::string _JSONRequest);
     std::string SimulationLoad(std::string _JSONRequest);
     std::string SimulationSaveModel(std::string _JSONRequest);
     std::string SimulationLoadModel(std::string _JSONRequest);
+    std::string SimulationSaveCheckpoint(std::string _JSONRequest);
+    std::string SimulationLoadCheckpoint(std::string _JSONRequest);
     std::string SimulationGetGeoCenter(std::string _JSONRequest);
     std::string SimulationGetBoundingBox(std::string _JSONRequest);
 
@@ -150,6 +159,7 @@ public:
     std::string GetSomaPositions(std::string _JSONRequest);
     std::string GetConnectome(std::string _JSONRequest);
     std::string GetAbstractConnectome(std::string _JSONRequest);
+    API::BinaryResponse GetAbstractConnectomeRaw(std::string _JSONRequest);
 
 
     /**
@@ -0,0 +1,229 @@
+//=================================//
+// This file is part of BrainGenix //
+//=================================//
+
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Structs/BoundingVolumeHierarchy.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+
+//! Half the surface area of the box from _Min to _Max.
+static float HalfArea(const float* _Min, const float* _Max) {
+    float DX = _Max[0] - _Min[0];
+    float DY = _Max[1] - _Min[1];
+    float DZ = _Max[2] - _Min[2];
+    return DX * DY + DY * DZ + DZ * DX;
+}
+
+static void GrowBounds(float* _Min, float* _Max, const std::array<float, 6>& _Box) {
+    for (int Axis = 0; Axis < 3; Axis++) {
+        _Min[Axis] = std::min(_Min[Axis], _Box[Axis]);
+        _Max[Axis] = std::max(_Max[Axis], _Box[3 + Axis]);
+    }
+}
+
+void BoundingVolumeHierarchy::Build(const std::vector<BoundingBox>& _Boxes) {
+    Nodes_.clear();
+    Indices_.clear();
+    Boxes_.clear();
+
+    // Boxes with ordered corners and their centroids, by box index.
+    std::vector<std::array<float, 6>> Bounds(_Boxes.size());
+    std::vector<std::array<float, 3>> Centroids(_Boxes.size());
+    for (size_t i = 0; i < _Boxes.size(); i++) {
+        bool HasNaN = false;
+        for (int Axis = 0; Axis < 3; Axis++) {
+            float P1 = _Boxes[i].bb_point1[Axis];
+            float P2 = _Boxes[i].bb_point2[Axis];
+            HasNaN = HasNaN || std::isnan(P1) || std::isnan(P2);
+            Bounds[i][Axis] = std::min(P1, P2);
+            Bounds[i][3 + Axis] = std::max(P1, P2);
+            float Centroid = 0.5f * (Bounds[i][Axis] + Bounds[i][3 + Axis]);
+            Centroids[i][Axis] = std::isfinite(Centroid) ? Centroid : 0.0f;
+        }
+        if (!HasNaN) {
+            Indices_.push_back(uint32_t(i));
+        }
+    }
+    if (Indices_.empty()) {
+        return;
+    }
+
+    // A tree with n leaves has 2n - 1 nodes, so nodes are never moved while
+    // they are referenced below.
+    Nodes_.reserve(2 * Indices_.size());
+    Nodes_.emplace_back();
+    struct Range {
+        uint32_t Node;
+        uint32_t Begin;
+        uint32_t End;
+    };
+    std::vector<Range> Stack{ Range{ 0, 0, uint32_t(Indices_.size()) } };
+    while (!Stack.empty()) {
+        Range NodeRange = Stack.back();
+        Stack.pop_back();
+
+        Node& ThisNode = Nodes_[NodeRange.Node];
+        ThisNode.First = NodeRange.Begin;
+        ThisNode.Count = NodeRange.End - NodeRange.Begin;
+        float CentroidMin[3], CentroidMax[3];
+        for (int Axis = 0; Axis < 3; Axis++) {
+            ThisNode.Min[Axis] = CentroidMin[Axis] = std::numeric_limits<float>::infinity();
+            ThisNode.Max[Axis] = CentroidMax[Axis] = -std::numeric_limits<float>::infinity();
+        }
+        for (uint32_t i = NodeRange.Begin; i < NodeRange.End; i++) {
+            GrowBounds(ThisNode.Min, ThisNode.Max, Bounds[Indices_[i]]);
+            const std::array<float, 3>& Centroid = Centroids[Indices_[i]];
+            for (int Axis = 0; Axis < 3; Axis++) {
+                CentroidMin[Axis] = std::min(CentroidMin[Axis], Centroid[Axis]);
+                CentroidMax[Axis] = std::max(CentroidMax[Axis], Centroid[Axis]);
+            }
+        }
+        if (ThisNode.Count <= _BVH_MIN_LEAF_SIZE) {
+            continue;
+        }
+
+        // Bin the centroids along each axis and take the split between bins
+        // with the lowest surface area heuristic cost.
+        auto BinOf = [&](uint32_t _Index, int _Axis) {
+            float Scale = _BVH_NUM_BINS / (CentroidMax[_Axis] - CentroidMin[_Axis]);
+            int Bin = int((Centroids[_Index][_Axis] - CentroidMin[_Axis]) * Scale);
+            return std::clamp(Bin, 0, _BVH_NUM_BINS - 1);
+        };
+        float BestCost = std::numeric_limits<float>::infinity();
+        int BestAxis = -1;
+        int BestSplit = 0;
+        for (int Axis = 0; Axis < 3; Axis++) {
+            float Extent = CentroidMax[Axis] - CentroidMin[Axis];
+            if (!(Extent > 0.0f) || !std::isfinite(Extent)) {
+                continue;
+            }
+            uint32_t BinCount[_BVH_NUM_BINS] = {};
+            float BinMin[_BVH_NUM_BINS][3], BinMax[_BVH_NUM_BINS][3];
+            std::fill(&BinMin[0][0], &BinMin[0][0] + 3 * _BVH_NUM_BINS, std::numeric_limits<float>::infinity());
+            std::fill(&BinMax[0][0], &BinMax[0][0] + 3 * _BVH_NUM_BINS, -std::numeric_limits<float>::infinity());
+            for (uint32_t i = NodeRange.Begin; i < NodeRange.End; i++) {
+                int Bin = BinOf(Indices_[i], Axis);
+                BinCount[Bin]++;
+                GrowBounds(BinMin[Bin], BinMax[Bin], Bounds[Indices_[i]]);
+            }
+
+            // Area times count of the bins right of each split, swept from the right.
+            float RightCost[_BVH_NUM_BINS];
+            float RightMin[3], RightMax[3];
+            std::fill(RightMin, RightMin + 3, std::numeric_limits<float>::infinity());
+            std::fill(RightMax, RightMax + 3, -std::numeric_limits<float>::infinity());
+            uint32_t RightCount = 0;
+            for (int Bin = _BVH_NUM_BINS - 1; Bin > 0; Bin--) {
+                for (int a = 0; a < 3; a++) {
+                    RightMin[a] = std::min(RightMin[a], BinMin[Bin][a]);
+                    RightMax[a] = std::max(RightMax[a], BinMax[Bin][a]);
+                }
+                RightCount += BinCount[Bin];
+                RightCost[Bin] = (RightCount > 0) ? RightCount * HalfArea(RightMin, RightMax) : 0.0f;
+            }
+            float LeftMin[3], LeftMax[3];
+            std::fill(LeftMin, LeftMin + 3, std::numeric_limits<float>::infinity());
+            std::fill(LeftMax, LeftMax + 3, -std::numeric_limits<float>::infinity());
+            uint32_t LeftCount = 0;
+            for (int Split = 1; Split < _BVH_NUM_BINS; Split++) {
+                for (int a = 0; a < 3; a++) {
+                    LeftMin[a] = std::min(LeftMin[a], BinMin[Split - 1][a]);
+                    LeftMax[a] = std::max(LeftMax[a], BinMax[Split - 1][a]);
+                }
+                LeftCount += BinCount[Split - 1];
+                if ((LeftCount == 0) || (LeftCount == ThisNode.Count)) {
+                    continue;
+                }
+                float Cost = LeftCount * HalfArea(LeftMin, LeftMax) + RightCost[Split];
+                if (Cost < BestCost) {
+                    BestCost = Cost;
+                    BestAxis = Axis;
+                    BestSplit = Split;
+                }
+            }
+        }
+
+        // Centroids that all coincide can not be split. Otherwise split if
+        // that is cheaper than testing every box of a leaf, which costs one
+        // more node test than the boxes themselves.
+        if (BestAxis < 0) {
+            continue;
+        }
+        float LeafCost = ThisNode.Count * HalfArea(ThisNode.Min, ThisNode.Max);
+        if ((BestCost + HalfArea(ThisNode.Min, ThisNode.Max) >= LeafCost) && (ThisNode.Count <= _BVH_MAX_LEAF_SIZE)) {
+            continue;
+        }
+        uint32_t* Middle = std::partition(Indices_.data() + NodeRange.Begin, Indices_.data() + NodeRange.End, [&](uint32_t _Index) {
+            return BinOf(_Index, BestAxis) < BestSplit;
+        });
+        uint32_t Mid = uint32_t(Middle - Indices_.data());
+
+        ThisNode.Count = 0;
+        ThisNode.First = uint32_t(Nodes_.size());
+        Nodes_.emplace_back();
+        Nodes_.emplace_back();
+        Stack.push_back(Range{ ThisNode.First, NodeRange.Begin, Mid });
+        Stack.push_back(Range{ ThisNode.First + 1, Mid, NodeRange.End });
+    }
+
+    // Keep the boxes of each leaf next to each other for the queries.
+    Boxes_.resize(Indices_.size());
+    for (size_t i = 0; i < Indices_.size(); i++) {
+        Boxes_[i] = Bounds[Indices_[i]];
+    }
+}
+
+void BoundingVolumeHierarchy::Query(BoundingBox _Region, std::vector<size_t>& _Hits) const {
+    if (Nodes_.empty()) {
+        return;
+    }
+    float RegionMin[3], RegionMax[3];
+    for (int Axis = 0; Axis < 3; Axis++) {
+        RegionMin[Axis] = std::min(_Region.bb_point1[Axis], _Region.bb_point2[Axis]);
+        RegionMax[Axis] = std::max(_Region.bb_point1[Axis], _Region.bb_point2[Axis]);
+    }
+    auto Overlaps = [&](const float* _Min, const float* _Max) {
+        return (_Max[0] >= RegionMin[0]) && (RegionMax[0] >= _Min[0])
+            && (_Max[1] >= RegionMin[1]) && (RegionMax[1] >= _Min[1])
+            && (_Max[2] >= RegionMin[2]) && (RegionMax[2] >= _Min[2]);
+    };
+
+    size_t FirstHit = _Hits.size();
+    std::vector<uint32_t> Stack{ 0 };
+    while (!Stack.empty()) {
+        const Node& ThisNode = Nodes_[Stack.back()];
+        Stack.pop_back();
+        if (!Overlaps(ThisNode.Min, ThisNode.Max)) {
+            continue;
+        }
+        if (ThisNode.Count == 0) {
+            Stack.push_back(ThisNode.First);
+            Stack.push_back(ThisNode.First + 1);
+            continue;
+        }
+        for (uint32_t i = ThisNode.First; i < ThisNode.First + ThisNode.Count; i++) {
+            if (Overlaps(Boxes_[i].data(), Boxes_[i].data() + 3)) {
+                _Hits.push_back(Indices_[i]);
+            }
+        }
+    }
+    std::sort(_Hits.begin() + FirstHit, _Hits.end());
+}
+
+
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,80 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the bounding volume hierarchy.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Structs/BoundingVolumeHierarchy.h>
+
+
+static BG::NES::Simulator::BoundingBox Box(float x1, float y1, float z1, float x2, float y2, float z2) {
+    BG::NES::Simulator::BoundingBox box;
+    box.bb_point1[0] = x1; box.bb_point1[1] = y1; box.bb_point1[2] = z1;
+    box.bb_point2[0] = x2; box.bb_point2[1] = y2; box.bb_point2[2] = z2;
+    return box;
+}
+
+TEST(BoundingVolumeHierarchyTest, test_Query_same_as_IsIntersecting) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.0f, 20.0f);
+
+    std::vector<BG::NES::Simulator::BoundingBox> boxes;
+    for (int i = 0; i < 5000; i++) {
+        float x = position(generator), y = position(generator), z = position(generator);
+        // Some boxes have their corners swapped, as the cylinder culling boxes can.
+        if ((i % 5) == 0) {
+            boxes.push_back(Box(x + size(generator), y + size(generator), z, x, y, z - size(generator)));
+        } else {
+            boxes.push_back(Box(x, y, z, x + size(generator), y + size(generator), z + size(generator)));
+        }
+    }
+    // Many boxes at the same place can not be split.
+    for (int i = 0; i < 40; i++) {
+        boxes.push_back(Box(500.0f, 500.0f, 500.0f, 501.0f, 501.0f, 501.0f));
+    }
+    boxes.push_back(Box(NAN, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f));
+
+    BG::NES::Simulator::BoundingVolumeHierarchy hierarchy;
+    hierarchy.Build(boxes);
+    ASSERT_EQ(hierarchy.Size(), boxes.size() - 1);
+
+    for (int q = 0; q < 50; q++) {
+        float x = position(generator), y = position(generator), z = position(generator);
+        BG::NES::Simulator::BoundingBox region = Box(x, y, z, x + 10.0f * q, y + 5.0f * q, z + 100.0f);
+        if (q == 0) {
+            region = Box(501.0f, 501.0f, 501.0f, 600.0f, 600.0f, 600.0f); // touches the stacked boxes
+        }
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < boxes.size(); i++) {
+            if (boxes[i].IsIntersecting(region)) {
+                expected.push_back(i);
+            }
+        }
+        std::vector<size_t> hits;
+        hierarchy.Query(region, hits);
+        ASSERT_EQ(hits, expected);
+    }
+}
+
+TEST(BoundingVolumeHierarchyTest, test_Query_empty_hierarchy) {
+    BG::NES::Simulator::BoundingVolumeHierarchy hierarchy;
+    std::vector<size_t> hits;
+    hierarchy.Query(Box(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f), hits);
+    ASSERT_TRUE(hits.empty());
+
+    hierarchy.Build({});
+    hierarchy.Query(Box(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f), hits);
+    ASSERT_TRUE(hits.empty());
+}
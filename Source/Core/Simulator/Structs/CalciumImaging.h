@@ -56,7 +56,7 @@ struct CalciumImaging {
     //Geometries::Vec3D Dz{0.0, 0.0, 1.0}; // Positive dz indicates most visible top surface.
 
     std::vector<float> FluorescenceKernel;
-    std::vector<float> ReversedFluorescenceKernel;
+    float FluorescenceKernelSum = 0.0; /**Sum of the sampled kernel, used to normalize the neuron Ca filters*/
     float max_pixel_contributions = 0.0;
     // std::vector<float> image_dims_px; // *** or unsigned int?
     //??? image_t; // Image taken at time t.
@@ -81,7 +81,10 @@ struct CalciumImaging {
     // void InitializeProjectionCircles();
 
     void InitializeFluorescenceKernel(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
-    void InitializeFluorescingNeuronFIFOs(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
+    void InitializeFluorescingNeuronFilters(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
+
+    //! Tells if Record() will take a sample at time t_ms.
+    bool IsSampleDue(float t_ms) const;
 
     void Record(float t_ms, Simulation* Sim, NES::VSDA::Calcium::CaMicroscopeParameters& _Params);
 
@@ -0,0 +1,303 @@
+#include <Simulator/Structs/ColumnRecorder.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+//! Number of values per file block, a multiple of the page size in bytes.
+#define _COLUMNRECORDER_BLOCK_FLOATS 4096
+#define _COLUMNRECORDER_BLOCK_BYTES (_COLUMNRECORDER_BLOCK_FLOATS * sizeof(float))
+#define _COLUMNRECORDER_VERSION 1
+
+//! Layout of the header block at the start of the file.
+struct ColumnRecorderHeader {
+    char Magic[8] = { 'B', 'G', 'N', 'E', 'S', 'R', 'E', 'C' };
+    uint32_t Version = _COLUMNRECORDER_VERSION;
+    uint32_t BlockFloats = _COLUMNRECORDER_BLOCK_FLOATS;
+    uint64_t NumColumns = 0;
+};
+
+ColumnRecorder::~ColumnRecorder() {
+    Close();
+}
+
+bool ColumnRecorder::Open(const std::string& _Path, const std::vector<ColumnSignal>& _Signals, size_t _ExpectedSamples) {
+    Close();
+
+    Columns_.assign(_Signals.size(), Column());
+    size_t ExpectedBlocks = 1;
+    for (size_t c = 0; c < _Signals.size(); c++) {
+        Columns_[c].Signal = _Signals[c];
+        Columns_[c].Signal.Factor = std::max<size_t>(_Signals[c].Factor, 1);
+        size_t ValuesPerWindow = (_Signals[c].Mode == DOWNSAMPLE_MINMAX) ? 2 : 1;
+        size_t ExpectedValues = ValuesPerWindow * (_ExpectedSamples / Columns_[c].Signal.Factor);
+        ExpectedBlocks += std::max<size_t>((ExpectedValues + _COLUMNRECORDER_BLOCK_FLOATS - 1) / _COLUMNRECORDER_BLOCK_FLOATS, 1);
+    }
+
+    FileDescriptor_ = open(_Path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (FileDescriptor_ < 0) {
+        Columns_.clear();
+        return false;
+    }
+    Path_ = _Path;
+    if (!Resize(ExpectedBlocks)) {
+        Close();
+        return false;
+    }
+    NumBlocksUsed_ = 1;
+
+    ColumnRecorderHeader Header;
+    Header.NumColumns = Columns_.size();
+    std::memcpy(Map_, &Header, sizeof(Header));
+    return true;
+}
+
+void ColumnRecorder::Close() {
+    if (Map_ != nullptr) {
+        msync(Map_, NumBlocks_ * _COLUMNRECORDER_BLOCK_BYTES, MS_SYNC);
+        munmap(Map_, NumBlocks_ * _COLUMNRECORDER_BLOCK_BYTES);
+        Map_ = nullptr;
+    }
+    if (FileDescriptor_ >= 0) {
+        close(FileDescriptor_);
+        FileDescriptor_ = -1;
+    }
+    NumBlocks_ = 0;
+    NumBlocksUsed_ = 0;
+    Failed_ = false;
+    Columns_.clear();
+}
+
+void ColumnRecorder::Swap(ColumnRecorder& _Other) {
+    std::swap(Path_, _Other.Path_);
+    std::swap(FileDescriptor_, _Other.FileDescriptor_);
+    std::swap(Map_, _Other.Map_);
+    std::swap(NumBlocks_, _Other.NumBlocks_);
+    std::swap(NumBlocksUsed_, _Other.NumBlocksUsed_);
+    std::swap(Failed_, _Other.Failed_);
+    std::swap(Columns_, _Other.Columns_);
+}
+
+//! State layout: NumBlocksUsed_, number of columns, then per column Factor,
+//! Mode, NumValues, NumInWindow, Min and Max bits, number of blocks and the
+//! blocks.
+std::vector<uint64_t> ColumnRecorder::GetState() const {
+    std::vector<uint64_t> State;
+    if (!IsOpen()) return State;
+
+    State.emplace_back(NumBlocksUsed_);
+    State.emplace_back(Columns_.size());
+    for (const Column& C : Columns_) {
+        uint32_t MinBits, MaxBits;
+        std::memcpy(&MinBits, &C.Min, sizeof(MinBits));
+        std::memcpy(&MaxBits, &C.Max, sizeof(MaxBits));
+        State.insert(State.end(), { C.Signal.Factor, uint64_t(C.Signal.Mode), C.NumValues, C.NumInWindow, MinBits, MaxBits, C.Blocks.size() });
+        State.insert(State.end(), C.Blocks.begin(), C.Blocks.end());
+    }
+    return State;
+}
+
+bool ColumnRecorder::Resume(const std::string& _Path, const std::vector<uint64_t>& _State) {
+    Close();
+    if (_State.size() < 2) return false;
+
+    std::vector<Column> Columns(_State[1]);
+    size_t Pos = 2;
+    for (Column& C : Columns) {
+        if (Pos + 7 > _State.size()) return false;
+        C.Signal.Factor = std::max<uint64_t>(_State[Pos], 1);
+        C.Signal.Mode = DownsampleModes(std::min<uint64_t>(_State[Pos + 1], NUMDOWNSAMPLEMODES - 1));
+        C.NumValues = _State[Pos + 2];
+        C.NumInWindow = _State[Pos + 3];
+        uint32_t MinBits = uint32_t(_State[Pos + 4]);
+        uint32_t MaxBits = uint32_t(_State[Pos + 5]);
+        std::memcpy(&C.Min, &MinBits, sizeof(MinBits));
+        std::memcpy(&C.Max, &MaxBits, sizeof(MaxBits));
+        size_t NumColumnBlocks = _State[Pos + 6];
+        Pos += 7;
+        if ((Pos + NumColumnBlocks > _State.size()) || (NumColumnBlocks != (C.NumValues + _COLUMNRECORDER_BLOCK_FLOATS - 1) / _COLUMNRECORDER_BLOCK_FLOATS)) return false;
+        for (size_t b = 0; b < NumColumnBlocks; b++) {
+            if ((_State[Pos + b] == 0) || (_State[Pos + b] >= _State[0])) return false;
+            C.Blocks.emplace_back(uint32_t(_State[Pos + b]));
+        }
+        Pos += NumColumnBlocks;
+    }
+
+    FileDescriptor_ = open(_Path.c_str(), O_RDWR);
+    if (FileDescriptor_ < 0) return false;
+    struct stat FileStat;
+    ColumnRecorderHeader Header;
+    if ((fstat(FileDescriptor_, &FileStat) != 0)
+        || (size_t(FileStat.st_size) < _State[0] * _COLUMNRECORDER_BLOCK_BYTES)
+        || (pread(FileDescriptor_, &Header, sizeof(Header), 0) != sizeof(Header))
+        || (std::memcmp(Header.Magic, "BGNESREC", sizeof(Header.Magic)) != 0)
+        || (Header.NumColumns != Columns.size())) {
+        close(FileDescriptor_);
+        FileDescriptor_ = -1;
+        return false;
+    }
+
+    Path_ = _Path;
+    Columns_ = std::move(Columns);
+    if (!Resize(FileStat.st_size / _COLUMNRECORDER_BLOCK_BYTES)) {
+        Close();
+        return false;
+    }
+    NumBlocksUsed_ = _State[0];
+    return true;
+}
+
+/**
+ * The new mapping is made before the old one is released (mremap() moves
+ * it if it can not grow in place), so on failure the recorder keeps the
+ * mapping and the file size it had.
+ */
+bool ColumnRecorder::Resize(size_t _NumBlocks) {
+    size_t OldBytes = NumBlocks_ * _COLUMNRECORDER_BLOCK_BYTES;
+    size_t NewBytes = _NumBlocks * _COLUMNRECORDER_BLOCK_BYTES;
+
+    // Extending the file with ftruncate() leaves it sparse until blocks are written.
+    if (ftruncate(FileDescriptor_, off_t(NewBytes)) != 0) {
+        return false;
+    }
+    void* Map = (Map_ == nullptr) ? mmap(nullptr, NewBytes, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor_, 0)
+                                  : mremap(Map_, OldBytes, NewBytes, MREMAP_MAYMOVE);
+    if (Map == MAP_FAILED) {
+        // Give back the sparse tail, if that fails too the file just stays larger.
+        if (Map_ != nullptr) {
+            int Result = ftruncate(FileDescriptor_, off_t(OldBytes));
+            (void)Result;
+        }
+        return false;
+    }
+    Map_ = static_cast<char*>(Map);
+    NumBlocks_ = _NumBlocks;
+    return true;
+}
+
+float* ColumnRecorder::BlockData(uint32_t _Block) const {
+    return reinterpret_cast<float*>(Map_ + size_t(_Block) * _COLUMNRECORDER_BLOCK_BYTES);
+}
+
+bool ColumnRecorder::ReserveStep() {
+    assert(IsOpen());
+    if (Failed_) return false;
+
+    // Count the blocks the values completed by one more sample would start.
+    size_t NewBlocks = 0;
+    for (const Column& C : Columns_) {
+        size_t NumStored = 0;
+        if (C.Signal.Mode == DOWNSAMPLE_MINMAX) {
+            NumStored = (C.NumInWindow + 1 == C.Signal.Factor) ? 2 : 0;
+        } else {
+            NumStored = (C.NumInWindow == 0) ? 1 : 0;
+        }
+        NewBlocks += (C.NumValues + NumStored + _COLUMNRECORDER_BLOCK_FLOATS - 1) / _COLUMNRECORDER_BLOCK_FLOATS - C.Blocks.size();
+    }
+
+    size_t NeededBlocks = NumBlocksUsed_ + NewBlocks;
+    if ((NeededBlocks > NumBlocks_) && !Resize(std::max(2 * NumBlocks_, NeededBlocks))) {
+        // Out of disk space or address space, the recording stops before
+        // this step, so that its columns stay aligned.
+        Failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+void ColumnRecorder::Store(Column& _Column, float _Value) {
+    size_t Offset = _Column.NumValues % _COLUMNRECORDER_BLOCK_FLOATS;
+    if (Offset == 0) {
+        if ((NumBlocksUsed_ == NumBlocks_) && !Resize(2 * NumBlocks_)) {
+            // Out of disk space or address space, the recording stops here.
+            // Without ReserveStep() the other columns may already hold a
+            // value of this step.
+            Failed_ = true;
+            return;
+        }
+        _Column.Blocks.emplace_back(uint32_t(NumBlocksUsed_++));
+    }
+
+    float* Block = BlockData(_Column.Blocks.back());
+    Block[Offset] = _Value;
+    _Column.NumValues++;
+
+    // Write back a full block and drop its pages from the resident set, it
+    // is only touched again when the column is read.
+    if (Offset + 1 == _COLUMNRECORDER_BLOCK_FLOATS) {
+        msync(Block, _COLUMNRECORDER_BLOCK_BYTES, MS_ASYNC);
+        madvise(Block, _COLUMNRECORDER_BLOCK_BYTES, MADV_DONTNEED);
+    }
+}
+
+void ColumnRecorder::Append(size_t _Column, float _Value) {
+    assert(IsOpen() && (_Column < Columns_.size()));
+    if (Failed_) return;
+    Column& C = Columns_[_Column];
+
+    if (C.Signal.Mode == DOWNSAMPLE_MINMAX) {
+        if (C.NumInWindow == 0) {
+            C.Min = _Value;
+            C.Max = _Value;
+        } else {
+            C.Min = std::min(C.Min, _Value);
+            C.Max = std::max(C.Max, _Value);
+        }
+        if (++C.NumInWindow == C.Signal.Factor) {
+            Store(C, C.Min);
+            Store(C, C.Max);
+            C.NumInWindow = 0;
+        }
+        return;
+    }
+
+    if (C.NumInWindow == 0) {
+        Store(C, _Value);
+    }
+    if (++C.NumInWindow == C.Signal.Factor) {
+        C.NumInWindow = 0;
+    }
+}
+
+size_t ColumnRecorder::Read(size_t _Column, size_t _First, size_t _Count, float* _Out) const {
+    const Column& C = Columns_.at(_Column);
+    if (_First >= C.NumValues) return 0;
+    _Count = std::min(_Count, C.NumValues - _First);
+
+    size_t Copied = 0;
+    while (Copied < _Count) {
+        size_t Index = _First + Copied;
+        size_t Offset = Index % _COLUMNRECORDER_BLOCK_FLOATS;
+        size_t Run = std::min(_Count - Copied, _COLUMNRECORDER_BLOCK_FLOATS - Offset);
+        std::memcpy(_Out + Copied, BlockData(C.Blocks[Index / _COLUMNRECORDER_BLOCK_FLOATS]) + Offset, Run * sizeof(float));
+        Copied += Run;
+    }
+    return Copied;
+}
+
+std::vector<float> ColumnRecorder::ReadColumn(size_t _Column) const {
+    std::vector<float> Values(NumValues(_Column));
+    Read(_Column, 0, Values.size(), Values.data());
+    return Values;
+}
+
+bool ColumnRecorder::Sync() {
+    if (Map_ == nullptr) return false;
+    return msync(Map_, NumBlocks_ * _COLUMNRECORDER_BLOCK_BYTES, MS_ASYNC) == 0;
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,175 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the ColumnRecorder struct, a streaming recorder that writes
+                 fixed-width float columns into a memory-mapped file.
+    Additional Notes: Each column is stored as a chain of fixed size blocks in the file, so a
+                      recording only keeps the blocks currently being filled resident in memory.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+//! How consecutive samples of a signal are reduced to the values stored in its column.
+//! DOWNSAMPLE_DECIMATE stores the first sample of each window of Factor samples,
+//! DOWNSAMPLE_MINMAX stores the minimum and then the maximum of each window.
+enum DownsampleModes { DOWNSAMPLE_DECIMATE, DOWNSAMPLE_MINMAX, NUMDOWNSAMPLEMODES };
+
+/**
+ * @brief Downsampling settings of one recorded signal.
+ *
+ */
+struct ColumnSignal {
+    size_t Factor = 1; /**Number of appended samples per window, 1 stores every sample*/
+    DownsampleModes Mode = DOWNSAMPLE_DECIMATE;
+
+    bool operator==(const ColumnSignal& _Other) const { return (Factor == _Other.Factor) && (Mode == _Other.Mode); }
+    bool operator!=(const ColumnSignal& _Other) const { return !(*this == _Other); }
+};
+
+/**
+ * @brief Streaming recorder of float columns in a memory-mapped file.
+ *
+ * The file starts with a header block, followed by blocks of
+ * _COLUMNRECORDER_BLOCK_FLOATS values that are handed out to columns as
+ * they fill up. The file is pre-sized for the expected number of samples
+ * and doubled when it runs out of blocks. If it can not be doubled, the
+ * recording stops, see HasFailed(). Callers that append one sample to every
+ * column per step call ReserveStep() first, so that a failure never leaves
+ * the columns a sample apart. Full blocks are written back
+ * and released from the resident set, so memory use does not grow with
+ * the length of the recording.
+ *
+ * Samples are appended one at a time per column, and a column only stores
+ * complete downsampling windows. Columns are read back from the mapping.
+ */
+struct ColumnRecorder {
+
+    ColumnRecorder() = default;
+    ~ColumnRecorder();
+
+    ColumnRecorder(const ColumnRecorder&) = delete;
+    ColumnRecorder& operator=(const ColumnRecorder&) = delete;
+
+    /**
+     * @brief Creates (or truncates) the file at _Path and maps it.
+     *
+     * @param _Path File to record into.
+     * @param _Signals Downsampling settings, one per column.
+     * @param _ExpectedSamples Number of samples per column to pre-size the file for.
+     * @return true on success, false if the file could not be created or mapped.
+     */
+    bool Open(const std::string& _Path, const std::vector<ColumnSignal>& _Signals, size_t _ExpectedSamples = 0);
+
+    //! Writes back and unmaps the file, partially filled windows are dropped.
+    void Close();
+
+    /**
+     * @brief Returns the column layout and fill state of an open recorder,
+     * including partially filled windows, as a flat array for checkpoints.
+     *
+     * @return Empty if the recorder is not open.
+     */
+    std::vector<uint64_t> GetState() const;
+
+    /**
+     * @brief Reopens an existing recording file and continues appending
+     * after the values described by a state returned by GetState().
+     *
+     * Values stored in the file after that state was taken are overwritten
+     * as new values are appended.
+     *
+     * @return true on success, false if the file or the state does not match.
+     */
+    bool Resume(const std::string& _Path, const std::vector<uint64_t>& _State);
+
+    //! Exchanges the files and states of two recorders.
+    void Swap(ColumnRecorder& _Other);
+
+    bool IsOpen() const { return Map_ != nullptr; }
+    const std::string& Path() const { return Path_; }
+    size_t NumColumns() const { return Columns_.size(); }
+    const ColumnSignal& Signal(size_t _Column) const { return Columns_.at(_Column).Signal; }
+
+    //! True once the file could not grow, Append() then drops all samples.
+    bool HasFailed() const { return Failed_; }
+
+    /**
+     * @brief Makes sure the file has the blocks to store one more sample of
+     * every column, growing it if needed. Call it before the first Append()
+     * of a step, so that a step is stored for all columns or for none.
+     *
+     * @return false if the file could not grow, the recorder has then failed.
+     */
+    bool ReserveStep();
+
+    //! Appends a sample to a column, storing a value whenever a window completes.
+    void Append(size_t _Column, float _Value);
+
+    //! Number of values stored in a column.
+    size_t NumValues(size_t _Column) const { return Columns_.at(_Column).NumValues; }
+
+    /**
+     * @brief Copies up to _Count stored values of a column starting at _First.
+     *
+     * @return Number of values copied.
+     */
+    size_t Read(size_t _Column, size_t _First, size_t _Count, float* _Out) const;
+
+    //! Returns all stored values of a column.
+    std::vector<float> ReadColumn(size_t _Column) const;
+
+    //! Schedules all dirty pages to be written back to the file.
+    bool Sync();
+
+private:
+
+    struct Column {
+        ColumnSignal Signal;
+        std::vector<uint32_t> Blocks; /**File blocks holding the values of this column, in order*/
+        size_t NumValues = 0;
+        size_t NumInWindow = 0; /**Samples appended to the current window*/
+        float Min = 0.0;
+        float Max = 0.0;
+    };
+
+    //! Stores a value at the end of a column, taking a new block if needed.
+    void Store(Column& _Column, float _Value);
+
+    //! Resizes the file and the mapping to _NumBlocks blocks including the header.
+    bool Resize(size_t _NumBlocks);
+
+    float* BlockData(uint32_t _Block) const;
+
+    std::string Path_;
+    int FileDescriptor_ = -1;
+    char* Map_ = nullptr;
+    size_t NumBlocks_ = 0;     /**Blocks in the file, including the header block*/
+    size_t NumBlocksUsed_ = 0; /**Blocks handed out to columns, including the header block*/
+    bool Failed_ = false;      /**Set when the file could not grow, nothing is appended after that*/
+    std::vector<Column> Columns_;
+
+};
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
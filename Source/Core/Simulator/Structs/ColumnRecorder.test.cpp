@@ -0,0 +1,325 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the ColumnRecorder struct.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <csignal>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/ColumnRecorder.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+
+
+/**
+ * @brief Test class for unit tests for the ColumnRecorder struct.
+ *
+ */
+struct ColumnRecorderTest : testing::Test {
+    BG::NES::Simulator::Tools::ColumnRecorder testRecorder;
+    std::string path;
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("ColumnRecorderTest-" + std::to_string(::getpid()) + ".bgrec")).string();
+    }
+
+    void TearDown() {
+        testRecorder.Close();
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(ColumnRecorderTest, test_Open_writes_header) {
+    ASSERT_TRUE(testRecorder.Open(path, std::vector<BG::NES::Simulator::Tools::ColumnSignal>(3), 100));
+    ASSERT_TRUE(testRecorder.IsOpen());
+    ASSERT_EQ(testRecorder.NumColumns(), 3);
+    ASSERT_EQ(testRecorder.NumValues(0), 0);
+    testRecorder.Close();
+
+    std::ifstream file(path, std::ios::binary);
+    char magic[8];
+    file.read(magic, sizeof(magic));
+    ASSERT_EQ(std::memcmp(magic, "BGNESREC", 8), 0);
+}
+
+TEST_F(ColumnRecorderTest, test_Open_fails_for_bad_path) {
+    ASSERT_FALSE(testRecorder.Open("/nonexistent-directory/recording.bgrec", std::vector<BG::NES::Simulator::Tools::ColumnSignal>(1)));
+    ASSERT_FALSE(testRecorder.IsOpen());
+}
+
+TEST_F(ColumnRecorderTest, test_Append_grows_beyond_expected_size) {
+    // Pre-size for few samples, so that the file has to grow several times.
+    ASSERT_TRUE(testRecorder.Open(path, std::vector<BG::NES::Simulator::Tools::ColumnSignal>(2), 10));
+
+    const size_t numSamples = 20000;
+    for (size_t i = 0; i < numSamples; ++i) {
+        testRecorder.Append(0, float(i));
+        testRecorder.Append(1, -float(i));
+    }
+
+    std::vector<float> column0 = testRecorder.ReadColumn(0);
+    std::vector<float> column1 = testRecorder.ReadColumn(1);
+    ASSERT_EQ(column0.size(), numSamples);
+    ASSERT_EQ(column1.size(), numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        ASSERT_EQ(column0[i], float(i));
+        ASSERT_EQ(column1[i], -float(i));
+    }
+
+    // Read across a block boundary.
+    std::vector<float> part(10);
+    ASSERT_EQ(testRecorder.Read(0, 4090, part.size(), part.data()), part.size());
+    ASSERT_EQ(part[0], 4090.0);
+    ASSERT_EQ(part[9], 4099.0);
+    ASSERT_EQ(testRecorder.Read(0, numSamples - 2, part.size(), part.data()), 2);
+}
+
+TEST_F(ColumnRecorderTest, test_Append_stops_when_file_can_not_grow) {
+    // Header and one block per column.
+    ASSERT_TRUE(testRecorder.Open(path, std::vector<BG::NES::Simulator::Tools::ColumnSignal>(2), 10));
+
+    // Limit the file size below the first doubling, so that growing fails.
+    struct rlimit oldLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    struct rlimit limit = oldLimit;
+    limit.rlim_cur = 4 * 4096 * sizeof(float);
+    auto oldHandler = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    const size_t numSamples = 10000;
+    for (size_t i = 0; i < numSamples; ++i) {
+        testRecorder.Append(0, float(i));
+        testRecorder.Append(1, -float(i));
+    }
+    setrlimit(RLIMIT_FSIZE, &oldLimit);
+    std::signal(SIGXFSZ, oldHandler);
+
+    // The blocks stored before the failure are still mapped and readable.
+    ASSERT_TRUE(testRecorder.HasFailed());
+    ASSERT_TRUE(testRecorder.IsOpen());
+    std::vector<float> column0 = testRecorder.ReadColumn(0);
+    std::vector<float> column1 = testRecorder.ReadColumn(1);
+    ASSERT_EQ(column0.size(), 4096);
+    ASSERT_EQ(column1.size(), 4096);
+    for (size_t i = 0; i < column0.size(); ++i) {
+        ASSERT_EQ(column0[i], float(i));
+        ASSERT_EQ(column1[i], -float(i));
+    }
+
+    // Appending more samples does not resume the recording.
+    testRecorder.Append(1, 1.0);
+    ASSERT_EQ(testRecorder.NumValues(1), 4096);
+}
+
+TEST_F(ColumnRecorderTest, test_ReserveStep_keeps_columns_aligned_when_file_can_not_grow) {
+    // A time column and a min/max column, which fills its block twice as fast.
+    BG::NES::Simulator::Tools::ColumnSignal minMax;
+    minMax.Mode = BG::NES::Simulator::Tools::DOWNSAMPLE_MINMAX;
+    ASSERT_TRUE(testRecorder.Open(path, { BG::NES::Simulator::Tools::ColumnSignal(), minMax }, 10));
+
+    // Limit the file to the header and one block per column, so that the
+    // min/max column can not get its second block partway through a step.
+    struct rlimit oldLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    struct rlimit limit = oldLimit;
+    limit.rlim_cur = 3 * 4096 * sizeof(float);
+    auto oldHandler = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    size_t numReserved = 0;
+    for (size_t i = 0; i < 3000; ++i) {
+        if (testRecorder.ReserveStep()) {
+            numReserved++;
+        }
+        testRecorder.Append(0, float(i));
+        testRecorder.Append(1, -float(i));
+    }
+    setrlimit(RLIMIT_FSIZE, &oldLimit);
+    std::signal(SIGXFSZ, oldHandler);
+
+    // The steps before the failure are stored whole, none after it.
+    ASSERT_TRUE(testRecorder.HasFailed());
+    ASSERT_EQ(numReserved, 2048);
+    ASSERT_EQ(testRecorder.NumValues(0), 2048);
+    ASSERT_EQ(testRecorder.NumValues(1), 2 * 2048);
+    ASSERT_EQ(testRecorder.ReadColumn(0).back(), 2047.0);
+    ASSERT_EQ(testRecorder.ReadColumn(1).back(), -2047.0);
+}
+
+TEST_F(ColumnRecorderTest, test_Append_decimate) {
+    BG::NES::Simulator::Tools::ColumnSignal signal;
+    signal.Factor = 3;
+    ASSERT_TRUE(testRecorder.Open(path, { signal }, 10));
+
+    for (size_t i = 0; i < 10; ++i) {
+        testRecorder.Append(0, float(i));
+    }
+
+    ASSERT_EQ(testRecorder.ReadColumn(0), std::vector<float>({ 0.0, 3.0, 6.0, 9.0 }));
+}
+
+TEST_F(ColumnRecorderTest, test_Append_minmax) {
+    BG::NES::Simulator::Tools::ColumnSignal signal;
+    signal.Factor = 3;
+    signal.Mode = BG::NES::Simulator::Tools::DOWNSAMPLE_MINMAX;
+    ASSERT_TRUE(testRecorder.Open(path, { signal }, 10));
+
+    std::vector<float> samples = { 1.0, -2.0, 5.0, 0.5, 0.25, 0.75, 9.0 };
+    for (float sample : samples) {
+        testRecorder.Append(0, sample);
+    }
+
+    // The last window is incomplete and not stored.
+    ASSERT_EQ(testRecorder.ReadColumn(0), std::vector<float>({ -2.0, 5.0, 0.25, 0.75 }));
+}
+
+TEST_F(ColumnRecorderTest, test_Resume_continues_after_state) {
+    BG::NES::Simulator::Tools::ColumnSignal signal;
+    signal.Factor = 2;
+    signal.Mode = BG::NES::Simulator::Tools::DOWNSAMPLE_MINMAX;
+    ASSERT_TRUE(testRecorder.Open(path, { BG::NES::Simulator::Tools::ColumnSignal(), signal }, 10));
+
+    // Leave a partially filled window in column 1 and cross a block boundary in column 0.
+    for (size_t i = 0; i < 5001; ++i) {
+        testRecorder.Append(0, float(i));
+        testRecorder.Append(1, float(i % 7));
+    }
+    std::vector<uint64_t> state = testRecorder.GetState();
+    std::vector<float> column0 = testRecorder.ReadColumn(0);
+    std::vector<float> column1 = testRecorder.ReadColumn(1);
+
+    // Values appended after the state are overwritten once resumed.
+    for (size_t i = 0; i < 100; ++i) {
+        testRecorder.Append(0, -1.0);
+        testRecorder.Append(1, -1.0);
+    }
+    testRecorder.Close();
+
+    ASSERT_TRUE(testRecorder.Resume(path, state));
+    ASSERT_EQ(testRecorder.ReadColumn(0), column0);
+    ASSERT_EQ(testRecorder.ReadColumn(1), column1);
+
+    for (size_t i = 5001; i < 5100; ++i) {
+        testRecorder.Append(0, float(i));
+        testRecorder.Append(1, float(i % 7));
+    }
+    std::vector<float> resumed = testRecorder.ReadColumn(0);
+    ASSERT_EQ(resumed.size(), 5100);
+    ASSERT_EQ(resumed[5099], 5099.0);
+    // The window that was partially filled at the state holds { 5000 % 7, 5001 % 7 }.
+    std::vector<float> resumed1 = testRecorder.ReadColumn(1);
+    ASSERT_EQ(resumed1.size(), 5100);
+    ASSERT_EQ(resumed1[5000], 2.0);
+    ASSERT_EQ(resumed1[5001], 3.0);
+}
+
+TEST_F(ColumnRecorderTest, test_Resume_fails_for_mismatched_file) {
+    ASSERT_TRUE(testRecorder.Open(path, std::vector<BG::NES::Simulator::Tools::ColumnSignal>(2), 10));
+    std::vector<uint64_t> state = testRecorder.GetState();
+    state[1] = 3;
+    testRecorder.Close();
+
+    ASSERT_FALSE(testRecorder.Resume(path, state));
+    ASSERT_FALSE(testRecorder.Resume("/nonexistent-directory/recording.bgrec", testRecorder.GetState()));
+    ASSERT_FALSE(testRecorder.IsOpen());
+}
+
+/**
+ * @brief Test class for a simulation that streams its recording to a ColumnRecorder.
+ * Builds the same small chain of neurons twice, one is recorded in memory.
+ */
+struct ColumnRecorderSimulationTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> memorySimulation{};
+    std::unique_ptr<BG::NES::Simulator::Simulation> streamedSimulation{};
+    std::string path;
+
+    const int NumNeurons = 8;
+
+    void BuildNetwork(BG::NES::Simulator::Simulation & sim) {
+        using namespace BG::NES::Simulator;
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere soma(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+            sim.AddSphere(soma);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = i;
+            sim.AddSCCompartment(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { i };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            sim.AddSCNeuron(neuron);
+        }
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Connections::Receptor receptor;
+            receptor.SourceCompartmentID = i;
+            receptor.DestinationCompartmentID = (i + 1) % NumNeurons;
+            receptor.Conductance_nS = 40.0;
+            receptor.TimeConstantRise_ms = 2.0;
+            receptor.TimeConstantDecay_ms = 15.0;
+            std::strcpy(receptor.Neurotransmitter, "AMPA");
+            sim.AddReceptor(receptor);
+        }
+
+        sim.Neurons.at(0)->AddSpecificAPTime(2.0);
+        sim.SetRecordAll(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("ColumnRecorderSimulationTest-" + std::to_string(::getpid()) + ".bgrec")).string();
+
+        memorySimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        BuildNetwork(*memorySimulation);
+
+        streamedSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        BuildNetwork(*streamedSimulation);
+    }
+
+    void TearDown() {
+        streamedSimulation->SetRecordingFile("", BG::NES::Simulator::Tools::ColumnSignal());
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(ColumnRecorderSimulationTest, test_RunFor_streamed_recording_same_as_memory) {
+    streamedSimulation->SetRecordingFile(path, BG::NES::Simulator::Tools::ColumnSignal());
+
+    for (int run = 0; run < 2; run++) {
+        memorySimulation->RunFor(50.0);
+        streamedSimulation->RunFor(50.0);
+    }
+
+    ASSERT_TRUE(streamedSimulation->Recorder.IsOpen());
+    ASSERT_TRUE(streamedSimulation->TRecorded_ms.empty());
+    ASSERT_TRUE(static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(streamedSimulation->Neurons.at(0).get())->VmRecorded_mV.empty());
+    ASSERT_FALSE(memorySimulation->TRecorded_ms.empty());
+    ASSERT_EQ(memorySimulation->GetRecordingJSON(), streamedSimulation->GetRecordingJSON());
+}
@@ -0,0 +1,163 @@
+#include <Simulator/Structs/ModelFile.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Util/CRC32C.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+static uint64_t AlignedOffset(uint64_t _Offset) {
+    return (_Offset + _MODELFILE_ALIGNMENT - 1) / _MODELFILE_ALIGNMENT * _MODELFILE_ALIGNMENT;
+}
+
+void ModelFileWriter::AddSection(ModelSections _ID, const void* _Data, size_t _ElementSize, size_t _Count) {
+    PendingSection Section;
+    Section.Entry.ID = _ID;
+    Section.Entry.ElementSize = _ElementSize;
+    Section.Entry.Count = _Count;
+    Section.Entry.Bytes = _ElementSize * _Count;
+    Section.Entry.Checksum = Util::CRC32C(_Data, Section.Entry.Bytes);
+    Section.Data = _Data;
+    Sections_.emplace_back(Section);
+}
+
+bool ModelFileWriter::Write(const std::string& _Path) const {
+    ModelFileHeader Header;
+    Header.NumSections = Sections_.size();
+
+    // Lay out the sections after the directory.
+    std::vector<ModelFileSection> Directory;
+    uint64_t Offset = sizeof(ModelFileHeader) + Sections_.size() * sizeof(ModelFileSection);
+    for (const PendingSection& Section : Sections_) {
+        Directory.emplace_back(Section.Entry);
+        Offset = AlignedOffset(Offset);
+        Directory.back().Offset = Offset;
+        Offset += Section.Entry.Bytes;
+    }
+    Header.FileSize = Offset;
+
+    std::ofstream SaveFile(_Path, std::ios::out | std::ios::binary | std::ios::trunc);
+    SaveFile.write((char*)&Header, sizeof(Header));
+    SaveFile.write((char*)Directory.data(), sizeof(ModelFileSection) * Directory.size());
+
+    const char Padding[_MODELFILE_ALIGNMENT] = { 0 };
+    uint64_t Position = sizeof(ModelFileHeader) + Directory.size() * sizeof(ModelFileSection);
+    for (size_t s = 0; s < Sections_.size(); s++) {
+        SaveFile.write(Padding, Directory[s].Offset - Position);
+        SaveFile.write((const char*)Sections_[s].Data, Directory[s].Bytes);
+        Position = Directory[s].Offset + Directory[s].Bytes;
+    }
+
+    SaveFile.close();
+    return SaveFile.good();
+}
+
+MappedModelFile::~MappedModelFile() {
+    Close();
+}
+
+bool MappedModelFile::IsModelFile(const std::string& _Path) {
+    std::ifstream File(_Path, std::ios::in | std::ios::binary);
+    ModelFileHeader Header;
+    File.read((char*)&Header, sizeof(Header.Magic));
+    return File.good() && (std::memcmp(Header.Magic, ModelFileHeader().Magic, sizeof(Header.Magic)) == 0);
+}
+
+bool MappedModelFile::Open(const std::string& _Path, Util::WorkerTeam* _Team) {
+    Close();
+
+    FileDescriptor_ = open(_Path.c_str(), O_RDONLY);
+    if (FileDescriptor_ < 0) return false;
+
+    struct stat FileStat;
+    if ((fstat(FileDescriptor_, &FileStat) != 0) || (size_t(FileStat.st_size) < sizeof(ModelFileHeader))) {
+        Close();
+        return false;
+    }
+    void* Map = mmap(nullptr, FileStat.st_size, PROT_READ, MAP_PRIVATE, FileDescriptor_, 0);
+    if (Map == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    Map_ = static_cast<const uint8_t*>(Map);
+    Size_ = FileStat.st_size;
+    // Every section is read in full by the checksum verification.
+    madvise(Map, Size_, MADV_WILLNEED);
+
+    const ModelFileHeader* Header = reinterpret_cast<const ModelFileHeader*>(Map_);
+    if ((std::memcmp(Header->Magic, ModelFileHeader().Magic, sizeof(Header->Magic)) != 0)
+        || (Header->Version != _MODELFILE_VERSION)
+        || (Header->FileSize != Size_)
+        || (Header->NumSections > (Size_ - sizeof(ModelFileHeader)) / sizeof(ModelFileSection))) {
+        Close();
+        return false;
+    }
+
+    const ModelFileSection* Directory = reinterpret_cast<const ModelFileSection*>(Map_ + sizeof(ModelFileHeader));
+    SectionsByID_.assign(NUMMODELSECTIONS, nullptr);
+    for (size_t s = 0; s < Header->NumSections; s++) {
+        const ModelFileSection& Entry = Directory[s];
+        bool Valid = (Entry.ID < NUMMODELSECTIONS)
+            && (Entry.Offset % _MODELFILE_ALIGNMENT == 0)
+            && (Entry.Offset <= Size_) && (Entry.Bytes <= Size_ - Entry.Offset)
+            && (Entry.Bytes == uint64_t(Entry.ElementSize) * Entry.Count);
+        if (!Valid) {
+            Close();
+            return false;
+        }
+        SectionsByID_[Entry.ID] = &Entry;
+    }
+
+    // Sections are handed out one at a time, so that a large section does
+    // not hold up the members with small ones.
+    std::atomic<size_t> NextSection{0};
+    std::atomic<bool> ChecksumsMatch{true};
+    auto VerifySections = [&](size_t) {
+        for (size_t s = NextSection++; (s < Header->NumSections) && ChecksumsMatch; s = NextSection++) {
+            if (Util::CRC32C(Map_ + Directory[s].Offset, Directory[s].Bytes) != Directory[s].Checksum) {
+                ChecksumsMatch = false;
+            }
+        }
+    };
+    if (_Team != nullptr) {
+        _Team->Run(VerifySections);
+    } else {
+        VerifySections(0);
+    }
+    if (!ChecksumsMatch) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedModelFile::Close() {
+    if (Map_ != nullptr) {
+        munmap(const_cast<uint8_t*>(Map_), Size_);
+        Map_ = nullptr;
+    }
+    if (FileDescriptor_ >= 0) {
+        close(FileDescriptor_);
+        FileDescriptor_ = -1;
+    }
+    Size_ = 0;
+    SectionsByID_.clear();
+}
+
+const ModelFileSection* MappedModelFile::Find(ModelSections _ID) const {
+    if (size_t(_ID) >= SectionsByID_.size()) return nullptr;
+    return SectionsByID_[_ID];
+}
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
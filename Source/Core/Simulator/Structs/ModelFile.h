@@ -0,0 +1,161 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the versioned model file format written by SaveModel and
+                 memory-mapped by LoadModel.
+    Additional Notes: A header is followed by a directory of sections, each section is an array
+                      of fixed-size POD elements at an aligned offset, so that a loader can use
+                      the arrays in place in the mapping instead of reading records one by one.
+                      Every section carries a CRC32C, so corrupt files are rejected before use.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Util/WorkerTeam.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+//! Version of the model file layout, incremented when the layout of the
+//! header, the directory or any section element changes.
+#define _MODELFILE_VERSION 2
+//! Alignment in bytes of every section in the file.
+#define _MODELFILE_ALIGNMENT 64
+
+//! Sections of a model file. Flat data sections hold variable size
+//! buffers back to back at 8 byte aligned positions, listed by the
+//! matching offsets section (one uint64_t per buffer, then the end).
+enum ModelSections {
+    MODELSECTION_GEOMETRY_MAP,
+    MODELSECTION_SPHERES,
+    MODELSECTION_CYLINDERS,
+    MODELSECTION_BOXES,
+    MODELSECTION_COMPARTMENTS,
+    MODELSECTION_RECEPTORS,
+    MODELSECTION_REGIONS,
+    MODELSECTION_NEURON_OFFSETS,
+    MODELSECTION_NEURON_DATA,
+    MODELSECTION_CIRCUIT_OFFSETS,
+    MODELSECTION_CIRCUIT_DATA,
+    NUMMODELSECTIONS
+};
+
+//! Layout of the start of the file.
+struct ModelFileHeader {
+    char Magic[8] = { 'B', 'G', 'N', 'E', 'S', 'M', 'D', 'L' };
+    uint32_t Version = _MODELFILE_VERSION;
+    uint32_t NumSections = 0;
+    uint64_t FileSize = 0;
+};
+
+//! Directory entry of a section, the directory follows the header.
+struct ModelFileSection {
+    uint32_t ID = NUMMODELSECTIONS; /**One of ModelSections*/
+    uint32_t ElementSize = 0;       /**sizeof() the element type, checked when loading*/
+    uint64_t Count = 0;             /**Number of elements*/
+    uint64_t Offset = 0;            /**From the start of the file, a multiple of _MODELFILE_ALIGNMENT*/
+    uint64_t Bytes = 0;             /**ElementSize * Count*/
+    uint32_t Checksum = 0;          /**CRC32C of the Bytes bytes at Offset*/
+    uint32_t Reserved = 0;
+};
+
+/**
+ * @brief Collects arrays and writes them as sections of a model file.
+ *
+ * The arrays are referenced, not copied, so they must stay valid until
+ * Write() returns. Each section is written with a single call.
+ */
+class ModelFileWriter {
+public:
+    void AddSection(ModelSections _ID, const void* _Data, size_t _ElementSize, size_t _Count);
+
+    template <typename T>
+    void AddArray(ModelSections _ID, const std::vector<T>& _Array) {
+        AddSection(_ID, _Array.data(), sizeof(T), _Array.size());
+    }
+
+    //! Writes the file, returns false if it could not be written completely.
+    bool Write(const std::string& _Path) const;
+
+private:
+    struct PendingSection {
+        ModelFileSection Entry;
+        const void* Data = nullptr;
+    };
+    std::vector<PendingSection> Sections_;
+};
+
+/**
+ * @brief Read-only memory mapping of a model file, its sections are
+ * consumed in place.
+ *
+ */
+class MappedModelFile {
+public:
+    MappedModelFile() = default;
+    ~MappedModelFile();
+
+    MappedModelFile(const MappedModelFile&) = delete;
+    MappedModelFile& operator=(const MappedModelFile&) = delete;
+
+    //! Tells if the file at _Path starts with the magic of this format.
+    static bool IsModelFile(const std::string& _Path);
+
+    /**
+     * @brief Maps the file at _Path and validates the header, the directory
+     * and the checksums of all sections.
+     *
+     * @param _Path File to map.
+     * @param _Team If given, sections are verified concurrently by its members.
+     * @return true on success, false if the file can not be mapped, has a
+     * different version, a section lies outside of the file or does not
+     * match its checksum.
+     */
+    bool Open(const std::string& _Path, Util::WorkerTeam* _Team = nullptr);
+
+    void Close();
+
+    bool IsOpen() const { return Map_ != nullptr; }
+
+    /**
+     * @brief Returns the elements of a section and sets _Count to their
+     * number.
+     *
+     * @return nullptr with _Count 0 if the section is missing, empty or has
+     * elements of a different size than T.
+     */
+    template <typename T>
+    const T* Array(ModelSections _ID, size_t& _Count) const {
+        const ModelFileSection* Entry = Find(_ID);
+        _Count = 0;
+        if ((Entry == nullptr) || (Entry->ElementSize != sizeof(T)) || (Entry->Count == 0)) return nullptr;
+        _Count = Entry->Count;
+        return reinterpret_cast<const T*>(Map_ + Entry->Offset);
+    }
+
+private:
+    const ModelFileSection* Find(ModelSections _ID) const;
+
+    int FileDescriptor_ = -1;
+    const uint8_t* Map_ = nullptr;
+    size_t Size_ = 0;
+    std::vector<const ModelFileSection*> SectionsByID_;
+};
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
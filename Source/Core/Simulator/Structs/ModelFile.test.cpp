@@ -0,0 +1,212 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the model file format.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/ModelFile.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Util/CRC32C.h>
+
+
+/**
+ * @brief Test class for unit tests for the ModelFileWriter and MappedModelFile classes.
+ *
+ */
+struct ModelFileTest : testing::Test {
+    BG::NES::Simulator::MappedModelFile testFile;
+    std::string path;
+
+    std::vector<float> floats = { 1.0, 2.0, 3.0 };
+    std::vector<uint64_t> offsets = { 0, 8, 24 };
+    std::vector<uint8_t> bytes = { 1, 2, 3, 4, 5 };
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("ModelFileTest-" + std::to_string(::getpid()) + ".nesmodel")).string();
+
+        BG::NES::Simulator::ModelFileWriter writer;
+        writer.AddArray(BG::NES::Simulator::MODELSECTION_SPHERES, floats);
+        writer.AddArray(BG::NES::Simulator::MODELSECTION_NEURON_DATA, bytes);
+        writer.AddArray(BG::NES::Simulator::MODELSECTION_NEURON_OFFSETS, offsets);
+        ASSERT_TRUE(writer.Write(path));
+    }
+
+    void TearDown() {
+        testFile.Close();
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(ModelFileTest, test_Open_sections_aligned_in_place) {
+    ASSERT_TRUE(BG::NES::Simulator::MappedModelFile::IsModelFile(path));
+    ASSERT_TRUE(testFile.Open(path));
+
+    size_t count = 0;
+    const float* mappedFloats = testFile.Array<float>(BG::NES::Simulator::MODELSECTION_SPHERES, count);
+    ASSERT_EQ(std::vector<float>(mappedFloats, mappedFloats + count), floats);
+
+    const uint8_t* mappedBytes = testFile.Array<uint8_t>(BG::NES::Simulator::MODELSECTION_NEURON_DATA, count);
+    ASSERT_EQ(std::vector<uint8_t>(mappedBytes, mappedBytes + count), bytes);
+
+    const uint64_t* mappedOffsets = testFile.Array<uint64_t>(BG::NES::Simulator::MODELSECTION_NEURON_OFFSETS, count);
+    ASSERT_EQ(std::vector<uint64_t>(mappedOffsets, mappedOffsets + count), offsets);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(mappedOffsets) % _MODELFILE_ALIGNMENT, 0);
+}
+
+TEST_F(ModelFileTest, test_Array_missing_or_other_element_size) {
+    ASSERT_TRUE(testFile.Open(path));
+
+    size_t count = 1;
+    ASSERT_EQ(testFile.Array<float>(BG::NES::Simulator::MODELSECTION_BOXES, count), nullptr);
+    ASSERT_EQ(count, 0);
+    ASSERT_EQ(testFile.Array<double>(BG::NES::Simulator::MODELSECTION_SPHERES, count), nullptr);
+}
+
+TEST_F(ModelFileTest, test_Open_fails_for_truncated_file) {
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_FALSE(testFile.Open(path));
+    ASSERT_FALSE(testFile.IsOpen());
+}
+
+TEST_F(ModelFileTest, test_Open_fails_for_other_version) {
+    BG::NES::Simulator::ModelFileHeader header;
+    header.Version = _MODELFILE_VERSION + 1;
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.write((char*)&header, sizeof(header.Magic) + sizeof(header.Version));
+    file.close();
+
+    ASSERT_TRUE(BG::NES::Simulator::MappedModelFile::IsModelFile(path));
+    ASSERT_FALSE(testFile.Open(path));
+}
+
+TEST_F(ModelFileTest, test_Open_fails_for_corrupted_section) {
+    // Flip a bit in the last byte of the file, which belongs to the last section.
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(-1, std::ios::end);
+    char last = file.get();
+    file.seekp(-1, std::ios::end);
+    file.put(last ^ 1);
+    file.close();
+
+    ASSERT_FALSE(testFile.Open(path));
+}
+
+TEST_F(ModelFileTest, test_Open_verifies_with_team) {
+    BG::NES::Util::WorkerTeam team(3);
+    ASSERT_TRUE(testFile.Open(path, &team));
+}
+
+/**
+ * @brief Test class for unit tests for saving and loading a Simulation model file.
+ *
+ */
+struct ModelFileSimulationTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> testSimulation{};
+    std::string path;
+
+    const int NumNeurons = 8;
+
+    // The stimulation and recording are not part of the model.
+    void Stimulate(BG::NES::Simulator::Simulation & sim) {
+        sim.Neurons.at(0)->AddSpecificAPTime(2.0);
+        sim.Neurons.at(5)->AddSpecificAPTime(40.0);
+        sim.SetRecordAll(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    void SetUp() {
+        using namespace BG::NES::Simulator;
+        path = (std::filesystem::temp_directory_path() / ("ModelFileSimulationTest-" + std::to_string(::getpid()) + ".nesmodel")).string();
+
+        testSimulation = std::make_unique<Simulation>(&Logger);
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere soma(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+            testSimulation->AddSphere(soma);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = i;
+            testSimulation->AddSCCompartment(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { i };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            testSimulation->AddSCNeuron(neuron);
+        }
+
+        for (int i = 0; i < NumNeurons; i++) {
+            for (int Offset : { 1, 3 }) {
+                Connections::Receptor receptor;
+                receptor.SourceCompartmentID = i;
+                receptor.DestinationCompartmentID = (i + Offset) % NumNeurons;
+                receptor.Conductance_nS = 30.0 + 5.0 * (i % 4);
+                receptor.TimeConstantRise_ms = 2.0;
+                receptor.TimeConstantDecay_ms = 15.0;
+                std::strcpy(receptor.Neurotransmitter, "AMPA");
+                testSimulation->AddReceptor(receptor);
+            }
+        }
+    }
+
+    void TearDown() {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(ModelFileSimulationTest, test_LoadModel_same_as_saved) {
+    using namespace BG::NES::Simulator;
+    ASSERT_TRUE(testSimulation->SaveModel(path));
+
+    auto loadedSimulation = std::make_unique<Simulation>(&Logger);
+    ASSERT_TRUE(loadedSimulation->LoadModel(path));
+    ASSERT_EQ(loadedSimulation->Collection.Size(), testSimulation->Collection.Size());
+    ASSERT_EQ(loadedSimulation->BSCompartments.size(), testSimulation->BSCompartments.size());
+    ASSERT_EQ(loadedSimulation->Neurons.size(), testSimulation->Neurons.size());
+    ASSERT_EQ(loadedSimulation->Receptors.size(), testSimulation->Receptors.size());
+    ASSERT_EQ(loadedSimulation->GetSomaPositionsJSON(), testSimulation->GetSomaPositionsJSON());
+    ASSERT_EQ(loadedSimulation->GetConnectomeJSON(), testSimulation->GetConnectomeJSON());
+
+    // The loaded model behaves the same once stimulated in the same way.
+    Stimulate(*testSimulation);
+    Stimulate(*loadedSimulation);
+    loadedSimulation->RunFor(100.0);
+    testSimulation->RunFor(100.0);
+    ASSERT_GT(testSimulation->TotalSpikes(), 0);
+    ASSERT_EQ(loadedSimulation->GetRecordingJSON(), testSimulation->GetRecordingJSON());
+}
+
+TEST(CRC32CTest, test_CRC32C_known_answer) {
+    ASSERT_EQ(BG::NES::Util::CRC32C("123456789", 9), 0xE3069283);
+    ASSERT_EQ(BG::NES::Util::CRC32C("", 0), 0);
+
+    // Checksumming in parts gives the same result.
+    std::string text = "The quick brown fox jumps over the lazy dog";
+    ASSERT_EQ(BG::NES::Util::CRC32C(text.data() + 5, text.size() - 5, BG::NES::Util::CRC32C(text.data(), 5)), BG::NES::Util::CRC32C(text.data(), text.size()));
+}
@@ -10,7 +10,7 @@ RecordingElectrode::RecordingElectrode(RecordingElectrode & _Electrode
     ): Name(_Electrode.Name), ID(_Electrode.ID), TipPosition_um(_Electrode.TipPosition_um),
        EndPosition_um(_Electrode.EndPosition_um),
        Sites(_Electrode.Sites), SiteLocations_um(_Electrode.SiteLocations_um), NoiseLevel(_Electrode.NoiseLevel),
-       SensitivityDampening(_Electrode.SensitivityDampening), Sim(_Electrode.Sim) {
+       SensitivityDampening(_Electrode.SensitivityDampening), DistanceCutoff_um(_Electrode.DistanceCutoff_um), Sim(_Electrode.Sim) {
     assert(Sim != nullptr);
     this->InitSystemCoordSiteLocations();
     this->InitNeuronReferencesAndDistances();
@@ -75,6 +75,30 @@ void RecordingElectrode::InitNeuronReferencesAndDistances() {
         }
         this->NeuronSomaToSiteDistances_um2.emplace_back(siteDistancesSq_um2);
     }
+    this->InitSiteWeights();
+};
+
+//! Precomputes the weight of every neuron within DistanceCutoff_um of a site,
+//! so that recording a site is a sparse dot product with the neuron Vm.
+void RecordingElectrode::InitSiteWeights() {
+    this->SiteWeightOffset.assign(1, 0);
+    this->SiteWeightNeuron.clear();
+    this->SiteWeight.clear();
+
+    float cutoffSq_um2 = this->DistanceCutoff_um * this->DistanceCutoff_um;
+    for (const auto &siteDistancesSq_um2 : this->NeuronSomaToSiteDistances_um2) {
+        for (size_t i = 0; i < siteDistancesSq_um2.size(); ++i) {
+            float distSq_um2 = siteDistancesSq_um2[i];
+            if ((this->DistanceCutoff_um > 0.0) && (distSq_um2 > cutoffSq_um2)) continue;
+
+            float weight = (distSq_um2 <= 1.0) ? 1.0 : 1.0 / distSq_um2;
+            this->SiteWeightNeuron.emplace_back(uint32_t(i));
+            this->SiteWeight.emplace_back(weight);
+        }
+        this->SiteWeightOffset.emplace_back(this->SiteWeight.size());
+    }
+
+    this->NoiseGen.seed(uint32_t(this->Sim->RandomSeed) ^ (uint32_t(this->ID) * 0x9E3779B9u));
 };
 
 void RecordingElectrode::InitRecords() {
@@ -84,29 +108,48 @@ void RecordingElectrode::InitRecords() {
 };
 
 float RecordingElectrode::AddNoise() {
-    return this->NoiseLevel * ((rand() % 100) / 100.0 - 0.5);
+    std::uniform_real_distribution<float> noiseDist(-0.5, 0.5);
+    return this->NoiseLevel * noiseDist(this->NoiseGen);
 };
 
 //! Calculate the electric field potential at the electrode site as
 //! a combination of the effects of nearby neurons.
 float RecordingElectrode::ElectricFieldPotential(size_t siteIdx) {
+    std::vector<float> Vm_mV(this->Neurons.size());
+    for (size_t i = 0; i < this->Neurons.size(); ++i) {
+        Vm_mV[i] = static_cast<BallAndStick::BSNeuron*>(this->Neurons[i].get())->Vm_mV;
+    }
+    return this->ElectricFieldPotential(siteIdx, Vm_mV.data());
+};
+
+//! Each neuron contributes Vm / (d^2 * SensitivityDampening), or
+//! Vm / SensitivityDampening within 1 um of the site, with the 1 / d^2
+//! weights precomputed by InitSiteWeights().
+float RecordingElectrode::ElectricFieldPotential(size_t siteIdx, const float* _Vm_mV) {
     if (this->SensitivityDampening == 0.0)
         throw std::overflow_error(
             "Cannot divide by zero. (SensitivityDampening)");
     if (siteIdx >= this->NeuronSomaToSiteDistances_um2.size())
         throw std::out_of_range("Out of bounds. (siteIdx)");
 
-    float Ei_mV = 0.0;
-    auto siteDistances_um = this->NeuronSomaToSiteDistances_um2[siteIdx];
-
-    for (size_t i = 0; i < this->Neurons.size(); ++i) {
-        float Vm_mV = std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSNeuron>
-            (this->Neurons[i])->Vm_mV;
-
-        float Ei_n_mV = (siteDistances_um[i] <= 1.0) ? Vm_mV : Vm_mV / siteDistances_um[i];
-        Ei_mV += (Ei_n_mV / this->SensitivityDampening);
+    const uint32_t* neuronIdx = this->SiteWeightNeuron.data();
+    const float* weight = this->SiteWeight.data();
+    size_t begin = this->SiteWeightOffset[siteIdx];
+    size_t end = this->SiteWeightOffset[siteIdx + 1];
+
+    // Independent partial sums let the compiler vectorize the gathers.
+    float partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+    size_t k = begin;
+    for (; k + 4 <= end; k += 4) {
+        for (size_t l = 0; l < 4; ++l) {
+            partial[l] += weight[k + l] * _Vm_mV[neuronIdx[k + l]];
+        }
+    }
+    for (; k < end; ++k) {
+        partial[0] += weight[k] * _Vm_mV[neuronIdx[k]];
     }
 
+    float Ei_mV = ((partial[0] + partial[1]) + (partial[2] + partial[3])) / this->SensitivityDampening;
     Ei_mV += this->AddNoise();
 
     return Ei_mV;
@@ -121,6 +164,15 @@ void RecordingElectrode::Record(float t_ms) {
     }
 };
 
+void RecordingElectrode::Record(float t_ms, const float* _Vm_mV) {
+    assert(t_ms >= 0.0);
+    this->TRecorded_ms.emplace_back(t_ms);
+    for (size_t i = 0; i < this->SiteLocations_um.size(); ++i) {
+        float Ei_mV = this->ElectricFieldPotential(i, _Vm_mV);
+        (this->E_mV[i]).emplace_back(Ei_mV);
+    }
+};
+
 std::unordered_map<std::string, std::vector<std::vector<float>>>
 RecordingElectrode::GetRecording() {
     std::unordered_map<std::string, std::vector<std::vector<float>>> data{};
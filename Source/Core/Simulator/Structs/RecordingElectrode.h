@@ -12,6 +12,7 @@
 
 // Standard Libraries (BG convention: use <> instead of "")
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
@@ -41,7 +42,7 @@ namespace Tools {
 struct RecordingElectrode {
 
     std::string Name;
-    int ID;
+    int ID = 0;
 
     Geometries::Vec3D TipPosition_um{0.0, 0.0, 0.0};
     Geometries::Vec3D EndPosition_um{0.0, 0.0, 5.0f};
@@ -50,11 +51,21 @@ struct RecordingElectrode {
 
     float NoiseLevel = 1.0;
     float SensitivityDampening = 2.0;
+    float DistanceCutoff_um = 0.0; //! Neurons farther than this from a site do not contribute to it, 0 means no cutoff.
 
     Simulator::Simulation* Sim;
     std::vector<Geometries::Vec3D> SiteLocations{}; //! In Simulation coordinate system
     std::vector<std::shared_ptr<CoreStructs::Neuron>> Neurons{};
     std::vector<std::vector<float>> NeuronSomaToSiteDistances_um2{}; //!  [ (d_s1n1, d_s1n2, ...), (d_s2n1, d_s2n2, ...), ...]
+
+    //! Sparse site x neuron weight matrix in compressed sparse row form,
+    //! site s sums SiteWeight[k] * Vm[SiteWeightNeuron[k]] over k in
+    //! [SiteWeightOffset[s], SiteWeightOffset[s + 1]). Neuron indices are
+    //! indices into Neurons, which are the same as in Simulation::Neurons.
+    std::vector<size_t> SiteWeightOffset{};
+    std::vector<uint32_t> SiteWeightNeuron{};
+    std::vector<float> SiteWeight{};
+    std::mt19937 NoiseGen{}; //! Noise generator, seeded from the simulation seed and the electrode ID.
     std::vector<float> TRecorded_ms{};   //! [ t0, t1, ... ]
     std::vector<std::vector<float>> E_mV{}; //! [ [E1(t0), E1(t1), ...], [E2(t0), E2(t1), ...], ...]
 
@@ -76,13 +87,18 @@ struct RecordingElectrode {
 
     void InitSystemCoordSiteLocations();
     void InitNeuronReferencesAndDistances();
+    void InitSiteWeights();
     void InitRecords();
     float AddNoise();
 
     //! Calculate the electric field potential at the electrode site as
     //! a combination of the effects of nearby neurons.
     float ElectricFieldPotential(size_t siteIdx);
+    //! Same, reading the membrane potentials from a contiguous array with
+    //! one entry per neuron in Neurons.
+    float ElectricFieldPotential(size_t siteIdx, const float* _Vm_mV);
     void Record(float t_ms);
+    void Record(float t_ms, const float* _Vm_mV);
     std::unordered_map<std::string, std::vector<std::vector<float>>> GetRecording();
     nlohmann::json GetRecordingJSON() const;
 };
@@ -7,9 +7,11 @@
    struct. Additional Notes: None Date Created: 2023-10-13
 */
 
+#include <BG/Common/Logger/Logger.h>
 #include <Simulator/BallAndStick/BSAlignedBrainRegion.h>
 #include <Simulator/BallAndStick/BSAlignedNC.h>
 #include <Simulator/Geometries/Box.h>
+#include <Simulator/Geometries/Sphere.h>
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
@@ -17,6 +19,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -163,3 +166,97 @@ TEST_F(RecordingElectrodeTest, test_GetRecording_default) {
         ASSERT_EQ(E_mVVec.size(), 3);
     }
 }
+
+/**
+ * @brief Test class for electrodes recorded during RunFor.
+ * Builds the same row of neurons for the list-of-neurons and the neuron
+ * arrays method, with an electrode that is within reach of only some of them.
+ */
+struct RecordingElectrodeSimulationTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> listSimulation{};
+    std::unique_ptr<BG::NES::Simulator::Simulation> arraysSimulation{};
+
+    const int NumNeurons = 6;
+
+    void BuildNetwork(BG::NES::Simulator::Simulation & sim) {
+        using namespace BG::NES::Simulator;
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere soma(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+            sim.AddSphere(soma);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = i;
+            sim.AddSCCompartment(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { i };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            sim.AddSCNeuron(neuron);
+        }
+
+        for (int i = 0; i + 1 < NumNeurons; i++) {
+            Connections::Receptor receptor;
+            receptor.SourceCompartmentID = i;
+            receptor.DestinationCompartmentID = i + 1;
+            receptor.Conductance_nS = 40.0;
+            receptor.TimeConstantRise_ms = 2.0;
+            receptor.TimeConstantDecay_ms = 15.0;
+            std::strcpy(receptor.Neurotransmitter, "AMPA");
+            sim.AddReceptor(receptor);
+        }
+
+        sim.Neurons.at(0)->AddSpecificAPTime(2.0);
+
+        Tools::RecordingElectrode E(&sim);
+        E.Name = "Electrode";
+        E.TipPosition_um = Geometries::Vec3D(25.0, 3.0, 0.0);
+        E.EndPosition_um = Geometries::Vec3D(25.0, 3.0, 10.0);
+        E.Sites = { Geometries::Vec3D(0.0, 0.0, 0.0), Geometries::Vec3D(0.0, 0.0, 1.0) };
+        E.NoiseLevel = 0.0;
+        E.DistanceCutoff_um = 20.0;
+        sim.RecordingElectrodes.push_back(std::make_unique<Tools::RecordingElectrode>(E));
+        sim.SetRecordInstruments(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    void SetUp() {
+        listSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        listSimulation->SimulationMethod = BG::NES::Simulator::SIMMETHOD_LIST_OF_NEURONS;
+        BuildNetwork(*listSimulation);
+
+        arraysSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        arraysSimulation->SimulationMethod = BG::NES::Simulator::SIMMETHOD_NEURON_ARRAYS;
+        BuildNetwork(*arraysSimulation);
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(RecordingElectrodeSimulationTest, test_RunFor_electrode_same_as_list_of_neurons) {
+    listSimulation->RunFor(50.0);
+    arraysSimulation->RunFor(50.0);
+
+    auto & listElectrode = listSimulation->RecordingElectrodes.at(0);
+    auto & arraysElectrode = arraysSimulation->RecordingElectrodes.at(0);
+
+    // Only the four neurons within the cutoff contribute to each site.
+    ASSERT_EQ(arraysElectrode->SiteWeightOffset, std::vector<size_t>({ 0, 4, 8 }));
+    ASSERT_EQ(arraysElectrode->SiteWeightNeuron, std::vector<uint32_t>({ 1, 2, 3, 4, 1, 2, 3, 4 }));
+    ASSERT_EQ(listElectrode->E_mV, arraysElectrode->E_mV);
+
+    float expectedE_mV = 0.0;
+    for (int i = 1; i <= 4; i++) {
+        float Vm_mV = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(arraysSimulation->Neurons.at(i).get())->Vm_mV;
+        expectedE_mV += Vm_mV / arraysElectrode->NeuronSomaToSiteDistances_um2.at(0).at(i) / arraysElectrode->SensitivityDampening;
+    }
+    ASSERT_NEAR(arraysElectrode->E_mV.at(0).back(), expectedE_mV, 1e-4);
+}
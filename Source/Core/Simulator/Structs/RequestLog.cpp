@@ -0,0 +1,342 @@
+#include <Simulator/Structs/RequestLog.h>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include <Util/CRC32C.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+//! Route ID (uint16_t) and payload length (uint32_t) in front of each payload.
+static constexpr size_t RecordHeaderBytes = sizeof(uint16_t) + sizeof(uint32_t);
+
+/**
+ * Calls _Function(RouteID, Failed, Payload, PayloadBytes, RecordOffset, RecordBytes)
+ * for every record in _Records, returns false if the records do not end
+ * exactly at the end of _Records.
+ */
+template <typename F>
+static bool WalkRecords(const std::vector<uint8_t>& _Records, F _Function) {
+    size_t Offset = 0;
+    while (Offset < _Records.size()) {
+        if (_Records.size() - Offset < RecordHeaderBytes) return false;
+        uint16_t RouteID;
+        uint32_t PayloadBytes;
+        std::memcpy(&RouteID, _Records.data() + Offset, sizeof(RouteID));
+        std::memcpy(&PayloadBytes, _Records.data() + Offset + sizeof(RouteID), sizeof(PayloadBytes));
+        if (_Records.size() - Offset - RecordHeaderBytes < PayloadBytes) return false;
+        bool Failed = (RouteID & _REQUESTLOG_FAILED_FLAG) != 0;
+        _Function(uint16_t(RouteID & ~_REQUESTLOG_FAILED_FLAG), Failed, _Records.data() + Offset + RecordHeaderBytes, PayloadBytes, Offset, RecordHeaderBytes + PayloadBytes);
+        Offset += RecordHeaderBytes + PayloadBytes;
+    }
+    return true;
+}
+
+uint16_t RequestLog::RouteID(const std::string& _Route) {
+    auto it = RouteIDs_.find(_Route);
+    if (it != RouteIDs_.end()) {
+        return it->second;
+    }
+    assert(Routes_.size() < _REQUESTLOG_FAILED_FLAG);
+    uint16_t ID = Routes_.size();
+    Routes_.emplace_back(_Route);
+    RouteIDs_.emplace(_Route, ID);
+    return ID;
+}
+
+void RequestLog::AppendRecord(std::vector<uint8_t>& _Records, uint16_t _RouteID, const nlohmann::json& _Request, bool _Succeeded) {
+    // The payload is encoded directly behind its header, whose length is filled in afterwards.
+    size_t Start = _Records.size();
+    _Records.resize(Start + RecordHeaderBytes);
+    nlohmann::json::to_msgpack(_Request, _Records);
+    uint32_t PayloadBytes = _Records.size() - Start - RecordHeaderBytes;
+    if (!_Succeeded) {
+        _RouteID |= _REQUESTLOG_FAILED_FLAG;
+    }
+    std::memcpy(_Records.data() + Start, &_RouteID, sizeof(_RouteID));
+    std::memcpy(_Records.data() + Start + sizeof(_RouteID), &PayloadBytes, sizeof(PayloadBytes));
+}
+
+void RequestLog::Append(const std::string& _Route, const nlohmann::json& _Request, bool _Succeeded) {
+    AppendRecord(Records_, RouteID(_Route), _Request, _Succeeded);
+    NumRecords_++;
+}
+
+void RequestLog::Clear() {
+    Routes_.clear();
+    RouteIDs_.clear();
+    Records_.clear();
+    NumRecords_ = 0;
+}
+
+void RequestLog::ForEach(const Visitor& _Visitor) const {
+    WalkRecords(Records_, [&](uint16_t _RouteID, bool, const uint8_t* _Payload, uint32_t _PayloadBytes, size_t, size_t) {
+        nlohmann::json Request = nlohmann::json::from_msgpack(_Payload, _Payload + _PayloadBytes);
+        _Visitor(Routes_[_RouteID], Request);
+    });
+}
+
+
+// -- Compaction -- //
+
+enum PackedFieldTypes { PACKED_INT32, PACKED_FLOAT32 };
+
+struct PackedField {
+    const char* Name;
+    PackedFieldTypes Type;
+};
+
+//! A single create route and the bulk create route that takes the same
+//! fields as packed records (see the BulkCreate handlers).
+struct BulkCreateRule {
+    const char* SingleRoute;
+    const char* BulkRoute;
+    std::vector<PackedField> Fields;
+    const char* SharedPar; /**Parameter that all requests of a bulk request must have in common, or nullptr*/
+};
+
+static const std::vector<BulkCreateRule>& BulkCreateRules() {
+    static const std::vector<BulkCreateRule> Rules = {
+        { "Simulation/Geometry/Sphere/Create", "Simulation/Geometry/Sphere/BulkCreate", {
+            { "Radius_um", PACKED_FLOAT32 },
+            { "CenterPosX_um", PACKED_FLOAT32 }, { "CenterPosY_um", PACKED_FLOAT32 }, { "CenterPosZ_um", PACKED_FLOAT32 },
+        }, nullptr },
+        { "Simulation/Geometry/Cylinder/Create", "Simulation/Geometry/Cylinder/BulkCreate", {
+            { "Point1Radius_um", PACKED_FLOAT32 },
+            { "Point1PosX_um", PACKED_FLOAT32 }, { "Point1PosY_um", PACKED_FLOAT32 }, { "Point1PosZ_um", PACKED_FLOAT32 },
+            { "Point2Radius_um", PACKED_FLOAT32 },
+            { "Point2PosX_um", PACKED_FLOAT32 }, { "Point2PosY_um", PACKED_FLOAT32 }, { "Point2PosZ_um", PACKED_FLOAT32 },
+        }, nullptr },
+        { "Simulation/Geometry/Box/Create", "Simulation/Geometry/Box/BulkCreate", {
+            { "CenterPosX_um", PACKED_FLOAT32 }, { "CenterPosY_um", PACKED_FLOAT32 }, { "CenterPosZ_um", PACKED_FLOAT32 },
+            { "ScaleX_um", PACKED_FLOAT32 }, { "ScaleY_um", PACKED_FLOAT32 }, { "ScaleZ_um", PACKED_FLOAT32 },
+            { "RotationX_rad", PACKED_FLOAT32 }, { "RotationY_rad", PACKED_FLOAT32 }, { "RotationZ_rad", PACKED_FLOAT32 },
+        }, nullptr },
+        { "Simulation/Compartments/BS/Create", "Simulation/Compartments/BS/BulkCreate", {
+            { "ShapeID", PACKED_INT32 },
+            { "MembranePotential_mV", PACKED_FLOAT32 },
+            { "SpikeThreshold_mV", PACKED_FLOAT32 },
+            { "DecayTime_ms", PACKED_FLOAT32 },
+            { "RestingPotential_mV", PACKED_FLOAT32 },
+            { "AfterHyperpolarizationAmplitude_mV", PACKED_FLOAT32 },
+        }, nullptr },
+        { "Simulation/Receptor/Create", "Simulation/Receptor/BulkCreate", {
+            { "SourceCompartmentID", PACKED_INT32 },
+            { "DestinationCompartmentID", PACKED_INT32 },
+            { "ReceptorMorphology", PACKED_INT32 },
+            { "Conductance_nS", PACKED_FLOAT32 },
+            { "TimeConstantRise_ms", PACKED_FLOAT32 },
+            { "TimeConstantDecay_ms", PACKED_FLOAT32 },
+        }, "Neurotransmitter" },
+    };
+    return Rules;
+}
+
+static void PutUInt32(std::vector<uint8_t>& _Bytes, uint32_t _Value) {
+    _Bytes.push_back(_Value & 0xff);
+    _Bytes.push_back((_Value >> 8) & 0xff);
+    _Bytes.push_back((_Value >> 16) & 0xff);
+    _Bytes.push_back((_Value >> 24) & 0xff);
+}
+
+//! Appends the fields of _Request to _Bytes as a little-endian record,
+//! leaves _Bytes unchanged and returns false if a field is missing.
+static bool PackRecord(const BulkCreateRule& _Rule, const nlohmann::json& _Request, std::vector<uint8_t>& _Bytes) {
+    for (const PackedField& Field : _Rule.Fields) {
+        auto it = _Request.find(Field.Name);
+        if ((it == _Request.end()) || (!it->is_number())) return false;
+    }
+    for (const PackedField& Field : _Rule.Fields) {
+        const nlohmann::json& Value = _Request[Field.Name];
+        if (Field.Type == PACKED_INT32) {
+            PutUInt32(_Bytes, uint32_t(Value.template get<int32_t>()));
+        } else {
+            float Float = Value.template get<float>();
+            uint32_t Bits;
+            std::memcpy(&Bits, &Float, sizeof(Bits));
+            PutUInt32(_Bytes, Bits);
+        }
+    }
+    return true;
+}
+
+/**
+ * Walks the records once and keeps each run of the same single create route
+ * (with the same shared parameter) open until a record does not fit, then
+ * writes it as one bulk request, or unchanged if it has only one record.
+ */
+size_t RequestLog::Compact() {
+    std::unordered_map<std::string, const BulkCreateRule*> RulesByRoute;
+    for (const BulkCreateRule& Rule : BulkCreateRules()) {
+        RulesByRoute.emplace(Rule.SingleRoute, &Rule);
+    }
+
+    std::vector<uint8_t> Compacted;
+    Compacted.reserve(Records_.size());
+    size_t NumCompacted = 0;
+
+    const BulkCreateRule* RunRule = nullptr;
+    nlohmann::json RunFirst;
+    nlohmann::json RunNames = nlohmann::json::array();
+    std::vector<uint8_t> RunRecords;
+    size_t RunCount = 0;
+    size_t RunFirstOffset = 0;
+    size_t RunFirstBytes = 0;
+
+    auto FlushRun = [&]() {
+        if (RunCount == 1) {
+            Compacted.insert(Compacted.end(), Records_.begin() + RunFirstOffset, Records_.begin() + RunFirstOffset + RunFirstBytes);
+            NumCompacted++;
+        } else if (RunCount > 1) {
+            nlohmann::json BulkRequest;
+            if (RunFirst.contains("SimulationID")) {
+                BulkRequest["SimulationID"] = RunFirst["SimulationID"];
+            }
+            if (RunRule->SharedPar != nullptr) {
+                BulkRequest[RunRule->SharedPar] = RunFirst[RunRule->SharedPar];
+            }
+            BulkRequest["Count"] = RunCount;
+            BulkRequest["Data"] = nlohmann::json::binary(std::move(RunRecords));
+            BulkRequest["Names"] = std::move(RunNames);
+            AppendRecord(Compacted, RouteID(RunRule->BulkRoute), BulkRequest);
+            NumCompacted++;
+        }
+        RunRule = nullptr;
+        RunNames = nlohmann::json::array();
+        RunRecords.clear();
+        RunCount = 0;
+    };
+
+    WalkRecords(Records_, [&](uint16_t _RouteID, bool _Failed, const uint8_t* _Payload, uint32_t _PayloadBytes, size_t _Offset, size_t _Bytes) {
+        auto RuleIt = RulesByRoute.find(Routes_[_RouteID]);
+        if (_Failed || (RuleIt == RulesByRoute.end())) {
+            FlushRun();
+            Compacted.insert(Compacted.end(), Records_.begin() + _Offset, Records_.begin() + _Offset + _Bytes);
+            NumCompacted++;
+            return;
+        }
+        const BulkCreateRule* Rule = RuleIt->second;
+        nlohmann::json Request = nlohmann::json::from_msgpack(_Payload, _Payload + _PayloadBytes);
+
+        auto Name = Request.find("Name");
+        bool Packable = (Name != Request.end()) && Name->is_string()
+            && ((Rule->SharedPar == nullptr) || Request.contains(Rule->SharedPar));
+        bool ContinuesRun = Packable && (Rule == RunRule)
+            && (Request.value("SimulationID", nlohmann::json()) == RunFirst.value("SimulationID", nlohmann::json()))
+            && ((Rule->SharedPar == nullptr) || (Request[Rule->SharedPar] == RunFirst[Rule->SharedPar]));
+        if (!ContinuesRun) {
+            FlushRun();
+        }
+        if (!Packable || !PackRecord(*Rule, Request, RunRecords)) {
+            FlushRun();
+            Compacted.insert(Compacted.end(), Records_.begin() + _Offset, Records_.begin() + _Offset + _Bytes);
+            NumCompacted++;
+            return;
+        }
+        if (RunCount == 0) {
+            RunRule = Rule;
+            RunFirstOffset = _Offset;
+            RunFirstBytes = _Bytes;
+            RunFirst = std::move(Request);
+            RunNames.push_back(RunFirst["Name"]);
+        } else {
+            RunNames.push_back(*Name);
+        }
+        RunCount++;
+    });
+    FlushRun();
+
+    size_t Removed = NumRecords_ - NumCompacted;
+    Compacted.shrink_to_fit();
+    Records_.swap(Compacted);
+    NumRecords_ = NumCompacted;
+    return Removed;
+}
+
+
+// -- Files -- //
+
+bool RequestLog::Save(const std::string& _Path) const {
+    RequestLogHeader Header;
+    Header.NumRoutes = Routes_.size();
+    Header.NumRecords = NumRecords_;
+    Header.RecordBytes = Records_.size();
+    Header.Checksum = Util::CRC32C(Records_.data(), Records_.size());
+
+    std::ofstream SaveFile(_Path, std::ios::out | std::ios::binary | std::ios::trunc);
+    SaveFile.write((const char*)&Header, sizeof(Header));
+    for (const std::string& Route : Routes_) {
+        uint16_t Length = Route.size();
+        SaveFile.write((const char*)&Length, sizeof(Length));
+        SaveFile.write(Route.data(), Length);
+    }
+    SaveFile.write((const char*)Records_.data(), Records_.size());
+
+    SaveFile.close();
+    return SaveFile.good();
+}
+
+bool RequestLog::Load(const std::string& _Path) {
+    Clear();
+
+    std::ifstream LoadFile(_Path, std::ios::in | std::ios::binary);
+    RequestLogHeader Header;
+    LoadFile.read((char*)&Header, sizeof(Header));
+    if ((!LoadFile.good())
+        || (std::memcmp(Header.Magic, RequestLogHeader().Magic, sizeof(Header.Magic)) != 0)
+        || (Header.Version != _REQUESTLOG_VERSION)
+        || (Header.NumRoutes > _REQUESTLOG_FAILED_FLAG)) {
+        return false;
+    }
+
+    for (uint32_t r = 0; r < Header.NumRoutes; r++) {
+        uint16_t Length = 0;
+        LoadFile.read((char*)&Length, sizeof(Length));
+        std::string Route(Length, '\0');
+        LoadFile.read(Route.data(), Length);
+        if (!LoadFile.good()) {
+            Clear();
+            return false;
+        }
+        RouteID(Route);
+    }
+
+    // Reads at most what the file holds, in case RecordBytes is corrupt.
+    std::streampos RecordsStart = LoadFile.tellg();
+    LoadFile.seekg(0, std::ios::end);
+    if (uint64_t(LoadFile.tellg() - RecordsStart) != Header.RecordBytes) {
+        Clear();
+        return false;
+    }
+    LoadFile.seekg(RecordsStart);
+    Records_.resize(Header.RecordBytes);
+    LoadFile.read((char*)Records_.data(), Records_.size());
+
+    size_t NumRecords = 0;
+    bool RouteIDsValid = true;
+    bool Complete = WalkRecords(Records_, [&](uint16_t _RouteID, bool, const uint8_t*, uint32_t, size_t, size_t) {
+        RouteIDsValid = RouteIDsValid && (_RouteID < Routes_.size());
+        NumRecords++;
+    });
+    if ((!LoadFile.good()) || (!Complete) || (!RouteIDsValid) || (NumRecords != Header.NumRecords)
+        || (Util::CRC32C(Records_.data(), Records_.size()) != Header.Checksum)) {
+        Clear();
+        return false;
+    }
+    NumRecords_ = NumRecords;
+    return true;
+}
+
+bool RequestLog::IsRequestLogFile(const std::string& _Path) {
+    std::ifstream File(_Path, std::ios::in | std::ios::binary);
+    RequestLogHeader Header;
+    File.read((char*)&Header, sizeof(Header.Magic));
+    return File.good() && (std::memcmp(Header.Magic, RequestLogHeader().Magic, sizeof(Header.Magic)) == 0);
+}
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
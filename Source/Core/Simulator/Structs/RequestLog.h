@@ -0,0 +1,115 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the log of handled requests that Simulation/Save writes and
+                 Simulation/Load replays.
+    Additional Notes: Each record is a route ID followed by the length and the msgpack encoding of
+                      the request, so routes are stored once per log instead of once per request.
+                      Compact() collapses runs of single create requests into bulk create requests.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+//! Version of the request log file layout.
+#define _REQUESTLOG_VERSION 1
+//! Set in the stored route ID of a record whose request failed, which
+//! leaves 15 bits for the route ID itself.
+#define _REQUESTLOG_FAILED_FLAG 0x8000
+
+//! Layout of the start of a request log file, followed by NumRoutes route
+//! names (uint16_t length, then the characters) and the records.
+struct RequestLogHeader {
+    char Magic[8] = { 'B', 'G', 'N', 'E', 'S', 'R', 'E', 'Q' };
+    uint32_t Version = _REQUESTLOG_VERSION;
+    uint32_t NumRoutes = 0;
+    uint64_t NumRecords = 0;
+    uint64_t RecordBytes = 0;
+    uint32_t Checksum = 0; /**CRC32C of the records*/
+    uint32_t Reserved = 0;
+};
+
+/**
+ * @brief Append-only log of requests, stored as binary records.
+ *
+ */
+class RequestLog {
+public:
+    typedef std::function<void(const std::string& _Route, nlohmann::json& _Request)> Visitor;
+
+    /**
+     * @brief Appends a request to the log.
+     *
+     * Failed requests are logged too, because some of them still change the
+     * model (a receptor that can not be linked takes an ID), and are replayed
+     * like the others. Compact() leaves them unchanged.
+     *
+     * @param _Succeeded false if the handler responded with an error.
+     */
+    void Append(const std::string& _Route, const nlohmann::json& _Request, bool _Succeeded = true);
+
+    size_t Size() const { return NumRecords_; }
+    size_t Bytes() const { return Records_.size(); }
+    void Clear();
+
+    //! Calls _Visitor with the route and the decoded request of every
+    //! record, in the order in which they were appended. The request is a
+    //! temporary that _Visitor may change.
+    void ForEach(const Visitor& _Visitor) const;
+
+    /**
+     * @brief Replaces runs of consecutive single create requests of shapes,
+     * BS compartments and receptors that succeeded with one BulkCreate
+     * request each.
+     *
+     * The bulk requests carry the names of the single ones, so replaying the
+     * compacted log creates the same objects with the same IDs. A failed
+     * create ends a run and is kept as it is, since a bulk request fails as
+     * a whole.
+     *
+     * @return Number of records removed.
+     */
+    size_t Compact();
+
+    //! Writes the log to _Path, returns false if it could not be written completely.
+    bool Save(const std::string& _Path) const;
+
+    //! Replaces the log by the one in _Path, returns false and leaves the
+    //! log empty if the file is not a valid request log.
+    bool Load(const std::string& _Path);
+
+    //! Tells if the file at _Path starts with the magic of this format.
+    static bool IsRequestLogFile(const std::string& _Path);
+
+private:
+    uint16_t RouteID(const std::string& _Route);
+    void AppendRecord(std::vector<uint8_t>& _Records, uint16_t _RouteID, const nlohmann::json& _Request, bool _Succeeded = true);
+
+    std::vector<std::string> Routes_;                    /**Route names, indexed by route ID*/
+    std::unordered_map<std::string, uint16_t> RouteIDs_; /**Route IDs by name*/
+    std::vector<uint8_t> Records_;                       /**Route ID and failed flag (uint16_t), payload length (uint32_t), msgpack payload, ...*/
+    size_t NumRecords_ = 0;
+};
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
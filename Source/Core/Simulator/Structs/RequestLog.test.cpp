@@ -0,0 +1,265 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the request log.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Structs/RequestLog.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+
+
+/**
+ * @brief Test class for unit tests for the RequestLog class.
+ * The log holds a run of three spheres and a run of two receptors with the
+ * same neurotransmitter, separated by a request that is not compacted.
+ */
+struct RequestLogTest : testing::Test {
+    BG::NES::Simulator::RequestLog testLog;
+    std::string path;
+
+    nlohmann::json Sphere(int i) {
+        return {
+            { "SimulationID", 0 }, { "Name", "Sphere" + std::to_string(i) }, { "Radius_um", 1.5 * i },
+            { "CenterPosX_um", 0.1 * i }, { "CenterPosY_um", 2.0 }, { "CenterPosZ_um", -3.0 },
+        };
+    }
+
+    nlohmann::json Receptor(int i, const std::string & neurotransmitter) {
+        return {
+            { "SimulationID", 0 }, { "Name", "Receptor" + std::to_string(i) },
+            { "SourceCompartmentID", i }, { "DestinationCompartmentID", i + 1 }, { "ReceptorMorphology", -1 },
+            { "Conductance_nS", 30.0 }, { "TimeConstantRise_ms", 2.0 }, { "TimeConstantDecay_ms", 15.0 },
+            { "Neurotransmitter", neurotransmitter },
+        };
+    }
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("RequestLogTest-" + std::to_string(::getpid()) + ".NES")).string();
+
+        for (int i = 0; i < 3; i++) {
+            testLog.Append("Simulation/Geometry/Sphere/Create", Sphere(i));
+        }
+        testLog.Append("Simulation/SetRandomSeed", { { "SimulationID", 0 }, { "Seed", 42 } });
+        testLog.Append("Simulation/Receptor/Create", Receptor(0, "AMPA"));
+        testLog.Append("Simulation/Receptor/Create", Receptor(1, "AMPA"));
+        testLog.Append("Simulation/Receptor/Create", Receptor(2, "GABA"));
+    }
+
+    void TearDown() {
+        std::filesystem::remove(path);
+    }
+
+    nlohmann::json Compartment(int i, int shapeID) {
+        return {
+            { "SimulationID", 0 }, { "Name", "Compartment" + std::to_string(i) }, { "ShapeID", shapeID },
+            { "MembranePotential_mV", -60.0 }, { "SpikeThreshold_mV", -50.0 }, { "DecayTime_ms", 30.0 },
+            { "RestingPotential_mV", -60.0 }, { "AfterHyperpolarizationAmplitude_mV", -10.0 },
+        };
+    }
+
+    //! Packed record _Index of a bulk request, as _Fields little-endian 32-bit values.
+    template <typename T>
+    T PackedValue(const nlohmann::json & _Request, size_t _Fields, size_t _Index, size_t _Field) {
+        T value;
+        std::memcpy(&value, _Request["Data"].get_binary().data() + (_Index * _Fields + _Field) * 4, sizeof(value));
+        return value;
+    }
+
+    //! Applies a create request to _Sim the way its handler does, returns
+    //! false where the handler responds with an error.
+    bool Apply(BG::NES::Simulator::Simulation & _Sim, const std::string & _Route, const nlohmann::json & _Request) {
+        using namespace BG::NES::Simulator;
+        if (_Route == "Simulation/Geometry/Sphere/Create") {
+            Geometries::Sphere S;
+            S.Radius_um = _Request["Radius_um"];
+            S.Center_um = Geometries::Vec3D(_Request["CenterPosX_um"].get<float>(), _Request["CenterPosY_um"].get<float>(), _Request["CenterPosZ_um"].get<float>());
+            S.Name = _Request["Name"];
+            _Sim.AddSphere(S);
+            return true;
+        }
+        if (_Route == "Simulation/Geometry/Sphere/BulkCreate") {
+            std::vector<Geometries::Sphere> spheres(_Request["Count"].get<int>());
+            for (size_t i = 0; i < spheres.size(); i++) {
+                spheres[i].Radius_um = PackedValue<float>(_Request, 4, i, 0);
+                spheres[i].Center_um = Geometries::Vec3D(PackedValue<float>(_Request, 4, i, 1), PackedValue<float>(_Request, 4, i, 2), PackedValue<float>(_Request, 4, i, 3));
+                spheres[i].Name = _Request["Names"][i];
+            }
+            _Sim.AddSpheres(spheres);
+            return true;
+        }
+        if (_Route == "Simulation/Compartments/BS/Create") {
+            Compartments::BS C;
+            C.ShapeID = _Request["ShapeID"];
+            C.MembranePotential_mV = _Request["MembranePotential_mV"];
+            C.SpikeThreshold_mV = _Request["SpikeThreshold_mV"];
+            C.DecayTime_ms = _Request["DecayTime_ms"];
+            C.RestingPotential_mV = _Request["RestingPotential_mV"];
+            C.AfterHyperpolarizationAmplitude_mV = _Request["AfterHyperpolarizationAmplitude_mV"];
+            C.Name = _Request["Name"];
+            return _Sim.AddSCCompartment(C) >= 0;
+        }
+        if (_Route == "Simulation/Compartments/BS/BulkCreate") {
+            std::vector<Compartments::BS> compartments(_Request["Count"].get<int>());
+            for (size_t i = 0; i < compartments.size(); i++) {
+                compartments[i].ShapeID = PackedValue<int32_t>(_Request, 6, i, 0);
+                compartments[i].MembranePotential_mV = PackedValue<float>(_Request, 6, i, 1);
+                compartments[i].SpikeThreshold_mV = PackedValue<float>(_Request, 6, i, 2);
+                compartments[i].DecayTime_ms = PackedValue<float>(_Request, 6, i, 3);
+                compartments[i].RestingPotential_mV = PackedValue<float>(_Request, 6, i, 4);
+                compartments[i].AfterHyperpolarizationAmplitude_mV = PackedValue<float>(_Request, 6, i, 5);
+                compartments[i].Name = _Request["Names"][i];
+            }
+            return _Sim.AddSCCompartments(compartments) >= 0;
+        }
+        if (_Route == "Simulation/Receptor/Create") {
+            Connections::Receptor C;
+            C.SourceCompartmentID = _Request["SourceCompartmentID"];
+            C.DestinationCompartmentID = _Request["DestinationCompartmentID"];
+            C.ShapeID = _Request["ReceptorMorphology"];
+            C.Conductance_nS = _Request["Conductance_nS"];
+            C.TimeConstantRise_ms = _Request["TimeConstantRise_ms"];
+            C.TimeConstantDecay_ms = _Request["TimeConstantDecay_ms"];
+            C.safeset_Neurotransmitter(_Request["Neurotransmitter"].get<std::string>().c_str());
+            C.Name = _Request["Name"];
+            return _Sim.AddReceptor(C) >= 0;
+        }
+        if (_Route == "Simulation/Receptor/BulkCreate") {
+            std::vector<Connections::Receptor> receptors(_Request["Count"].get<int>());
+            for (size_t i = 0; i < receptors.size(); i++) {
+                receptors[i].SourceCompartmentID = PackedValue<int32_t>(_Request, 6, i, 0);
+                receptors[i].DestinationCompartmentID = PackedValue<int32_t>(_Request, 6, i, 1);
+                receptors[i].ShapeID = PackedValue<int32_t>(_Request, 6, i, 2);
+                receptors[i].Conductance_nS = PackedValue<float>(_Request, 6, i, 3);
+                receptors[i].TimeConstantRise_ms = PackedValue<float>(_Request, 6, i, 4);
+                receptors[i].TimeConstantDecay_ms = PackedValue<float>(_Request, 6, i, 5);
+                receptors[i].safeset_Neurotransmitter(_Request["Neurotransmitter"].get<std::string>().c_str());
+                receptors[i].Name = _Request["Names"][i];
+            }
+            return _Sim.AddReceptors(receptors) >= 0;
+        }
+        return true;
+    }
+
+    std::vector<std::pair<std::string, nlohmann::json>> Records(const BG::NES::Simulator::RequestLog & _Log) {
+        std::vector<std::pair<std::string, nlohmann::json>> records;
+        _Log.ForEach([&](const std::string & _Route, nlohmann::json & _Request) {
+            records.emplace_back(_Route, _Request);
+        });
+        return records;
+    }
+};
+
+TEST_F(RequestLogTest, test_Save_Load_same_records) {
+    ASSERT_TRUE(testLog.Save(path));
+    ASSERT_TRUE(BG::NES::Simulator::RequestLog::IsRequestLogFile(path));
+
+    BG::NES::Simulator::RequestLog loadedLog;
+    ASSERT_TRUE(loadedLog.Load(path));
+    ASSERT_EQ(loadedLog.Size(), 7);
+    ASSERT_EQ(Records(loadedLog), Records(testLog));
+    ASSERT_EQ(Records(loadedLog)[3].second["Seed"], 42);
+}
+
+TEST_F(RequestLogTest, test_Load_fails_for_corrupt_file) {
+    ASSERT_TRUE(testLog.Save(path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    BG::NES::Simulator::RequestLog loadedLog;
+    ASSERT_FALSE(loadedLog.Load(path));
+    ASSERT_EQ(loadedLog.Size(), 0);
+}
+
+TEST_F(RequestLogTest, test_Compact_collapses_runs_into_bulk_records) {
+    ASSERT_EQ(testLog.Compact(), 3);
+    auto records = Records(testLog);
+    ASSERT_EQ(records.size(), 4);
+
+    ASSERT_EQ(records[0].first, "Simulation/Geometry/Sphere/BulkCreate");
+    ASSERT_EQ(records[0].second["Count"], 3);
+    ASSERT_EQ(records[0].second["Names"], nlohmann::json({ "Sphere0", "Sphere1", "Sphere2" }));
+    const nlohmann::json::binary_t & data = records[0].second["Data"].get_binary();
+    ASSERT_EQ(data.size(), 3 * 4 * sizeof(float));
+    float radius;
+    std::memcpy(&radius, data.data() + 4 * sizeof(float), sizeof(radius)); // little-endian host
+    ASSERT_EQ(radius, 1.5f);
+
+    ASSERT_EQ(records[1].first, "Simulation/SetRandomSeed");
+
+    // The receptor with another neurotransmitter ends the run and stays single.
+    ASSERT_EQ(records[2].first, "Simulation/Receptor/BulkCreate");
+    ASSERT_EQ(records[2].second["Count"], 2);
+    ASSERT_EQ(records[2].second["Neurotransmitter"], "AMPA");
+    ASSERT_EQ(records[3].first, "Simulation/Receptor/Create");
+    ASSERT_EQ(records[3].second, Receptor(2, "GABA"));
+}
+
+TEST_F(RequestLogTest, test_Compact_replays_to_same_model) {
+    using namespace BG::NES::Simulator;
+    BG::Common::Logger::LoggingSystem logger;
+
+    // Requests are logged with the outcome of their handler. Compartment 2
+    // refers to a shape that does not exist, and the receptors can not be
+    // linked as there are no neurons, but each of them still takes an ID.
+    Simulation liveSimulation(&logger);
+    RequestLog log;
+    auto Handle = [&](const std::string & _Route, const nlohmann::json & _Request) {
+        log.Append(_Route, _Request, Apply(liveSimulation, _Route, _Request));
+    };
+    for (int i = 0; i < 3; i++) {
+        Handle("Simulation/Geometry/Sphere/Create", Sphere(i));
+    }
+    Handle("Simulation/Compartments/BS/Create", Compartment(0, 0));
+    Handle("Simulation/Compartments/BS/Create", Compartment(1, 1));
+    Handle("Simulation/Compartments/BS/Create", Compartment(2, 7));
+    Handle("Simulation/Compartments/BS/Create", Compartment(3, 2));
+    for (int i = 0; i < 3; i++) {
+        Handle("Simulation/Receptor/Create", Receptor(i, "AMPA"));
+    }
+    ASSERT_EQ(liveSimulation.BSCompartments.size(), 3);
+    ASSERT_EQ(liveSimulation.Receptors.size(), 3);
+
+    Simulation rawSimulation(&logger);
+    log.ForEach([&](const std::string & _Route, nlohmann::json & _Request) { Apply(rawSimulation, _Route, _Request); });
+
+    // Only the spheres and the first two compartments are collapsed.
+    ASSERT_EQ(log.Compact(), 3);
+    ASSERT_TRUE(log.Save(path));
+    RequestLog loadedLog;
+    ASSERT_TRUE(loadedLog.Load(path));
+    Simulation compactedSimulation(&logger);
+    loadedLog.ForEach([&](const std::string & _Route, nlohmann::json & _Request) { Apply(compactedSimulation, _Route, _Request); });
+
+    for (Simulation* sim : { &rawSimulation, &compactedSimulation }) {
+        ASSERT_EQ(sim->Collection.Size(), liveSimulation.Collection.Size());
+        ASSERT_EQ(sim->BSCompartments.size(), liveSimulation.BSCompartments.size());
+        for (size_t i = 0; i < sim->BSCompartments.size(); i++) {
+            ASSERT_EQ(sim->BSCompartments[i].ID, liveSimulation.BSCompartments[i].ID);
+            ASSERT_EQ(sim->BSCompartments[i].ShapeID, liveSimulation.BSCompartments[i].ShapeID);
+            ASSERT_EQ(sim->BSCompartments[i].Name, liveSimulation.BSCompartments[i].Name);
+        }
+        ASSERT_EQ(sim->Receptors.size(), liveSimulation.Receptors.size());
+        for (size_t i = 0; i < sim->Receptors.size(); i++) {
+            ASSERT_EQ(sim->Receptors[i]->ID, liveSimulation.Receptors[i]->ID);
+            ASSERT_EQ(sim->Receptors[i]->SourceCompartmentID, liveSimulation.Receptors[i]->SourceCompartmentID);
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <Simulator/Structs/Simulation.h>
 
+#include <Simulator/Structs/ModelFile.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
 #include <Simulator/SimpleCompartmental/SCNeuron.h>
@@ -8,9 +9,12 @@
 #include <Simulator/Geometries/Sphere.h>
 #include <Simulator/Geometries/Cylinder.h>
 #include <Simulator/Geometries/Box.h>
+#include <Util/WorkerTeam.h>
 
 
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
@@ -69,6 +73,66 @@ int Simulation::AddRegion(BrainRegions::BrainRegion& _R) {
     return _R.ID;
 }
 
+/**
+ * Note: The flags are changed while holding WorkMutex_, so that a thread that
+ *       checks them before it waits can not miss the notification.
+ */
+void Simulation::RequestWork(SimulationActions _Task) {
+    {
+        std::lock_guard<std::mutex> Lock(WorkMutex_);
+        CurrentTask = _Task;
+        WorkRequested = true;
+    }
+    WorkCondition_.notify_all();
+}
+
+bool Simulation::WaitForWorkRequest(std::chrono::milliseconds _Timeout) {
+    std::unique_lock<std::mutex> Lock(WorkMutex_);
+    return WorkCondition_.wait_for(Lock, _Timeout, [this]() { return bool(WorkRequested); });
+}
+
+void Simulation::SetProcessing() {
+    std::lock_guard<std::mutex> Lock(WorkMutex_);
+    IsProcessing = true;
+}
+
+void Simulation::WorkDone() {
+    {
+        std::lock_guard<std::mutex> Lock(WorkMutex_);
+        CurrentTask = SIMULATION_NONE;
+        WorkRequested = false;
+        IsProcessing = false;
+    }
+    WorkCondition_.notify_all();
+}
+
+void Simulation::StartRendering() {
+    std::lock_guard<std::mutex> Lock(WorkMutex_);
+    IsRendering = true;
+}
+
+void Simulation::RenderingDone() {
+    {
+        std::lock_guard<std::mutex> Lock(WorkMutex_);
+        IsRendering = false;
+    }
+    WorkCondition_.notify_all();
+}
+
+void Simulation::WaitForRendering() {
+    std::unique_lock<std::mutex> Lock(WorkMutex_);
+    WorkCondition_.wait(Lock, [this]() { return !IsRendering; });
+}
+
+bool Simulation::WaitUntilIdle(std::chrono::milliseconds _Timeout) {
+    std::unique_lock<std::mutex> Lock(WorkMutex_);
+    return WorkCondition_.wait_for(Lock, _Timeout, [this]() { return !IsBusy(); });
+}
+
+bool Simulation::IsBusy() const {
+    return IsProcessing || WorkRequested || IsRendering;
+}
+
 int Simulation::AddSphere(Geometries::Sphere& _S) {
     _S.ID = Collection.Geometries.size();
     Collection.Geometries.push_back(_S);
@@ -108,6 +172,12 @@ int Simulation::AddSCNeuron(CoreStructs::SCNeuronStruct& _N) {
     _N.ID = Neurons.size();
     
     Neurons.push_back(std::make_shared<SCNeuron>(_N, *this));
+    LinkSCNeuron(_N);
+
+    return _N.ID;
+}
+
+void Simulation::LinkSCNeuron(const CoreStructs::SCNeuronStruct& _N) {
     for (const auto & SomaID : _N.SomaCompartmentIDs) {
         NeuronByCompartment.emplace(SomaID, _N.ID);
     }
@@ -117,8 +187,6 @@ int Simulation::AddSCNeuron(CoreStructs::SCNeuronStruct& _N) {
     for (const auto & AxonID : _N.AxonCompartmentIDs) {
         NeuronByCompartment.emplace(AxonID, _N.ID);
     }
-
-    return _N.ID;
 }
 
 int Simulation::AddReceptor(Connections::Receptor& _C) {
@@ -126,20 +194,102 @@ int Simulation::AddReceptor(Connections::Receptor& _C) {
     _C.ID = Receptors.size();
 
     Receptors.push_back(std::make_unique<Connections::Receptor>(_C));
+    if (!LinkReceptor(*Receptors.back())) {
+        return -1;
+    }
 
+    return _C.ID;
+}
+
+bool Simulation::LinkReceptor(Connections::Receptor& _C) {
     // Inform destination neuron of its new input receptor.
     CoreStructs::Neuron* SrcNeuronPtr = FindNeuronByCompartment(_C.SourceCompartmentID);
     CoreStructs::Neuron* DstNeuronPtr = FindNeuronByCompartment(_C.DestinationCompartmentID);
     if ((SrcNeuronPtr==nullptr) || (DstNeuronPtr==nullptr)) {
-        return -1;
+        return false;
     }
 
-    CoreStructs::ReceptorData RData(_C.ID, Receptors.back().get(), SrcNeuronPtr, DstNeuronPtr);
+    CoreStructs::ReceptorData RData(_C.ID, &_C, SrcNeuronPtr, DstNeuronPtr);
+    ReceptorIndex.Add(_C.ID, SrcNeuronPtr->ID, DstNeuronPtr->ID);
     SrcNeuronPtr->OutputTransmitterAdded(RData);
     DstNeuronPtr->InputReceptorAdded(RData);
     SrcNeuronPtr->UpdateType(_C.Neurotransmitter);
 
-    return _C.ID;
+    return true;
+}
+
+//! Makes room for _Count more elements. Capacity grows at least twofold, as
+//! with push_back(), so that many small batches don't reallocate every time.
+template <typename V>
+static void ReserveFor(V& _Vector, size_t _Count) {
+    if (_Vector.size() + _Count > _Vector.capacity()) {
+        _Vector.reserve(std::max(_Vector.size() + _Count, 2 * _Vector.capacity()));
+    }
+}
+
+template <typename T>
+static int AddGeometries(Geometries::GeometryCollection& _Collection, std::vector<T>& _S) {
+    int FirstID = _Collection.Geometries.size();
+    ReserveFor(_Collection.Geometries, _S.size());
+    for (T& S : _S) {
+        S.ID = _Collection.Geometries.size();
+        _Collection.Geometries.push_back(S);
+    }
+    return FirstID;
+}
+
+int Simulation::AddSpheres(std::vector<Geometries::Sphere>& _S) {
+    return AddGeometries(Collection, _S);
+}
+
+int Simulation::AddCylinders(std::vector<Geometries::Cylinder>& _S) {
+    return AddGeometries(Collection, _S);
+}
+
+int Simulation::AddBoxes(std::vector<Geometries::Box>& _S) {
+    return AddGeometries(Collection, _S);
+}
+
+/**
+ * Note: All shapes are looked up before the first compartment is added, so
+ *       that a failed batch leaves the IDs of a later batch contiguous.
+ */
+int Simulation::AddSCCompartments(std::vector<Compartments::BS>& _C) {
+    for (Compartments::BS& C : _C) {
+        C.ShapePtr = Collection.GetGeometry(C.ShapeID);
+        if (!C.ShapePtr) {
+            return -1;
+        }
+    }
+
+    int FirstID = BSCompartments.size();
+    ReserveFor(BSCompartments, _C.size());
+    for (Compartments::BS& C : _C) {
+        C.ID = BSCompartments.size();
+        BSCompartments.push_back(C);
+    }
+    return FirstID;
+}
+
+/**
+ * Note: Unlike AddReceptor, which stores a receptor even if it can not be
+ *       linked, a batch is only added if every receptor can be linked.
+ */
+int Simulation::AddReceptors(std::vector<Connections::Receptor>& _C) {
+    for (const Connections::Receptor& C : _C) {
+        if ((FindNeuronByCompartment(C.SourceCompartmentID)==nullptr) || (FindNeuronByCompartment(C.DestinationCompartmentID)==nullptr)) {
+            return -1;
+        }
+    }
+
+    int FirstID = Receptors.size();
+    ReserveFor(Receptors, _C.size());
+    for (Connections::Receptor& C : _C) {
+        C.ID = Receptors.size();
+        Receptors.push_back(std::make_unique<Connections::Receptor>(C));
+        LinkReceptor(*Receptors.back());
+    }
+    return FirstID;
 }
 
 struct SaverInfo {
@@ -184,150 +334,8 @@ struct SaverGeometry {
     }
 };
 
-class Saver {
-protected:
-    std::string Name_;
-    SaverInfo _SaverInfo;
-    std::vector<SaverGeometry> SGMap; // Vector indices follow those in Collection.Geometries.
-    std::vector<Geometries::Sphere*> SphereReferences;
-    std::vector<Geometries::Cylinder*> CylinderReferences;
-    std::vector<Geometries::Box*> BoxReferences;
-    std::vector<Compartments::BS>* RefToCompartments;
-    std::vector<std::shared_ptr<CoreStructs::Neuron>>* RefToSCNeurons;
-    std::vector<std::unique_ptr<Connections::Receptor>>* RefToReceptors;
-    std::vector<std::unique_ptr<BrainRegions::BrainRegion>>* RefToRegions;
-    std::vector<std::unique_ptr<CoreStructs::NeuralCircuit>>* RefToNeuralCircuits;
-
-public:
-    Saver(const std::string& _Name): Name_(_Name) {}
-
-    void AddSphere(Geometries::Sphere& S) {
-        SGMap.emplace_back(Geometries::GeometrySphere, SphereReferences.size());
-        SphereReferences.emplace_back(&S);
-    }
-    void AddCylinder(Geometries::Cylinder& C) {
-        SGMap.emplace_back(Geometries::GeometryCylinder, CylinderReferences.size());
-        CylinderReferences.emplace_back(&C);
-    }
-    void AddBox(Geometries::Box& B) {
-        SGMap.emplace_back(Geometries::GeometryBox, BoxReferences.size());
-        BoxReferences.emplace_back(&B);
-    }
-    void AddBSSCCompartments(std::vector<Compartments::BS>& _RefToCompartments) {
-        RefToCompartments = &_RefToCompartments;
-    }
-    //! Warning: This assumes all neurons are of SCNeuron type.
-    void AddNeurons(std::vector<std::shared_ptr<CoreStructs::Neuron>>& _RefToSCNeurons) {
-        RefToSCNeurons = &_RefToSCNeurons;
-    }
-    void AddReceptors(std::vector<std::unique_ptr<Connections::Receptor>>& _RefToReceptors) {
-        RefToReceptors = &_RefToReceptors;
-    }
-    void AddRegions(std::vector<std::unique_ptr<BrainRegions::BrainRegion>>& _RefToRegions) {
-        RefToRegions = &_RefToRegions;
-    }
-    void AddCircuits(std::vector<std::unique_ptr<CoreStructs::NeuralCircuit>>& _RefToNeuralCircuits) {
-        RefToNeuralCircuits = &_RefToNeuralCircuits;
-    }
-
-    bool Save() {
-        /** Save file structure is:
-         *  1. SaverInfo
-         *  2. SaverGeometry[] (SaverInfo.SGMapSize elements)
-         *  3. Geometries::SphereBase[] (SaverInfo.SphereReferencesSize elements)
-         *  4. Geometries::CylinderBase[] (SaverInfo.CylinderReferencesSize elements)
-         *  5. Geometries::BoxBase[] (SaverInfo.BoxReferencesSize elements)
-         *  6. Compartments::BSBaseData[] (SaverInfo.BSSCCompartmentsSize elements)
-         *  7. Connections::ReceptorBase[] (SaverInfo.ReceptorsSize elements)
-         *  8. BrainRegions::RegionBase[] (SaverInfo.RegionsSize elements)
-         *  9. flatdata_sizes[] (SaverInfo.NeuronsSize elements)
-         *  10. circuitdata_sizes[] (SaverInfo.CircuitsSize.elements)
-         *  11. concatenated SCNeuronStruct::GetFlat()->data() (SaverInfo.NeuronsSize variable size chunks)
-         *  12. concatenated NeuralCircuit::GetFlat()->data() (SaverInfo.CircuitsSize variable size chunks)
-         */
-        auto SaveFile = std::fstream(Name_, std::ios::out | std::ios::binary);
-        _SaverInfo.SGMapSize = SGMap.size();
-        _SaverInfo.SphereReferencesSize = SphereReferences.size();
-        _SaverInfo.CylinderReferencesSize = CylinderReferences.size();
-        _SaverInfo.BoxReferencesSize = BoxReferences.size();
-        _SaverInfo.BSSCCompartmentsSize = RefToCompartments->size();
-        _SaverInfo.ReceptorsSize = RefToReceptors->size();
-        _SaverInfo.NeuronsSize = RefToSCNeurons->size();
-        _SaverInfo.RegionsSize = RefToRegions->size();
-        _SaverInfo.CircuitsSize = RefToNeuralCircuits->size();
-
-        SaveFile.write((char*)&_SaverInfo, sizeof(_SaverInfo));
-        SaveFile.write((char*)SGMap.data(), sizeof(SaverGeometry)*SGMap.size());
-        for (auto& ptr : SphereReferences) {
-            Geometries::SphereBase& basedataref = *ptr;
-            SaveFile.write((char*)&basedataref, sizeof(Geometries::SphereBase));
-        }
-        for (auto& ptr : CylinderReferences) {
-            Geometries::CylinderBase& basedataref = *ptr;
-            SaveFile.write((char*)&basedataref, sizeof(Geometries::CylinderBase));
-        }
-        for (auto& ptr : BoxReferences) {
-            Geometries::BoxBase& basedataref = *ptr;
-            SaveFile.write((char*)&basedataref, sizeof(Geometries::BoxBase));
-        }
-
-        // Save fixed-size base data of compartments.
-        for (auto& ref : (*RefToCompartments)) {
-            Compartments::BSBaseData& basedataref = ref;
-            SaveFile.write((char*)&basedataref, sizeof(Compartments::BSBaseData));
-        }
-
-        // Save fixed-size base data of receptors.
-        for (auto& ref : (*RefToReceptors)) {
-            Connections::ReceptorBase& basedataref = *ref;
-            SaveFile.write((char*)&basedataref, sizeof(Connections::ReceptorBase));
-        }
-
-        // Save fixed-size base data of regions.
-        for (auto& ref : (*RefToRegions)) {
-            BrainRegions::RegionBase& basedataref = *ref;
-            SaveFile.write((char*)&basedataref, sizeof(BrainRegions::RegionBase));
-        }
-
-        // Save fixed-size base data of neurons and flattened variable
-        // size crucial data.
-        std::vector<uint32_t> flatdata_sizes;
-        std::vector<std::unique_ptr<uint8_t[]>> flatdata_list;
-        for (auto& ref : (*RefToSCNeurons)) { // from a list of shared pointers to SCNeuron objects
-            std::unique_ptr<uint8_t[]> flatdata = static_cast<SCNeuron*>(ref.get())->build_data.GetFlat();
-            CoreStructs::SCNeuronStructFlatHeader* header_ptr = (CoreStructs::SCNeuronStructFlatHeader*) flatdata.get();
-            flatdata_sizes.push_back(header_ptr->FlatBufSize);
-            flatdata_list.emplace_back(flatdata.release());
-        }
-
-        // The same for neural circuits.
-        std::vector<uint32_t> circuitdata_sizes;
-        std::vector<std::unique_ptr<uint8_t[]>> circuitdata_list;
-        for (auto& ref : (*RefToNeuralCircuits)) { // from a list of unique pointers to NeuralCircuit objects
-            //std::unique_ptr<uint8_t[]> circuitdata = static_cast<CoreStructs::NeuralCircuit*>(ref.get())->build_data.GetFlat();
-            std::unique_ptr<uint8_t[]> circuitdata = static_cast<CoreStructs::NeuralCircuit*>(ref.get())->GetFlat();
-            CoreStructs::NeuralCircuitStructFlatHeader* header_ptr = (CoreStructs::NeuralCircuitStructFlatHeader*) circuitdata.get();
-            circuitdata_sizes.push_back(header_ptr->FlatBufSize);
-            circuitdata_list.emplace_back(circuitdata.release());
-        }
-
-        SaveFile.write((char*)flatdata_sizes.data(), sizeof(uint32_t)*flatdata_sizes.size());
-
-        SaveFile.write((char*)circuitdata_sizes.data(), sizeof(uint32_t)*circuitdata_sizes.size());
-
-        for (size_t i = 0; i < flatdata_list.size(); i++) {
-            SaveFile.write((char*)flatdata_list.at(i).get(), flatdata_sizes.at(i));
-        }
-
-        for (size_t i = 0; i < circuitdata_list.size(); i++) {
-            SaveFile.write((char*)circuitdata_list.at(i).get(), circuitdata_sizes.at(i));
-        }
-
-        SaveFile.close();
-        return SaveFile.good();
-    }
-};
-
+//! Reads model files saved before the model file format of ModelFile.h,
+//! which consist of the blocks listed in InspectSavedModel().
 class Loader {
 public:
     std::string Name_;
@@ -401,27 +409,116 @@ public:
     }
 };
 
+//! Arrays of a saved model, either read from a legacy model file by the
+//! Loader or mapped in place from a model file, see ModelFile.h.
+struct SavedModelArrays {
+    const SaverGeometry* SGMap = nullptr;
+    size_t SGMapSize = 0;
+    const Geometries::SphereBase* SphereData = nullptr;
+    size_t SphereSize = 0;
+    const Geometries::CylinderBase* CylinderData = nullptr;
+    size_t CylinderSize = 0;
+    const Geometries::BoxBase* BoxData = nullptr;
+    size_t BoxSize = 0;
+    const Compartments::BSBaseData* CompartmentData = nullptr;
+    size_t CompartmentsSize = 0;
+    const Connections::ReceptorBase* ReceptorData = nullptr;
+    size_t ReceptorsSize = 0;
+    const BrainRegions::RegionBase* RegionData = nullptr;
+    size_t RegionsSize = 0;
+    const uint64_t* NeuronOffsets = nullptr; // NeuronsSize+1 entries into NeuronData
+    size_t NeuronsSize = 0;
+    const uint8_t* NeuronData = nullptr;
+    size_t NeuronDataSize = 0;
+    const uint64_t* CircuitOffsets = nullptr; // CircuitsSize+1 entries into CircuitData
+    size_t CircuitsSize = 0;
+    const uint8_t* CircuitData = nullptr;
+    size_t CircuitDataSize = 0;
+
+    //! Checks that all indices and offsets stay within the arrays.
+    bool IsConsistent() const {
+        for (size_t i = 0; i < SGMapSize; i++) {
+            size_t TypeSize = 0;
+            switch (SGMap[i].Type) {
+            case Geometries::GeometrySphere: TypeSize = SphereSize; break;
+            case Geometries::GeometryCylinder: TypeSize = CylinderSize; break;
+            case Geometries::GeometryBox: TypeSize = BoxSize; break;
+            default: return false;
+            }
+            if (SGMap[i].Idx >= TypeSize) return false;
+        }
+        auto OffsetsAreConsistent = [](const uint64_t* _Offsets, size_t _Size, size_t _DataSize) {
+            if (_Size == 0) return true;
+            if (_Offsets == nullptr) return false;
+            for (size_t i = 0; i < _Size; i++) {
+                if ((_Offsets[i] > _Offsets[i+1]) || (_Offsets[i+1] - _Offsets[i] < sizeof(uint32_t))) return false;
+            }
+            return _Offsets[_Size] <= _DataSize;
+        };
+        if (!OffsetsAreConsistent(NeuronOffsets, NeuronsSize, NeuronDataSize)
+            || !OffsetsAreConsistent(CircuitOffsets, CircuitsSize, CircuitDataSize)
+            || (RegionsSize > CircuitsSize)) return false;
+
+        // Compartments and neurons are instantiated independently, so those
+        // that the Add functions would reject must not occur.
+        for (size_t i = 0; i < CompartmentsSize; i++) {
+            if ((CompartmentData[i].ShapeID < 0) || (size_t(CompartmentData[i].ShapeID) >= SGMapSize)) return false;
+        }
+        for (size_t i = 0; i < NeuronsSize; i++) {
+            if (NeuronOffsets[i+1] - NeuronOffsets[i] < sizeof(CoreStructs::SCNeuronStructFlatHeader)) return false;
+            CoreStructs::SCNeuronStructFlatHeader Header;
+            std::memcpy(&Header, NeuronData + NeuronOffsets[i], sizeof(Header));
+            if ((Header.FlatBufSize > NeuronOffsets[i+1] - NeuronOffsets[i]) || (Header.SomaCompartmentIDsSize < 1)) return false;
+        }
+        return true;
+    }
+};
+
+//! Aligns the flat buffers of variable size model data in model files.
+#define _MODELFILE_FLAT_ALIGNMENT 8
+
+//! Concatenates flat buffers that start with their uint32_t size at
+//! _MODELFILE_FLAT_ALIGNMENT aligned positions, and lists their offsets.
+static void ConcatenateFlat(const std::vector<std::unique_ptr<uint8_t[]>>& _Flat, std::vector<uint8_t>& _Data, std::vector<uint64_t>& _Offsets) {
+    for (const auto& Buf : _Flat) {
+        uint32_t FlatBufSize;
+        std::memcpy(&FlatBufSize, Buf.get(), sizeof(FlatBufSize));
+        _Offsets.emplace_back(_Data.size());
+        _Data.insert(_Data.end(), Buf.get(), Buf.get() + FlatBufSize);
+        _Data.resize((_Data.size() + _MODELFILE_FLAT_ALIGNMENT - 1) / _MODELFILE_FLAT_ALIGNMENT * _MODELFILE_FLAT_ALIGNMENT, 0);
+    }
+    _Offsets.emplace_back(_Data.size());
+}
+
 /**
  * Save neuronal circuit specifications to file.
+ *
+ * The model file holds one section per array of SavedModelArrays, see
+ * ModelFile.h, so that LoadModel can use them in place.
  */
 bool Simulation::SaveModel(const std::string& Name) {
-    Saver _Saver(Name);
-    // Prepare to save shapes.
+    std::vector<SaverGeometry> SGMap;
+    std::vector<Geometries::SphereBase> SphereData;
+    std::vector<Geometries::CylinderBase> CylinderData;
+    std::vector<Geometries::BoxBase> BoxData;
+    SGMap.reserve(Collection.Size());
+
+    // Shapes of each type are saved in their own array.
     for (size_t i = 0; i < Collection.Size(); i++) {
         switch (Collection.GetShapeType(i)) {
         case Geometries::GeometrySphere: {
-            auto& S = Collection.GetSphere(i);
-            _Saver.AddSphere(S);
+            SGMap.emplace_back(Geometries::GeometrySphere, SphereData.size());
+            SphereData.emplace_back(Collection.GetSphere(i));
             break;
         }
         case Geometries::GeometryCylinder: {
-            auto& C = Collection.GetCylinder(i);
-            _Saver.AddCylinder(C);
+            SGMap.emplace_back(Geometries::GeometryCylinder, CylinderData.size());
+            CylinderData.emplace_back(Collection.GetCylinder(i));
             break;
         }
         case Geometries::GeometryBox: {
-            auto& B = Collection.GetBox(i);
-            _Saver.AddBox(B);
+            SGMap.emplace_back(Geometries::GeometryBox, BoxData.size());
+            BoxData.emplace_back(Collection.GetBox(i));
             break;
         }
         default: {
@@ -430,98 +527,237 @@ bool Simulation::SaveModel(const std::string& Name) {
         }
         }
     }
-    // Prepare to save compartments.
-    _Saver.AddBSSCCompartments(BSCompartments);
-    // Save neurons.
-    _Saver.AddNeurons(Neurons);
-    // Save synapses.
-    _Saver.AddReceptors(Receptors);
-    // Save regions.
-    _Saver.AddRegions(Regions);
-    // Save circuits.
-    _Saver.AddCircuits(NeuralCircuits);
 
-    return _Saver.Save();
+    std::vector<Compartments::BSBaseData> CompartmentData(BSCompartments.begin(), BSCompartments.end());
+
+    std::vector<Connections::ReceptorBase> ReceptorData;
+    ReceptorData.reserve(Receptors.size());
+    for (auto& ref : Receptors) ReceptorData.emplace_back(*ref);
+
+    std::vector<BrainRegions::RegionBase> RegionData;
+    RegionData.reserve(Regions.size());
+    for (auto& ref : Regions) RegionData.emplace_back(*ref);
+
+    // Variable size data of neurons and circuits is flattened.
+    //! Warning: This assumes all neurons are of SCNeuron type.
+    std::vector<std::unique_ptr<uint8_t[]>> NeuronFlat;
+    NeuronFlat.reserve(Neurons.size());
+    for (auto& ref : Neurons) {
+        NeuronFlat.emplace_back(static_cast<SCNeuron*>(ref.get())->build_data.GetFlat());
+    }
+    std::vector<uint8_t> NeuronData;
+    std::vector<uint64_t> NeuronOffsets;
+    ConcatenateFlat(NeuronFlat, NeuronData, NeuronOffsets);
+    NeuronFlat.clear();
+
+    std::vector<std::unique_ptr<uint8_t[]>> CircuitFlat;
+    for (auto& ref : NeuralCircuits) {
+        CircuitFlat.emplace_back(ref->GetFlat());
+    }
+    std::vector<uint8_t> CircuitData;
+    std::vector<uint64_t> CircuitOffsets;
+    ConcatenateFlat(CircuitFlat, CircuitData, CircuitOffsets);
+    CircuitFlat.clear();
+
+    ModelFileWriter Writer;
+    Writer.AddArray(MODELSECTION_GEOMETRY_MAP, SGMap);
+    Writer.AddArray(MODELSECTION_SPHERES, SphereData);
+    Writer.AddArray(MODELSECTION_CYLINDERS, CylinderData);
+    Writer.AddArray(MODELSECTION_BOXES, BoxData);
+    Writer.AddArray(MODELSECTION_COMPARTMENTS, CompartmentData);
+    Writer.AddArray(MODELSECTION_RECEPTORS, ReceptorData);
+    Writer.AddArray(MODELSECTION_REGIONS, RegionData);
+    Writer.AddArray(MODELSECTION_NEURON_OFFSETS, NeuronOffsets);
+    Writer.AddArray(MODELSECTION_NEURON_DATA, NeuronData);
+    Writer.AddArray(MODELSECTION_CIRCUIT_OFFSETS, CircuitOffsets);
+    Writer.AddArray(MODELSECTION_CIRCUIT_DATA, CircuitData);
+    return Writer.Write(Name);
+}
+
+//! Range [first, second) of _Size elements handled by member _Member of a
+//! team of _NumMembers.
+static std::pair<size_t, size_t> MemberRange(size_t _Size, size_t _Member, size_t _NumMembers) {
+    return { _Size * _Member / _NumMembers, _Size * (_Member + 1) / _NumMembers };
 }
 
 /**
- * Load neuronal circuit specifications from file, replacing any
- * previous specifications in this simulation object.
+ * Instantiate the model in _Arrays, replacing any previous specifications
+ * in _Sim.
+ *
+ * Shapes, compartments, neurons and receptors do not depend on each other,
+ * so they are decoded concurrently by the members of _Team, each taking a
+ * slice of every array. Only the cross-linking of compartments to shapes
+ * and of receptors to neurons is done in a serial pass afterwards.
  */
-bool Simulation::LoadModel(const std::string& Name) {
-    Loader _Loader(Name);
-    if (!_Loader.Load()) return false;
-
-    // Reset and instantiate shapes.
-    Collection.Geometries.clear();
-
-    int ID;
-    for (size_t i = 0; i < _Loader._SaverInfo.SGMapSize; i++) {
-        auto& sgm = _Loader.SGMap.get()[i];
-        switch (sgm.Type) {
-        case Geometries::GeometrySphere: {
-            Geometries::Sphere _S(_Loader.SphereData.get()[sgm.Idx]);
-            _S.Name = "sphere-"+std::to_string(i);
-            ID = AddSphere(_S);
-            break;
-        }
-        case Geometries::GeometryCylinder: {
-            Geometries::Cylinder _S(_Loader.CylinderData.get()[sgm.Idx]);
-            _S.Name = "cylinder-"+std::to_string(i);
-            ID = AddCylinder(_S);
-            break;
-        }
-        case Geometries::GeometryBox: {
-            Geometries::Box _S(_Loader.BoxData.get()[sgm.Idx]);
-            _S.Name = "box-"+std::to_string(i);
-            ID = AddBox(_S);
-            break;
+static void InstantiateModel(Simulation& _Sim, const SavedModelArrays& _Arrays, Util::WorkerTeam& _Team) {
+
+    // Reset all containers to their final sizes, so that members can fill
+    // in elements in place.
+    _Sim.Collection.Geometries.clear();
+    _Sim.Collection.Geometries.resize(_Arrays.SGMapSize);
+    _Sim.BSCompartments.clear();
+    _Sim.BSCompartments.resize(_Arrays.CompartmentsSize);
+    _Sim.Neurons.clear();
+    _Sim.Neurons.resize(_Arrays.NeuronsSize);
+    _Sim.NeuronByCompartment.clear();
+    _Sim.Receptors.clear();
+    _Sim.Receptors.resize(_Arrays.ReceptorsSize);
+    _Sim.ReceptorIndex.Clear();
+
+    _Team.Run([&](size_t _Member) {
+        auto [ShapesBegin, ShapesEnd] = MemberRange(_Arrays.SGMapSize, _Member, _Team.Size());
+        for (size_t i = ShapesBegin; i < ShapesEnd; i++) {
+            auto& sgm = _Arrays.SGMap[i];
+            switch (sgm.Type) {
+            case Geometries::GeometrySphere: {
+                Geometries::Sphere _S(_Arrays.SphereData[sgm.Idx]);
+                _S.ID = i;
+                _S.Name = "sphere-"+std::to_string(i);
+                _Sim.Collection.Geometries[i] = std::move(_S);
+                break;
+            }
+            case Geometries::GeometryCylinder: {
+                Geometries::Cylinder _S(_Arrays.CylinderData[sgm.Idx]);
+                _S.ID = i;
+                _S.Name = "cylinder-"+std::to_string(i);
+                _Sim.Collection.Geometries[i] = std::move(_S);
+                break;
+            }
+            default: {
+                Geometries::Box _S(_Arrays.BoxData[sgm.Idx]);
+                _S.ID = i;
+                _S.Name = "box-"+std::to_string(i);
+                _Sim.Collection.Geometries[i] = std::move(_S);
+                break;
+            }
+            }
         }
-        default: {
-            Logger_->Log("Loaded unknown shape type.", 7);
+
+        auto [CompartmentsBegin, CompartmentsEnd] = MemberRange(_Arrays.CompartmentsSize, _Member, _Team.Size());
+        for (size_t i = CompartmentsBegin; i < CompartmentsEnd; i++) {
+            Compartments::BS& _C = _Sim.BSCompartments[i];
+            _C = Compartments::BS(_Arrays.CompartmentData[i]);
+            _C.ID = i;
+            _C.Name = "compartment-"+std::to_string(i);
         }
+
+        auto [NeuronsBegin, NeuronsEnd] = MemberRange(_Arrays.NeuronsSize, _Member, _Team.Size());
+        for (size_t i = NeuronsBegin; i < NeuronsEnd; i++) {
+            CoreStructs::SCNeuronStruct _N;
+            _N.FromFlat((CoreStructs::SCNeuronStructFlatHeader*) (_Arrays.NeuronData + _Arrays.NeuronOffsets[i]));
+            _N.ID = i;
+            _Sim.Neurons[i] = std::make_shared<SCNeuron>(_N, _Sim);
         }
-    }
 
-    // Reset and instantiate compartments.
-    BSCompartments.clear();
+        auto [ReceptorsBegin, ReceptorsEnd] = MemberRange(_Arrays.ReceptorsSize, _Member, _Team.Size());
+        for (size_t i = ReceptorsBegin; i < ReceptorsEnd; i++) {
+            auto _R = std::make_unique<Connections::Receptor>(_Arrays.ReceptorData[i]);
+            _R->ID = i;
+            _R->Name = "syn-"+std::to_string(i);
+            _Sim.Receptors[i] = std::move(_R);
+        }
+    });
 
-    for (size_t i = 0; i < _Loader._SaverInfo.BSSCCompartmentsSize; i++) {
-        Compartments::BS _C(_Loader.CompartmentData.get()[i]);
-        _C.Name = "compartment-"+std::to_string(i);
-        ID = AddSCCompartment(_C);
+    // Cross-link in the order in which the Add functions would have.
+    for (auto & _C : _Sim.BSCompartments) {
+        _C.ShapePtr = _Sim.Collection.GetGeometry(_C.ShapeID);
     }
-
-    // Reset and instantiate SCNeurons.
-    Neurons.clear();
-
-    size_t offset = 0;
-    for (size_t i = 0; i < _Loader._SaverInfo.NeuronsSize; i++) {
-        CoreStructs::SCNeuronStruct _N;
-        _N.FromFlat((CoreStructs::SCNeuronStructFlatHeader*) (_Loader.all_flatdata.get()+offset));
-        ID = AddSCNeuron(_N);
-        offset += _Loader.flatdata_sizes.get()[i];
+    for (auto & NeuronPtr : _Sim.Neurons) {
+        _Sim.LinkSCNeuron(static_cast<SCNeuron*>(NeuronPtr.get())->build_data);
+    }
+    for (auto & ReceptorPtr : _Sim.Receptors) {
+        _Sim.LinkReceptor(*ReceptorPtr);
     }
 
-    // Reset and instantiate receptors.
-    Receptors.clear();
+    // Reset and instantiate regions and neural circuits.
+    _Sim.NeuralCircuits.clear();
+    _Sim.Regions.clear();
 
-    for (size_t i = 0; i < _Loader._SaverInfo.ReceptorsSize; i++) {
-        Connections::Receptor _R(_Loader.ReceptorData.get()[i]);
-        _R.Name = "syn-"+std::to_string(i);
-        ID = AddReceptor(_R);
+    for (size_t i = 0; i < _Arrays.RegionsSize; i++) {
+        BrainRegions::BrainRegion _R(_Arrays.RegionData[i]);
+        _Sim.AddRegion(_R);
+        _Sim.NeuralCircuits.at(_R.CircuitID)->FromFlat((CoreStructs::NeuralCircuitStructFlatHeader*) (_Arrays.CircuitData + _Arrays.CircuitOffsets[i]));
     }
+}
 
-    // Reset and instantiate regions and neural circuits.
-    NeuralCircuits.clear();
-    Regions.clear();
+/**
+ * Load neuronal circuit specifications from file, replacing any
+ * previous specifications in this simulation object.
+ *
+ * Model files are mapped, their checksums verified, and their arrays used
+ * in place. Files saved before the model file format are read with the
+ * Loader. Both are only instantiated once they have been checked in full.
+ */
+bool Simulation::LoadModel(const std::string& Name) {
+    SavedModelArrays Arrays;
+    unsigned int HardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    Util::WorkerTeam Team((NumThreads > 0) ? NumThreads : HardwareThreads);
+
+    if (MappedModelFile::IsModelFile(Name)) {
+        MappedModelFile File;
+        if (!File.Open(Name, &Team)) {
+            Logger_->Log("Model file is corrupted, truncated or of an unsupported version: " + Name, 7);
+            return false;
+        }
+        Arrays.SGMap = File.Array<SaverGeometry>(MODELSECTION_GEOMETRY_MAP, Arrays.SGMapSize);
+        Arrays.SphereData = File.Array<Geometries::SphereBase>(MODELSECTION_SPHERES, Arrays.SphereSize);
+        Arrays.CylinderData = File.Array<Geometries::CylinderBase>(MODELSECTION_CYLINDERS, Arrays.CylinderSize);
+        Arrays.BoxData = File.Array<Geometries::BoxBase>(MODELSECTION_BOXES, Arrays.BoxSize);
+        Arrays.CompartmentData = File.Array<Compartments::BSBaseData>(MODELSECTION_COMPARTMENTS, Arrays.CompartmentsSize);
+        Arrays.ReceptorData = File.Array<Connections::ReceptorBase>(MODELSECTION_RECEPTORS, Arrays.ReceptorsSize);
+        Arrays.RegionData = File.Array<BrainRegions::RegionBase>(MODELSECTION_REGIONS, Arrays.RegionsSize);
+        Arrays.NeuronOffsets = File.Array<uint64_t>(MODELSECTION_NEURON_OFFSETS, Arrays.NeuronsSize);
+        Arrays.NeuronData = File.Array<uint8_t>(MODELSECTION_NEURON_DATA, Arrays.NeuronDataSize);
+        Arrays.CircuitOffsets = File.Array<uint64_t>(MODELSECTION_CIRCUIT_OFFSETS, Arrays.CircuitsSize);
+        Arrays.CircuitData = File.Array<uint8_t>(MODELSECTION_CIRCUIT_DATA, Arrays.CircuitDataSize);
+        // The offsets sections have one more entry than there are buffers.
+        Arrays.NeuronsSize = (Arrays.NeuronsSize > 0) ? Arrays.NeuronsSize - 1 : 0;
+        Arrays.CircuitsSize = (Arrays.CircuitsSize > 0) ? Arrays.CircuitsSize - 1 : 0;
+
+        if (!Arrays.IsConsistent()) {
+            Logger_->Log("Model file is corrupted: " + Name, 7);
+            return false;
+        }
+        InstantiateModel(*this, Arrays, Team);
 
-    offset = 0;
-    for (size_t i = 0; i < _Loader._SaverInfo.RegionsSize; i++) {
-        BrainRegions::BrainRegion _R(_Loader.RegionData.get()[i]);
-        ID = AddRegion(_R);
-        NeuralCircuits.at(_R.CircuitID)->FromFlat((CoreStructs::NeuralCircuitStructFlatHeader*) (_Loader.all_circuitdata.get()+offset));
-        offset += _Loader.circuitdata_sizes.get()[i];
+    } else {
+        Loader _Loader(Name);
+        if (!_Loader.Load()) return false;
+
+        // Legacy files list the sizes of the flat buffers, turn them into offsets.
+        std::vector<uint64_t> NeuronOffsets(1, 0);
+        for (size_t i = 0; i < _Loader._SaverInfo.NeuronsSize; i++) NeuronOffsets.emplace_back(NeuronOffsets.back() + _Loader.flatdata_sizes.get()[i]);
+        std::vector<uint64_t> CircuitOffsets(1, 0);
+        for (size_t i = 0; i < _Loader._SaverInfo.CircuitsSize; i++) CircuitOffsets.emplace_back(CircuitOffsets.back() + _Loader.circuitdata_sizes.get()[i]);
+
+        Arrays.SGMap = _Loader.SGMap.get();
+        Arrays.SGMapSize = _Loader._SaverInfo.SGMapSize;
+        Arrays.SphereData = _Loader.SphereData.get();
+        Arrays.SphereSize = _Loader._SaverInfo.SphereReferencesSize;
+        Arrays.CylinderData = _Loader.CylinderData.get();
+        Arrays.CylinderSize = _Loader._SaverInfo.CylinderReferencesSize;
+        Arrays.BoxData = _Loader.BoxData.get();
+        Arrays.BoxSize = _Loader._SaverInfo.BoxReferencesSize;
+        Arrays.CompartmentData = _Loader.CompartmentData.get();
+        Arrays.CompartmentsSize = _Loader._SaverInfo.BSSCCompartmentsSize;
+        Arrays.ReceptorData = _Loader.ReceptorData.get();
+        Arrays.ReceptorsSize = _Loader._SaverInfo.ReceptorsSize;
+        Arrays.RegionData = _Loader.RegionData.get();
+        Arrays.RegionsSize = _Loader._SaverInfo.RegionsSize;
+        Arrays.NeuronOffsets = NeuronOffsets.data();
+        Arrays.NeuronsSize = _Loader._SaverInfo.NeuronsSize;
+        Arrays.NeuronData = _Loader.all_flatdata.get();
+        Arrays.NeuronDataSize = NeuronOffsets.back();
+        Arrays.CircuitOffsets = CircuitOffsets.data();
+        Arrays.CircuitsSize = _Loader._SaverInfo.CircuitsSize;
+        Arrays.CircuitData = _Loader.all_circuitdata.get();
+        Arrays.CircuitDataSize = CircuitOffsets.back();
+
+        if (!Arrays.IsConsistent()) {
+            Logger_->Log("Model file is corrupted: " + Name, 7);
+            return false;
+        }
+        InstantiateModel(*this, Arrays, Team);
     }
 
     Show();
@@ -622,6 +858,401 @@ void Simulation::InspectSavedModel(const std::string& Name) const {
 
 }
 
+#define _CHECKPOINT_VERSION 1
+
+struct CheckpointInfo {
+    char Magic[8] = { 'B', 'G', 'N', 'E', 'S', 'C', 'K', 'P' };
+    uint32_t Version = _CHECKPOINT_VERSION;
+    int32_t RandomSeed = 0;
+    float T_ms = 0.0;
+    float Dt_ms = 0.0;
+    float StartRecordTime_ms = 0.0;
+    float MaxRecordTime_ms = 0.0;
+    float InstrumentsStartRecordTime_ms = 0.0;
+    float InstrumentsMaxRecordTime_ms = 0.0;
+    size_t NeuronsSize = 0;
+    size_t ReceptorsSize = 0;
+    size_t ElectrodesSize = 0;
+    size_t RandomStateSize = 0;
+    size_t VectorSizesSize = 0;
+    size_t VectorDataSize = 0;
+    size_t RecordingFileSize = 0;
+    size_t RecorderStateSize = 0;
+    size_t InstrumentsRecordingFileSize = 0;
+    size_t InstrumentsRecorderStateSize = 0;
+};
+
+//! Fixed-size dynamic state of a BSNeuron.
+struct NeuronCheckpoint {
+    float Vm_mV = 0.0;
+    float T_ms = 0.0;
+    float TSpontNext_ms = 0.0;
+    float DtAct_ms = 0.0;
+    float TauSpontMean_ms = 0.0;
+    float TauSpontStdev_ms = 0.0;
+    float CaAlphaRise = 0.0;
+    float CaAlphaDecay = 0.0;
+    float CaScale = 0.0;
+    float CaStateRise = 0.0;
+    float CaStateDecay = 0.0;
+    uint8_t HasSpiked = 0;
+    uint8_t InAbsRef = 0;
+    uint8_t CaFilterEnabled = 0;
+    uint8_t HasSpontDist = 0;
+    uint64_t SpontKey = 0;
+    uint64_t SpontDraws = 0;
+};
+
+/**
+ * Save the dynamic state of the simulation to file, so that a run can be
+ * continued from it by LoadCheckpoint() on the same model.
+ *
+ * Checkpoint file structure is:
+ *  1. CheckpointInfo
+ *  2. Random generator states as text (CheckpointInfo.RandomStateSize chars)
+ *  3. NeuronCheckpoint[] (CheckpointInfo.NeuronsSize elements)
+ *  4. Receptor Conductance_nS[] (CheckpointInfo.ReceptorsSize elements)
+ *  5. Number of sites of each electrode (CheckpointInfo.ElectrodesSize elements)
+ *  6. vector_sizes[] (CheckpointInfo.VectorSizesSize elements)
+ *  7. concatenated float vectors (CheckpointInfo.VectorDataSize elements)
+ *  8. Recording file path and ColumnRecorder::GetState()
+ *  9. Instruments recording file path and ColumnRecorder::GetState()
+ *
+ * The vectors in 6. and 7. are, in order, TRecorded_ms, TInstruments_ms and
+ * the Ca imaging TRecorded_ms, then TAct_ms, TDirectStim_ms, CaSamples,
+ * TCaSamples_ms, TRecorded_ms and VmRecorded_mV of each neuron, then
+ * TRecorded_ms and E_mV of each site of each electrode.
+ *
+ * Spontaneous activity intervals are drawn from counter-based streams,
+ * so their generator state is the key and the number of draws.
+ */
+bool Simulation::SaveCheckpoint(const std::string& Name) {
+    CheckpointInfo Info;
+    Info.RandomSeed = RandomSeed;
+    Info.T_ms = T_ms;
+    Info.Dt_ms = Dt_ms;
+    Info.StartRecordTime_ms = StartRecordTime_ms;
+    Info.MaxRecordTime_ms = MaxRecordTime_ms;
+    Info.InstrumentsStartRecordTime_ms = InstrumentsStartRecordTime_ms;
+    Info.InstrumentsMaxRecordTime_ms = InstrumentsMaxRecordTime_ms;
+    Info.NeuronsSize = Neurons.size();
+    Info.ReceptorsSize = Receptors.size();
+    Info.ElectrodesSize = RecordingElectrodes.size();
+
+    std::stringstream RandomState;
+    RandomState << (MasterRandom_ ? MasterRandom_->GetState() : std::string()) << '\n';
+    for (auto & Electrode : RecordingElectrodes) {
+        RandomState << Electrode->NoiseGen << '\n';
+    }
+    std::string RandomStateStr = RandomState.str();
+    Info.RandomStateSize = RandomStateStr.size();
+
+    std::vector<NeuronCheckpoint> NeuronData(Neurons.size());
+    std::vector<std::vector<float>> DirectStims(Neurons.size());
+    std::vector<const std::vector<float>*> Vectors = { &TRecorded_ms, &TInstruments_ms, &CaData_.CaImaging.TRecorded_ms };
+    for (size_t i = 0; i < Neurons.size(); i++) {
+        if (!Neurons[i] || (Neurons[i]->Class_ < CoreStructs::_BSNeuron)) {
+            Logger_->Log("Checkpoints require all neurons to be instantiated ball-and-stick neurons", 7);
+            return false;
+        }
+        BallAndStick::BSNeuron* N = static_cast<BallAndStick::BSNeuron*>(Neurons[i].get());
+        NeuronCheckpoint& C = NeuronData[i];
+        C.Vm_mV = N->Vm_mV;
+        C.T_ms = N->T_ms;
+        C.TSpontNext_ms = N->TSpontNext_ms;
+        C.DtAct_ms = N->_dt_act_ms;
+        C.TauSpontMean_ms = N->TauSpont_ms.mean;
+        C.TauSpontStdev_ms = N->TauSpont_ms.stdev;
+        C.CaAlphaRise = N->CaAlphaRise;
+        C.CaAlphaDecay = N->CaAlphaDecay;
+        C.CaScale = N->CaScale;
+        C.CaStateRise = N->CaStateRise;
+        C.CaStateDecay = N->CaStateDecay;
+        C.HasSpiked = N->_has_spiked;
+        C.InAbsRef = N->in_absref;
+        C.CaFilterEnabled = N->CaFilterEnabled;
+        C.HasSpontDist = bool(N->DtSpontDist);
+        C.SpontKey = N->SpontKey;
+        C.SpontDraws = N->SpontDraws;
+
+        DirectStims[i].assign(N->TDirectStim_ms.begin(), N->TDirectStim_ms.end());
+        Vectors.insert(Vectors.end(), { &N->TAct_ms, &DirectStims[i], &N->CaSamples, &N->TCaSamples_ms, &N->TRecorded_ms, &N->VmRecorded_mV });
+    }
+
+    std::vector<float> Conductance_nS(Receptors.size());
+    for (size_t i = 0; i < Receptors.size(); i++) {
+        Conductance_nS[i] = Receptors[i]->Conductance_nS;
+    }
+
+    std::vector<uint64_t> ElectrodeSites;
+    for (auto & Electrode : RecordingElectrodes) {
+        ElectrodeSites.emplace_back(Electrode->E_mV.size());
+        Vectors.emplace_back(&Electrode->TRecorded_ms);
+        for (auto & E_mV : Electrode->E_mV) Vectors.emplace_back(&E_mV);
+    }
+
+    std::vector<uint64_t> VectorSizes;
+    for (const std::vector<float>* V : Vectors) {
+        VectorSizes.emplace_back(V->size());
+        Info.VectorDataSize += V->size();
+    }
+    Info.VectorSizesSize = VectorSizes.size();
+
+    // Recordings that stream into files continue in those files.
+    std::unique_lock<std::mutex> RecordersLock(RecordersMutex_);
+    std::string RecorderPath = Recorder.IsOpen() ? Recorder.Path() : std::string();
+    std::vector<uint64_t> RecorderState = Recorder.GetState();
+    std::string InstrumentsRecorderPath = InstrumentsRecorder.IsOpen() ? InstrumentsRecorder.Path() : std::string();
+    std::vector<uint64_t> InstrumentsRecorderState = InstrumentsRecorder.GetState();
+    Recorder.Sync();
+    InstrumentsRecorder.Sync();
+    RecordersLock.unlock();
+    Info.RecordingFileSize = RecorderPath.size();
+    Info.RecorderStateSize = RecorderState.size();
+    Info.InstrumentsRecordingFileSize = InstrumentsRecorderPath.size();
+    Info.InstrumentsRecorderStateSize = InstrumentsRecorderState.size();
+
+    auto SaveFile = std::fstream(Name, std::ios::out | std::ios::binary);
+    SaveFile.write((char*)&Info, sizeof(Info));
+    SaveFile.write(RandomStateStr.data(), RandomStateStr.size());
+    SaveFile.write((char*)NeuronData.data(), sizeof(NeuronCheckpoint)*NeuronData.size());
+    SaveFile.write((char*)Conductance_nS.data(), sizeof(float)*Conductance_nS.size());
+    SaveFile.write((char*)ElectrodeSites.data(), sizeof(uint64_t)*ElectrodeSites.size());
+    SaveFile.write((char*)VectorSizes.data(), sizeof(uint64_t)*VectorSizes.size());
+    for (const std::vector<float>* V : Vectors) {
+        SaveFile.write((char*)V->data(), sizeof(float)*V->size());
+    }
+    SaveFile.write(RecorderPath.data(), RecorderPath.size());
+    SaveFile.write((char*)RecorderState.data(), sizeof(uint64_t)*RecorderState.size());
+    SaveFile.write(InstrumentsRecorderPath.data(), InstrumentsRecorderPath.size());
+    SaveFile.write((char*)InstrumentsRecorderState.data(), sizeof(uint64_t)*InstrumentsRecorderState.size());
+
+    SaveFile.close();
+    return SaveFile.good();
+}
+
+/**
+ * Load the dynamic state of the simulation from a file written by
+ * SaveCheckpoint(). The model must already be built or loaded, with the
+ * same neurons, receptors and electrodes as when the checkpoint was saved.
+ *
+ * Everything is read, checked and staged before any state is changed, so
+ * that a checkpoint that can not be restored leaves the simulation as it
+ * was.
+ */
+bool Simulation::LoadCheckpoint(const std::string& Name) {
+    auto LoadFile = std::fstream(Name, std::ios::in | std::ios::binary | std::ios::ate);
+    uint64_t Remaining = LoadFile.good() ? uint64_t(LoadFile.tellg()) : 0;
+    LoadFile.seekg(0);
+    CheckpointInfo Info;
+    LoadFile.read((char*)&Info, sizeof(Info));
+    if (!LoadFile.good() || (std::memcmp(Info.Magic, CheckpointInfo().Magic, sizeof(Info.Magic)) != 0) || (Info.Version != _CHECKPOINT_VERSION)) {
+        Logger_->Log("Not a checkpoint file of a supported version: " + Name, 7);
+        return false;
+    }
+    Remaining -= sizeof(Info);
+    if ((Info.NeuronsSize != Neurons.size()) || (Info.ReceptorsSize != Receptors.size()) || (Info.ElectrodesSize != RecordingElectrodes.size())) {
+        Logger_->Log("Checkpoint does not match the neurons, receptors and electrodes of this simulation", 7);
+        return false;
+    }
+    for (auto & NeuronPtr : Neurons) {
+        if (!NeuronPtr || (NeuronPtr->Class_ < CoreStructs::_BSNeuron)) {
+            Logger_->Log("Checkpoints require all neurons to be instantiated ball-and-stick neurons", 7);
+            return false;
+        }
+    }
+    size_t NumVectors = 3 + 6*Info.NeuronsSize;
+    for (auto & Electrode : RecordingElectrodes) {
+        NumVectors += 1 + Electrode->E_mV.size();
+    }
+    if (Info.VectorSizesSize != NumVectors) {
+        Logger_->Log("Checkpoint does not match the electrode sites of this simulation", 7);
+        return false;
+    }
+
+    // Every section has to fit in the rest of the file before it is allocated.
+    auto Take = [&Remaining](uint64_t _Count, size_t _ElementSize) {
+        if (_Count > Remaining / _ElementSize) return false;
+        Remaining -= _Count * _ElementSize;
+        return true;
+    };
+    if (!Take(Info.RandomStateSize, 1)
+        || !Take(Info.NeuronsSize, sizeof(NeuronCheckpoint))
+        || !Take(Info.ReceptorsSize, sizeof(float))
+        || !Take(Info.ElectrodesSize, sizeof(uint64_t))
+        || !Take(Info.VectorSizesSize, sizeof(uint64_t))
+        || !Take(Info.VectorDataSize, sizeof(float))
+        || !Take(Info.RecordingFileSize, 1)
+        || !Take(Info.RecorderStateSize, sizeof(uint64_t))
+        || !Take(Info.InstrumentsRecordingFileSize, 1)
+        || !Take(Info.InstrumentsRecorderStateSize, sizeof(uint64_t))) {
+        Logger_->Log("Checkpoint file is truncated: " + Name, 7);
+        return false;
+    }
+
+    std::string RandomStateStr(Info.RandomStateSize, '\0');
+    LoadFile.read(RandomStateStr.data(), RandomStateStr.size());
+    std::vector<NeuronCheckpoint> NeuronData(Info.NeuronsSize);
+    LoadFile.read((char*)NeuronData.data(), sizeof(NeuronCheckpoint)*NeuronData.size());
+    std::vector<float> Conductance_nS(Info.ReceptorsSize);
+    LoadFile.read((char*)Conductance_nS.data(), sizeof(float)*Conductance_nS.size());
+    std::vector<uint64_t> ElectrodeSites(Info.ElectrodesSize);
+    LoadFile.read((char*)ElectrodeSites.data(), sizeof(uint64_t)*ElectrodeSites.size());
+    std::vector<uint64_t> VectorSizes(Info.VectorSizesSize);
+    LoadFile.read((char*)VectorSizes.data(), sizeof(uint64_t)*VectorSizes.size());
+    std::vector<float> VectorData(Info.VectorDataSize);
+    LoadFile.read((char*)VectorData.data(), sizeof(float)*VectorData.size());
+    std::string RecorderPath(Info.RecordingFileSize, '\0');
+    LoadFile.read(RecorderPath.data(), RecorderPath.size());
+    std::vector<uint64_t> RecorderState(Info.RecorderStateSize);
+    LoadFile.read((char*)RecorderState.data(), sizeof(uint64_t)*RecorderState.size());
+    std::string InstrumentsRecorderPath(Info.InstrumentsRecordingFileSize, '\0');
+    LoadFile.read(InstrumentsRecorderPath.data(), InstrumentsRecorderPath.size());
+    std::vector<uint64_t> InstrumentsRecorderState(Info.InstrumentsRecorderStateSize);
+    LoadFile.read((char*)InstrumentsRecorderState.data(), sizeof(uint64_t)*InstrumentsRecorderState.size());
+    if (!LoadFile.good()) {
+        Logger_->Log("Checkpoint file is truncated: " + Name, 7);
+        return false;
+    }
+
+    for (size_t e = 0; e < ElectrodeSites.size(); e++) {
+        if (ElectrodeSites[e] != RecordingElectrodes[e]->E_mV.size()) {
+            Logger_->Log("Checkpoint does not match the electrode sites of this simulation", 7);
+            return false;
+        }
+    }
+    uint64_t TotalVectorData = 0;
+    for (uint64_t Size : VectorSizes) {
+        if (Size > VectorData.size() - TotalVectorData) {
+            Logger_->Log("Checkpoint vector table is inconsistent: " + Name, 7);
+            return false;
+        }
+        TotalVectorData += Size;
+    }
+    if (TotalVectorData != VectorData.size()) {
+        Logger_->Log("Checkpoint vector table is inconsistent: " + Name, 7);
+        return false;
+    }
+
+    // Stage the generator states and the recorders, the only parts that can
+    // still fail.
+    std::stringstream RandomState(RandomStateStr);
+    std::string MasterRandomState;
+    std::getline(RandomState, MasterRandomState);
+    std::unique_ptr<Distributions::Generic> MasterRandom;
+    if (!MasterRandomState.empty()) {
+        MasterRandom = std::make_unique<Distributions::Generic>(Info.RandomSeed);
+        if (!MasterRandom->SetState(MasterRandomState)) {
+            Logger_->Log("Checkpoint random generator state is invalid: " + Name, 7);
+            return false;
+        }
+    }
+    std::vector<std::mt19937> NoiseGens(RecordingElectrodes.size());
+    for (auto & NoiseGen : NoiseGens) {
+        RandomState >> NoiseGen;
+    }
+    if (RandomState.fail()) {
+        Logger_->Log("Checkpoint random generator state is invalid: " + Name, 7);
+        return false;
+    }
+
+    // Streamed recordings continue in their files, others are opened fresh
+    // by the next RunFor.
+    std::lock_guard<std::mutex> Lock(RecordersMutex_);
+    Tools::ColumnRecorder ResumedRecorder;
+    if (!RecorderPath.empty() && !ResumedRecorder.Resume(RecorderPath, RecorderState)) {
+        Logger_->Log("Unable to resume recording file " + RecorderPath, 7);
+        return false;
+    }
+    Tools::ColumnRecorder ResumedInstrumentsRecorder;
+    if (!InstrumentsRecorderPath.empty() && !ResumedInstrumentsRecorder.Resume(InstrumentsRecorderPath, InstrumentsRecorderState)) {
+        Logger_->Log("Unable to resume recording file " + InstrumentsRecorderPath, 7);
+        return false;
+    }
+
+    // Nothing below can fail.
+    RandomSeed = Info.RandomSeed;
+    if (MasterRandom) {
+        MasterRandom_ = std::move(MasterRandom);
+    }
+    for (size_t e = 0; e < RecordingElectrodes.size(); e++) {
+        RecordingElectrodes[e]->NoiseGen = NoiseGens[e];
+    }
+
+    T_ms = Info.T_ms;
+    Dt_ms = Info.Dt_ms;
+    StartRecordTime_ms = Info.StartRecordTime_ms;
+    MaxRecordTime_ms = Info.MaxRecordTime_ms;
+    InstrumentsStartRecordTime_ms = Info.InstrumentsStartRecordTime_ms;
+    InstrumentsMaxRecordTime_ms = Info.InstrumentsMaxRecordTime_ms;
+
+    const float* Data = VectorData.data();
+    const uint64_t* Size = VectorSizes.data();
+    auto NextVector = [&Data, &Size](auto& _Vector) {
+        _Vector.assign(Data, Data + *Size);
+        Data += *Size;
+        Size++;
+    };
+
+    NextVector(TRecorded_ms);
+    NextVector(TInstruments_ms);
+    NextVector(CaData_.CaImaging.TRecorded_ms);
+
+    for (size_t i = 0; i < Neurons.size(); i++) {
+        BallAndStick::BSNeuron* N = static_cast<BallAndStick::BSNeuron*>(Neurons[i].get());
+        const NeuronCheckpoint& C = NeuronData[i];
+        if (C.HasSpontDist) {
+            // The seed is the low half of the key, see BSNeuron::SetSpontaneousActivity().
+            N->SetSpontaneousActivity(C.TauSpontMean_ms, C.TauSpontStdev_ms, int(uint32_t(C.SpontKey)));
+        } else {
+            N->DtSpontDist.reset();
+            N->TauSpont_ms = BallAndStick::SpontaneousActivityPars();
+        }
+        N->Vm_mV = C.Vm_mV;
+        N->T_ms = C.T_ms;
+        N->TSpontNext_ms = C.TSpontNext_ms;
+        N->_dt_act_ms = C.DtAct_ms;
+        N->CaAlphaRise = C.CaAlphaRise;
+        N->CaAlphaDecay = C.CaAlphaDecay;
+        N->CaScale = C.CaScale;
+        N->CaStateRise = C.CaStateRise;
+        N->CaStateDecay = C.CaStateDecay;
+        N->_has_spiked = C.HasSpiked;
+        N->in_absref = C.InAbsRef;
+        N->CaFilterEnabled = C.CaFilterEnabled;
+        N->SpontKey = C.SpontKey;
+        N->SpontDraws = C.SpontDraws;
+
+        NextVector(N->TAct_ms);
+        NextVector(N->TDirectStim_ms);
+        NextVector(N->CaSamples);
+        NextVector(N->TCaSamples_ms);
+        NextVector(N->TRecorded_ms);
+        NextVector(N->VmRecorded_mV);
+    }
+
+    for (size_t i = 0; i < Receptors.size(); i++) {
+        Receptors[i]->Conductance_nS = Conductance_nS[i];
+    }
+
+    for (auto & Electrode : RecordingElectrodes) {
+        NextVector(Electrode->TRecorded_ms);
+        for (auto & E_mV : Electrode->E_mV) NextVector(E_mV);
+    }
+
+    // The recorders that were open are closed when the staged ones go out of scope.
+    if (!RecorderPath.empty()) {
+        RecordingFile = RecorderPath;
+    }
+    Recorder.Swap(ResumedRecorder);
+    if (!InstrumentsRecorderPath.empty()) {
+        InstrumentsRecordingFile = InstrumentsRecorderPath;
+    }
+    InstrumentsRecorder.Swap(ResumedInstrumentsRecorder);
+
+    return true;
+}
+
 size_t Simulation::GetTotalNumberOfNeurons() {
     return Neurons.size();
     // size_t long num_neurons = 0;
@@ -716,27 +1347,30 @@ bool Simulation::UpdatePrePostStrength(int PresynapticID, int PostsynapticID, fl
     CoreStructs::Neuron* PostsynapticPtr = Neurons.at(PostsynapticID).get();
     if (PostsynapticPtr->Class_<CoreStructs::_BSNeuron) return false;
 
-    Connections::Receptor* Rptr = nullptr;
-    for (auto& _ReceptorData : static_cast<BallAndStick::BSNeuron*>(PostsynapticPtr)->ReceptorDataVec) {
-        if (_ReceptorData.SrcNeuronID==PresynapticID) {
-            Rptr = _ReceptorData.ReceptorPtr;       // Remember the last one.
-            if (Rptr) Rptr->Conductance_nS = 0.0;   // Clear.
-        }
-    }
-    if (!Rptr) return false;
+    // The receptors of the pair in ID order, i.e. in ReceptorDataVec order.
+    Connections::SynapseIndex::Row PairReceptors = ReceptorIndex.Between(PresynapticID, PostsynapticID);
+    if (PairReceptors.Size == 0) return false;
 
-    Rptr->Conductance_nS = NewConductance_nS;
+    for (size_t i = 0; i < PairReceptors.Size; i++) {
+        Receptors[PairReceptors.Receptor[i]]->Conductance_nS = 0.0; // Clear.
+    }
+    Receptors[PairReceptors.Receptor[PairReceptors.Size - 1]]->Conductance_nS = NewConductance_nS; // The last one.
     return true;
 }
 
 /**
  * This is particularly useful for clearing all effective connection
  * strengths before setting specific ones.
+ * Same as UpdatePrePostStrength() for every connected pair, in O(receptors).
  */
 void Simulation::UpdateAllStrength(float NewConductance_nS) {
     for (int PostSynIdx = 0; PostSynIdx < Neurons.size(); PostSynIdx++) {
-        for (int PreSynIdx = 0; PreSynIdx < Neurons.size(); PreSynIdx++) {
-            UpdatePrePostStrength(PreSynIdx, PostSynIdx, NewConductance_nS);
+        if (Neurons.at(PostSynIdx)->Class_<CoreStructs::_BSNeuron) continue;
+
+        Connections::SynapseIndex::Row PostReceptors = ReceptorIndex.ByPost(PostSynIdx);
+        for (size_t i = 0; i < PostReceptors.Size; i++) {
+            bool LastOfPair = (i + 1 == PostReceptors.Size) || (PostReceptors.Neuron[i + 1] != PostReceptors.Neuron[i]);
+            Receptors[PostReceptors.Receptor[i]]->Conductance_nS = LastOfPair ? NewConductance_nS : 0.0;
         }
     }
 }
@@ -802,6 +1436,65 @@ bool Simulation::IsRecording() const {
     return this->T_ms < (this->StartRecordTime_ms + this->MaxRecordTime_ms);
 };
 
+void Simulation::SetRecordingFile(const std::string & _Path, Tools::ColumnSignal _Signal, const std::map<int, Tools::ColumnSignal> & _NeuronSignals) {
+    std::lock_guard<std::mutex> Lock(RecordersMutex_);
+    Recorder.Close();
+    RecordingFile = _Path;
+    RecordingSignal = _Signal;
+    RecordingNeuronSignals = _NeuronSignals;
+}
+
+void Simulation::SetInstrumentsRecordingFile(const std::string & _Path, Tools::ColumnSignal _Signal) {
+    std::lock_guard<std::mutex> Lock(RecordersMutex_);
+    InstrumentsRecorder.Close();
+    InstrumentsRecordingFile = _Path;
+    InstrumentsRecordingSignal = _Signal;
+}
+
+//! Opens the configured recording files that are not open yet, pre-sized
+//! for the steps of a run of tRun_ms. The columns are fixed when a file is
+//! opened, neurons and electrodes added later are not recorded into it.
+//! Returns false if a file could not be opened, that recording then stays
+//! in memory.
+bool Simulation::OpenRecorders(float tRun_ms) {
+    assert(Logger_ != nullptr);
+    bool Success = true;
+
+    auto ExpectedSteps = [this, tRun_ms](float _MaxRecordTime_ms) {
+        float tExpected_ms = (_MaxRecordTime_ms < 0) ? tRun_ms : std::min(tRun_ms, _MaxRecordTime_ms);
+        return size_t(std::max(tExpected_ms, 0.0f) / Dt_ms) + 1;
+    };
+
+    if (!RecordingFile.empty() && !Recorder.IsOpen() && (MaxRecordTime_ms != 0.0)) {
+        std::vector<Tools::ColumnSignal> Signals(1 + Neurons.size(), RecordingSignal);
+        Signals[0] = Tools::ColumnSignal();
+        for (size_t i = 0; i < Neurons.size(); i++) {
+            if (!Neurons[i]) continue;
+            auto it = RecordingNeuronSignals.find(Neurons[i]->ID);
+            if (it != RecordingNeuronSignals.end()) Signals[1 + i] = it->second;
+        }
+        if (!Recorder.Open(RecordingFile, Signals, ExpectedSteps(MaxRecordTime_ms))) {
+            Logger_->Log("Unable to open recording file " + RecordingFile + ", recording to memory instead", 7);
+            Success = false;
+        }
+    }
+
+    if (!InstrumentsRecordingFile.empty() && !InstrumentsRecorder.IsOpen() && (InstrumentsMaxRecordTime_ms != 0.0)) {
+        size_t NumSites = 0;
+        for (auto & Electrode : RecordingElectrodes) {
+            NumSites += Electrode->SiteLocations_um.size();
+        }
+        std::vector<Tools::ColumnSignal> Signals(1 + NumSites, InstrumentsRecordingSignal);
+        Signals[0] = Tools::ColumnSignal();
+        if (!InstrumentsRecorder.Open(InstrumentsRecordingFile, Signals, ExpectedSteps(InstrumentsMaxRecordTime_ms))) {
+            Logger_->Log("Unable to open recording file " + InstrumentsRecordingFile + ", recording to memory instead", 7);
+            Success = false;
+        }
+    }
+
+    return Success;
+}
+
 // *** THIS IS NOT USED BY THE API CALL
 std::unordered_map<std::string, CoreStructs::CircuitRecording> Simulation::GetRecording() {
     std::unordered_map<std::string, CoreStructs::CircuitRecording> recording;
@@ -826,8 +1519,27 @@ nlohmann::json Simulation::GetSpikeTimesJSON() const {
 }
 
 nlohmann::json Simulation::GetRecordingJSON() const {
+    std::lock_guard<std::mutex> Lock(RecordersMutex_);
     nlohmann::json recording;
 
+    // Streamed recordings are read back from the recording file.
+    if (Recorder.IsOpen()) {
+        recording["t_ms"] = nlohmann::json(Recorder.ReadColumn(0));
+        recording["neurons"] = nlohmann::json::object();
+        size_t NumNeurons = std::min(Neurons.size(), Recorder.NumColumns() - 1);
+        for (size_t i = 0; i < NumNeurons; i++) {
+            if (!Neurons[i]) continue;
+            nlohmann::json & neuron_recording = recording["neurons"][std::to_string(Neurons[i]->ID)];
+            neuron_recording["Vm_mV"] = nlohmann::json(Recorder.ReadColumn(1 + i));
+            const Tools::ColumnSignal & Signal = Recorder.Signal(1 + i);
+            if (Signal != Tools::ColumnSignal()) {
+                neuron_recording["Decimation"] = Signal.Factor;
+                neuron_recording["MinMax"] = (Signal.Mode == Tools::DOWNSAMPLE_MINMAX);
+            }
+        }
+        return recording;
+    }
+
     recording["t_ms"] = nlohmann::json(this->TRecorded_ms);
 
     // *** The by-neural-circuit version is presently not being used.
@@ -880,15 +1592,32 @@ bool Simulation::InstrumentsAreRecording() const {
 }
 
 nlohmann::json Simulation::GetInstrumentsRecordingJSON() const {
+    std::lock_guard<std::mutex> Lock(RecordersMutex_);
     nlohmann::json recording;
 
-    recording["t_ms"] = nlohmann::json(this->TInstruments_ms);
-
     // Virtual experimental functional data from recording electrodes
-    if (!RecordingElectrodes.empty()) {
+    if (InstrumentsRecorder.IsOpen()) {
+        recording["t_ms"] = nlohmann::json(InstrumentsRecorder.ReadColumn(0));
         recording["Electrodes"] = nlohmann::json::object();
+        size_t Column = 1;
         for (const auto & Electrode : RecordingElectrodes) {
-            recording["Electrodes"][Electrode->Name] = Electrode->GetRecordingJSON();
+            nlohmann::json & electrode_recording = recording["Electrodes"][Electrode->Name];
+            electrode_recording["E_mV"] = nlohmann::json::array();
+            for (size_t s = 0; (s < Electrode->SiteLocations_um.size()) && (Column < InstrumentsRecorder.NumColumns()); s++, Column++) {
+                electrode_recording["E_mV"][s] = InstrumentsRecorder.ReadColumn(Column);
+            }
+        }
+        if (InstrumentsRecordingSignal != Tools::ColumnSignal()) {
+            recording["Decimation"] = InstrumentsRecordingSignal.Factor;
+            recording["MinMax"] = (InstrumentsRecordingSignal.Mode == Tools::DOWNSAMPLE_MINMAX);
+        }
+    } else {
+        recording["t_ms"] = nlohmann::json(this->TInstruments_ms);
+        if (!RecordingElectrodes.empty()) {
+            recording["Electrodes"] = nlohmann::json::object();
+            for (const auto & Electrode : RecordingElectrodes) {
+                recording["Electrodes"][Electrode->Name] = Electrode->GetRecordingJSON();
+            }
         }
     }
 
@@ -985,17 +1714,13 @@ size_t Simulation::GetAbstractConnection(int PreSynID, int PostSynID, bool NonZe
     CoreStructs::Neuron* PostsynapticPtr = Neurons.at(PostSynID).get();
     if (PostsynapticPtr->Class_<CoreStructs::_BSNeuron) return 0;
 
+    Connections::SynapseIndex::Row PairReceptors = ReceptorIndex.Between(PreSynID, PostSynID);
+    if (!NonZero) return PairReceptors.Size;
+
     size_t NumReceptors = 0;
-    Connections::Receptor* Rptr = nullptr;
-    for (auto& _ReceptorData : static_cast<BallAndStick::BSNeuron*>(PostsynapticPtr)->ReceptorDataVec) {
-        if (_ReceptorData.SrcNeuronID==PreSynID) {
-            if (NonZero) {
-                if (_ReceptorData.ReceptorPtr->Conductance_nS!=0.0) {
-                    NumReceptors++;
-                }
-            } else {
-                NumReceptors++;
-            }
+    for (size_t i = 0; i < PairReceptors.Size; i++) {
+        if (Receptors[PairReceptors.Receptor[i]]->Conductance_nS!=0.0) {
+            NumReceptors++;
         }
     }
 
@@ -1003,25 +1728,78 @@ size_t Simulation::GetAbstractConnection(int PreSynID, int PostSynID, bool NonZe
 }
 
 /**
- * Loop through all possible combinations of presynaptic and
- * postsynaptic neurons and count the number of receptors involved
- * in connections between each pair.
- * Note that the columns are presynaptic indices while the rows are
- * postsynaptic indices.
+ * Count the receptors between each pair of connected neurons, as a list
+ * of connections sorted by presynaptic and then postsynaptic index, i.e.
+ * the rows of a CSR matrix with presynaptic rows.
+ * Only pairs with at least one receptor are listed, so the list grows
+ * with the number of receptors instead of the number of neurons squared.
+ * The presynaptic neurons are split into ranges with about the same
+ * number of receptors, which are counted concurrently. As the ranges are
+ * ordered, their lists are merged by concatenating them.
  * If the NonZero flag is set then only receptors with non-zero
  * conductance are included, i.e. are considered active receptors.
  */
-std::vector<std::vector<size_t>> Simulation::GetAbstractConnectome(bool NonZero) const {
-    std::vector<std::vector<size_t>> PrePostReceptorCounts(
-        Neurons.size(),
-        std::vector<size_t>(Neurons.size(), 0));
-    for (int PostSynIdx = 0; PostSynIdx < Neurons.size(); PostSynIdx++) {
-        for (int PreSynIdx = 0; PreSynIdx < Neurons.size(); PreSynIdx++) {
-            size_t NumReceptors = GetAbstractConnection(PreSynIdx, PostSynIdx, NonZero);
-            PrePostReceptorCounts[PostSynIdx][PreSynIdx] = NumReceptors;
+std::vector<AbstractConnection> Simulation::GetAbstractConnectome(bool NonZero) const {
+    // Querying the index merges pending receptors, so that the members
+    // below only read it.
+    size_t NumPreSyn = std::min(ReceptorIndex.NumNeurons(), Neurons.size());
+    size_t NumReceptors = ReceptorIndex.Size();
+    size_t MaxMembers = (NumThreads > 0) ? NumThreads : std::max(std::thread::hardware_concurrency(), 1u);
+    size_t NumMembers = std::clamp<size_t>(NumReceptors / _ABSTRACT_CONNECTOME_RECEPTORS_PER_THREAD, 1, MaxMembers);
+
+    std::vector<size_t> RangeBegin(NumMembers + 1, NumPreSyn);
+    RangeBegin[0] = 0;
+    size_t Member = 1;
+    size_t CumulativeReceptors = 0;
+    for (size_t PreSynIdx = 0; (PreSynIdx < NumPreSyn) && (Member < NumMembers); PreSynIdx++) {
+        if (CumulativeReceptors >= NumReceptors * Member / NumMembers) {
+            RangeBegin[Member++] = PreSynIdx;
         }
+        CumulativeReceptors += ReceptorIndex.ByPre(PreSynIdx).Size;
+    }
+
+    // Walk the presynaptic rows of the receptor index, whose entries are
+    // grouped by postsynaptic neuron, so no dense matrix is needed.
+    std::vector<std::vector<AbstractConnection>> MemberConnections(NumMembers);
+    auto CountRange = [&](size_t _Member) {
+        std::vector<AbstractConnection>& Connections = MemberConnections[_Member];
+        for (size_t PreSynIdx = RangeBegin[_Member]; PreSynIdx < RangeBegin[_Member + 1]; PreSynIdx++) {
+            Connections::SynapseIndex::Row PreReceptors = ReceptorIndex.ByPre(PreSynIdx);
+            size_t i = 0;
+            while (i < PreReceptors.Size) {
+                int PostSynIdx = PreReceptors.Neuron[i];
+                uint32_t ReceptorCount = 0;
+                for (; (i < PreReceptors.Size) && (PreReceptors.Neuron[i] == PostSynIdx); i++) {
+                    if (NonZero && (Receptors[PreReceptors.Receptor[i]]->Conductance_nS==0.0)) continue;
+                    ReceptorCount++;
+                }
+                if (PostSynIdx >= Neurons.size()) continue;
+                if (Neurons[PostSynIdx]->Class_<CoreStructs::_BSNeuron) continue;
+
+                if (ReceptorCount>0) {
+                    Connections.push_back(AbstractConnection{ int32_t(PreSynIdx), PostSynIdx, ReceptorCount });
+                }
+            }
+        }
+    };
+    if (NumMembers == 1) {
+        CountRange(0);
+        return std::move(MemberConnections[0]);
+    }
+    Util::WorkerTeam Team(NumMembers);
+    Team.Run(CountRange);
+
+    size_t NumConnections = 0;
+    for (const auto& Connections : MemberConnections) {
+        NumConnections += Connections.size();
     }
-    return PrePostReceptorCounts;
+    std::vector<AbstractConnection> Connectome;
+    Connectome.reserve(NumConnections);
+    for (auto& Connections : MemberConnections) {
+        Connectome.insert(Connectome.end(), Connections.begin(), Connections.end());
+        std::vector<AbstractConnection>().swap(Connections);
+    }
+    return Connectome;
 }
 
 /**
@@ -1031,7 +1809,6 @@ std::vector<std::vector<size_t>> Simulation::GetAbstractConnectome(bool NonZero)
  * index is the presynaptic index: data[PreSynIdx][PostSynIdx].
  */
 nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero) const {
-    auto PrePostReceptorCounts = GetAbstractConnectome(NonZero);
     nlohmann::json connectome;
     connectome["PrePostNumReceptors"] = nlohmann::json::array();
     nlohmann::json& reccntlist(connectome["PrePostNumReceptors"]);
@@ -1040,29 +1817,32 @@ nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero)
     connectome["Types"] = nlohmann::json::array();
     nlohmann::json& typeslist(connectome["Types"]);
 
-    for (size_t PreSynIdx = 0; PreSynIdx<PrePostReceptorCounts.size(); PreSynIdx++) {
-        nlohmann::json frompresynreccntvec(nlohmann::json::value_t::array);
-        for (size_t PostSynIdx = 0; PostSynIdx<PrePostReceptorCounts.size(); PostSynIdx++) {
-
-            size_t ReceptorCount = PrePostReceptorCounts[PostSynIdx][PreSynIdx];
-
-            if (Sparse) {
+    std::vector<AbstractConnection> Connectome = GetAbstractConnectome(NonZero);
+    if (Sparse) {
 
-                if (ReceptorCount>0) {
-                    nlohmann::json connectiondata(nlohmann::json::value_t::array);
-                    connectiondata.push_back(PreSynIdx);
-                    connectiondata.push_back(PostSynIdx);
-                    connectiondata.push_back(ReceptorCount);
-                    reccntlist.push_back(connectiondata);
-                }
+        for (const AbstractConnection& Connection : Connectome) {
+            nlohmann::json connectiondata(nlohmann::json::value_t::array);
+            connectiondata.push_back(Connection.PreSynID);
+            connectiondata.push_back(Connection.PostSynID);
+            connectiondata.push_back(Connection.NumReceptors);
+            reccntlist.push_back(std::move(connectiondata));
+        }
 
-            } else {
+    } else {
 
-                frompresynreccntvec.push_back(ReceptorCount);
+        // Only one row is expanded at a time, the dense matrix only exists as JSON.
+        std::vector<size_t> frompresynreccntvec(Neurons.size(), 0);
+        auto ConnectionIt = Connectome.begin();
+        for (size_t PreSynIdx = 0; PreSynIdx<Neurons.size(); PreSynIdx++) {
+            auto RowBegin = ConnectionIt;
+            for (; (ConnectionIt != Connectome.end()) && (ConnectionIt->PreSynID == int32_t(PreSynIdx)); ConnectionIt++) {
+                frompresynreccntvec[ConnectionIt->PostSynID] = ConnectionIt->NumReceptors;
+            }
+            reccntlist.push_back(frompresynreccntvec);
+            for (auto It = RowBegin; It != ConnectionIt; It++) {
+                frompresynreccntvec[It->PostSynID] = 0;
             }
-
         }
-        if (!Sparse) reccntlist.push_back(frompresynreccntvec);
     }
 
     for (auto& RegionPtr : Regions) {
@@ -1081,11 +1861,16 @@ nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero)
     return connectome;
 }
 
-enum sim_methods {
-    simmethod_list_of_neurons,
-    simmethod_circuits,
-    NUMsimmethods,
-};
+/**
+ * The abstract connectome as consecutive AbstractConnection records, in
+ * the byte order of the host.
+ */
+std::vector<char> Simulation::GetAbstractConnectomeBinary(bool NonZero) const {
+    std::vector<AbstractConnection> Connectome = GetAbstractConnectome(NonZero);
+    std::vector<char> Data(Connectome.size() * sizeof(AbstractConnection));
+    std::memcpy(Data.data(), Connectome.data(), Data.size());
+    return Data;
+}
 
 void Simulation::RunFor(float tRun_ms) {
     assert(Logger_ != nullptr);
@@ -1104,23 +1889,49 @@ void Simulation::RunFor(float tRun_ms) {
     // *** TODO: add making circuits and brain regions
     //           to be able to use the other method
 
-    // *** TODO: obtain this from an API call...
-    sim_methods simmethod = simmethod_list_of_neurons;
+    SimulationMethods simmethod = SimulationMethod;
+    if ((simmethod == SIMMETHOD_NEURON_ARRAYS) && !BallAndStick::BSNeuronArrays::Supports(Neurons)) {
+        Logger_->Log("Neuron arrays method does not support all neurons, using list of neurons instead", 6);
+        simmethod = SIMMETHOD_LIST_OF_NEURONS;
+    }
+    if (simmethod == SIMMETHOD_NEURON_ARRAYS) {
+        NeuronArrays.PSPIntegration = PSPIntegration;
+        NeuronArrays.Dt_ms = Dt_ms;
+        NeuronArrays.GatherFromNeurons(Neurons, this->T_ms);
+        unsigned int HardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        NeuronArrays.SetNumThreads((NumThreads > 0) ? NumThreads : HardwareThreads);
+    }
+
+    // The recorders are locked for each step, so that RPC threads can only
+    // close or read them between steps.
+    std::unique_lock<std::mutex> RecordersLock(RecordersMutex_);
+    OpenRecorders(tRun_ms);
+    bool RecorderFailed = Recorder.HasFailed();
+    bool InstrumentsRecorderFailed = InstrumentsRecorder.HasFailed();
+    RecordersLock.unlock();
 
     unsigned long num_updates_called = 0;
     while (this->T_ms < tEnd_ms) {
+        RecordersLock.lock();
 
-        // Track time-points for God's eye recording
+        // Track time-points for God's eye recording, neurons only record
+        // into their own vectors when not streaming into the recording file
         bool recording = this->IsRecording();
-        if (recording) {
+        bool streaming = recording && Recorder.IsOpen();
+        if (streaming) {
+            Recorder.ReserveStep();
+            Recorder.Append(0, this->T_ms);
+        } else if (recording) {
             //std::cout << 'R'; std::cout.flush();
             this->TRecorded_ms.emplace_back(this->T_ms);
         }
+        recording = recording && !streaming;
 
         // Call update in circuits (neurons, etc)
         switch (simmethod) {
-            case simmethod_circuits: // *** For now, use the same method
-            case simmethod_list_of_neurons: {
+            case NUMSIMMETHODS:
+            case SIMMETHOD_CIRCUITS: // *** For now, use the same method
+            case SIMMETHOD_LIST_OF_NEURONS: {
                 //std::cout << "DEBUG --> "; std::cout.flush();
                 for (auto & neuron_ptr : this->Neurons) {
                     if (neuron_ptr) {
@@ -1132,6 +1943,11 @@ void Simulation::RunFor(float tRun_ms) {
                 //std::cout << '\n'; std::cout.flush();
                 break;
             }
+            case SIMMETHOD_NEURON_ARRAYS: {
+                NeuronArrays.Step(this->T_ms, recording);
+                num_updates_called += NeuronArrays.Size();
+                break;
+            }
             // case simmethod_circuits: {
             //     for (auto &[circuitID, circuit] : this->NeuralCircuits) {
             //         auto circuitPtr = std::dynamic_pointer_cast<BallAndStick::BSAlignedNC>(circuit);
@@ -1143,23 +1959,79 @@ void Simulation::RunFor(float tRun_ms) {
             // }
         }
 
+        if (streaming) {
+            size_t NumNeurons = std::min(Neurons.size(), Recorder.NumColumns() - 1);
+            for (size_t i = 0; i < NumNeurons; i++) {
+                float Vm_mV = 0.0;
+                if (simmethod == SIMMETHOD_NEURON_ARRAYS) {
+                    Vm_mV = NeuronArrays.Vm_mV[i];
+                } else if (Neurons[i]) {
+                    Vm_mV = static_cast<BallAndStick::BSNeuron*>(Neurons[i].get())->Vm_mV;
+                }
+                Recorder.Append(1 + i, Vm_mV);
+            }
+        }
+
         // Carry out simulated instrument recordings
         if (InstrumentsAreRecording()) {
-            this->TInstruments_ms.emplace_back(this->T_ms);
+            bool streaming_instruments = InstrumentsRecorder.IsOpen();
+            if (streaming_instruments) {
+                InstrumentsRecorder.ReserveStep();
+                InstrumentsRecorder.Append(0, this->T_ms);
+            } else {
+                this->TInstruments_ms.emplace_back(this->T_ms);
+            }
 
-            // Electrodes
+            // Electrodes read the membrane potentials from a contiguous array
+            const float* Vm_mV = nullptr;
+            if (!RecordingElectrodes.empty()) {
+                if (simmethod == SIMMETHOD_NEURON_ARRAYS) {
+                    Vm_mV = NeuronArrays.Vm_mV.data();
+                } else {
+                    ElectrodeVm_mV.resize(Neurons.size());
+                    for (size_t i = 0; i < Neurons.size(); i++) {
+                        ElectrodeVm_mV[i] = Neurons[i] ? static_cast<BallAndStick::BSNeuron*>(Neurons[i].get())->Vm_mV : 0.0;
+                    }
+                    Vm_mV = ElectrodeVm_mV.data();
+                }
+            }
+            size_t Column = 1;
             for (auto & Electrode : RecordingElectrodes) {
-                Electrode->Record(this->T_ms);
+                if (!streaming_instruments) {
+                    Electrode->Record(this->T_ms, Vm_mV);
+                    continue;
+                }
+                for (size_t s = 0; (s < Electrode->SiteLocations_um.size()) && (Column < InstrumentsRecorder.NumColumns()); s++, Column++) {
+                    InstrumentsRecorder.Append(Column, Electrode->ElectricFieldPotential(s, Vm_mV));
+                }
             }
 
             // Calcium Imaging
             if (CaData_.State_ != BG::NES::VSDA::Calcium::CA_NOT_INITIALIZED) {
+                if ((simmethod == SIMMETHOD_NEURON_ARRAYS) && CaData_.CaImaging.IsSampleDue(this->T_ms)) {
+                    NeuronArrays.ScatterCa(this->T_ms);
+                }
                 CaData_.CaImaging.Record(this->T_ms, this, CaData_.Params_); // flatten this later please
             }
         }
 
+        if (!RecorderFailed && Recorder.HasFailed()) {
+            Logger_->Log("Recording file " + Recorder.Path() + " could not grow, recording stopped at " + std::to_string(this->T_ms) + " ms", 8);
+            RecorderFailed = true;
+        }
+        if (!InstrumentsRecorderFailed && InstrumentsRecorder.HasFailed()) {
+            Logger_->Log("Recording file " + InstrumentsRecorder.Path() + " could not grow, recording stopped at " + std::to_string(this->T_ms) + " ms", 8);
+            InstrumentsRecorderFailed = true;
+        }
+        RecordersLock.unlock();
+
         this->T_ms += this->Dt_ms;
     }
+
+    if (simmethod == SIMMETHOD_NEURON_ARRAYS) {
+        NeuronArrays.ScatterToNeurons();
+    }
+
     Logger_->Log("Number of top-level Update() calls: "+std::to_string(num_updates_called), 3);
     Logger_->Log("Total number of spikes on all neurons: "+std::to_string(TotalSpikes()), 3);
 };
@@ -1222,60 +2094,15 @@ Geometries::Geometry* Simulation::FindShapeByID(int ShapeID) {
     return Collection.GetGeometry(ShapeID);
 }
 
-// std::string Simulation::WrapAsNESRequest(const std::string & ReqFunc, const std::string & _RequestJSON) {
-//     std::string wrapped("[ { \"ReqID\": ");
-//     wrapped += std::to_string(StoredReqID) + ", \"";
-//     wrapped += ReqFunc +"\": ";
-//     wrapped += _RequestJSON + " } ]";
-//     StoredReqID++;
-//     return wrapped;
-// }
-
-std::string Simulation::WrapAsNESRequest( const std::string & _RequestJSON, const std::string & _Route) {
-    std::string wrapped("{ \"ReqID\": ");
-    wrapped += std::to_string(StoredReqID) + ", \"";
-    wrapped += _Route + "\": ";
-    wrapped += _RequestJSON + " }";
-    StoredReqID++;
-    return wrapped;
-}
-
-// void Simulation::StoreRequestHandled(const std::string & ReqFunc, const std::string & _Route, const std::string & _RequestJSON) {
-//     if (_Route.empty()) {
-//         // Store it as an NESRequest instead:
-//         StoredRequests.emplace_back("NES", WrapAsNESRequest(ReqFunc, _RequestJSON));
-
-//     } else {
-//         StoredRequests.emplace_back(_Route, _RequestJSON);
-//     }
-//     //Logger_->Log("DEBUGGING --> Number of stored requests: "+std::to_string(StoredRequests.size()), 1);
-// }
-
-void Simulation::StoreRequestHandled(const std::string & _Route, const std::string & _RequestJSON) {
-    // We store everything as a Request within a NESRequest block:
-    StoredRequests.emplace_back(_Route, WrapAsNESRequest(_RequestJSON, _Route));
+void Simulation::StoreRequestHandled(const std::string & _Route, const nlohmann::json & _Request, bool _Succeeded) {
+    StoredRequests.Append(_Route, _Request, _Succeeded);
 }
 
 std::string Simulation::StoredRequestsToString() const {
     std::stringstream ss;
-    for (const auto & storedreq: StoredRequests) {
-        ss << storedreq.Str() << '\n';
-    }
-    return ss.str();
-}
-
-std::string Simulation::StoredRequestsToNESRequestArray() const {
-    std::stringstream ss;
-    ss << "[\n";
-    for (size_t i = 0; i < StoredRequests.size(); i++) {
-        ss << StoredRequests.at(i).RequestJSON;
-        if (i == (StoredRequests.size()-1)) {
-            ss << '\n';
-        } else {
-            ss << ",\n";
-        }
-    }
-    ss << "]\n";
+    StoredRequests.ForEach([&](const std::string & _Route, nlohmann::json & _Request) {
+        ss << "{ \"" << _Route << "\": " << _Request.dump() << " }\n";
+    });
     return ss.str();
 }
 
@@ -1302,7 +2129,7 @@ std::string TimeStamp() {
     return ss.str();
 }
 
-std::string Simulation::StoredRequestsSave() const {
+std::string Simulation::StoredRequestsSave(bool _Compact) {
     // Make sure the directory exists.
     std::error_code err;
     if (!MkDirRecursive("SavedSimulations/", err)) {
@@ -1317,12 +2144,13 @@ std::string Simulation::StoredRequestsSave() const {
         FileName += Name;
     }
 
-    std::ofstream SaveFile("SavedSimulations/"+FileName+".NES");
-    if (!SaveFile.is_open()) {
+    if (_Compact) {
+        size_t Removed = StoredRequests.Compact();
+        Logger_->Log("Compacted stored requests by " + std::to_string(Removed) + " records", 2);
+    }
+    if (!StoredRequests.Save("SavedSimulations/"+FileName+".NES")) {
         return "";
     }
-    SaveFile << StoredRequestsToNESRequestArray();
-    SaveFile.close();
 
     return FileName;
 }
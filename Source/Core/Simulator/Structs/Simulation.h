@@ -13,7 +13,12 @@
 // Standard Libraries (BG convention: use <> instead of "")
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -26,18 +31,22 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <Simulator/BallAndStick/BSAlignedBrainRegion.h>
+#include <Simulator/BallAndStick/BSNeuronArrays.h>
 //#include <Simulator/BallAndStick/BSAlignedNC.h>
 #include <Simulator/BrainRegion/BrainRegion.h>
 #include <Simulator/Geometries/Geometry.h>
 #include <Simulator/Geometries/GeometryCollection.h>
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/BS.h>
+#include <Simulator/Structs/ColumnRecorder.h>
 #include <Simulator/Structs/NeuralCircuit.h>
 #include <Simulator/Structs/Neuron.h>
 #include <Simulator/Structs/PatchClampADC.h>
 #include <Simulator/Structs/PatchClampDAC.h>
 #include <Simulator/Structs/Receptor.h>
+#include <Simulator/Structs/RequestLog.h>
 #include <Simulator/Structs/Staple.h>
+#include <Simulator/Structs/SynapseIndex.h>
 #include <Simulator/Distributions/Generic.h>
 #include <BG/Common/Logger/Logger.h>
 
@@ -50,6 +59,10 @@
 //! The value of tMax_ms at which recording will be done forever.
 #define _RECORD_FOREVER_TMAX_MS -1.0
 
+//! Receptors per thread below which the abstract connectome is counted on
+//! fewer threads, as starting them would take longer than counting.
+#define _ABSTRACT_CONNECTOME_RECEPTORS_PER_THREAD 65536
+
 namespace BG {
 namespace NES {
 namespace Simulator {
@@ -62,13 +75,19 @@ namespace Tools {
 
 enum SimulationActions { SIMULATION_NONE, SIMULATION_RESET, SIMULATION_RUNFOR, SIMULATION_VSDA, SIMULATION_CALCIUM, SIMULATION_VISUALIZATION};
 
-struct StoredRequest {
-    std::string Route;
-    std::string RequestJSON;
-
-    StoredRequest(const std::string & _Route, const std::string & _RequestJSON): Route(_Route), RequestJSON(_RequestJSON) {}
-    std::string Str() const { return "{ \"" + Route + "\": " + RequestJSON + " }"; }
+//! Methods used by RunFor() to update the neurons in each time step.
+//! SIMMETHOD_NEURON_ARRAYS falls back to SIMMETHOD_LIST_OF_NEURONS if a
+//! neuron is not of a class that it supports.
+enum SimulationMethods { SIMMETHOD_LIST_OF_NEURONS, SIMMETHOD_CIRCUITS, SIMMETHOD_NEURON_ARRAYS, NUMSIMMETHODS };
+
+//! Number of receptors from one neuron to another, an entry of the abstract
+//! connectome. Sent as is by Simulation/GetAbstractConnectomeRaw.
+struct AbstractConnection {
+    int32_t PreSynID;
+    int32_t PostSynID;
+    uint32_t NumReceptors;
 };
+static_assert(sizeof(AbstractConnection) == 12, "AbstractConnection is sent without padding");
 
 /**
  * @brief Name of the simulation
@@ -76,8 +95,12 @@ struct StoredRequest {
  */
 struct Simulation {
 protected:
-    std::vector<StoredRequest> StoredRequests;
-    int StoredReqID = 0; // Used to create request IDs for stored NESRequests.
+    RequestLog StoredRequests; /**Handled requests, written by StoredRequestsSave() and replayed by Simulation/Load*/
+
+    std::mutex WorkMutex_;                  /**Guards the changes of WorkRequested, IsProcessing and IsRendering made through the functions below*/
+    std::condition_variable WorkCondition_; /**Notified whenever one of them changes*/
+
+    mutable std::mutex RecordersMutex_; /**Guards Recorder and InstrumentsRecorder, RPC threads reopen and read them while the engine thread appends*/
 
 public:
     BG::Common::Logger::LoggingSystem* Logger_ = nullptr;
@@ -98,8 +121,29 @@ public:
     float RunTimes_ms; /**Number of ms to be simulated next time runfor is called - if not, set to -1*/
     SimulationActions CurrentTask; /**Current task to be processed on this simulation, could be run for, or reset, etc. See above enum for more info.*/
 
+    //! Handoff of work between the RPC handlers, the engine thread and the
+    //! render pools, see EngineController. Waiting threads are woken as soon
+    //! as the state they wait for changes, instead of polling the flags.
+    void RequestWork(SimulationActions _Task);
+    //! Waits up to _Timeout for WorkRequested, returns it.
+    bool WaitForWorkRequest(std::chrono::milliseconds _Timeout);
+    void SetProcessing();
+    void WorkDone();
+    void StartRendering();
+    void RenderingDone();
+    void WaitForRendering();
+    //! Waits up to _Timeout until no work is requested, processed or rendered.
+    //! Returns true if the simulation is idle.
+    bool WaitUntilIdle(std::chrono::milliseconds _Timeout);
+    bool IsBusy() const;
+
+    SimulationMethods SimulationMethod = SIMMETHOD_NEURON_ARRAYS; /**Method used to update neurons during RunFor, see above enum*/
+    int NumThreads = 0; /**Threads used by SIMMETHOD_NEURON_ARRAYS, 0 means one per hardware thread, simulations created through the API start with Simulation_NumThreads of the config*/
+    BallAndStick::PSPIntegrationMethods PSPIntegration = BallAndStick::PSPINTEGRATION_LATEST_SPIKE; /**PSP integration used by SIMMETHOD_NEURON_ARRAYS*/
+
     std::vector<float> TInstruments_ms{};
     std::vector<std::unique_ptr<Tools::RecordingElectrode>> RecordingElectrodes;
+    std::vector<float> ElectrodeVm_mV; /**Neuron Vm gathered for the electrodes when not using SIMMETHOD_NEURON_ARRAYS*/
     //std::unique_ptr<Tools::CalciumImaging> CaImaging; --- Replaced by Calcium below.
 
     float InstrumentsStartRecordTime_ms = 0.0;
@@ -108,6 +152,15 @@ public:
     float StartRecordTime_ms = 0.0;
     float MaxRecordTime_ms = 0.0;
 
+    std::string RecordingFile; /**If set, RecordAll streams t_ms and the neuron Vm into this file instead of memory*/
+    Tools::ColumnSignal RecordingSignal; /**Downsampling of the neuron Vm columns*/
+    std::map<int, Tools::ColumnSignal> RecordingNeuronSignals; /**Downsampling overrides by neuron ID*/
+    Tools::ColumnRecorder Recorder; /**Columns: t_ms, then Vm of each neuron in Neurons order*/
+
+    std::string InstrumentsRecordingFile; /**If set, electrode recordings are streamed into this file instead of memory*/
+    Tools::ColumnSignal InstrumentsRecordingSignal; /**Downsampling of the electrode site columns*/
+    Tools::ColumnRecorder InstrumentsRecorder; /**Columns: t_ms, then each site of each electrode in order*/
+
     //std::unordered_map<std::string, std::shared_ptr<BrainRegions::BrainRegion>> Regions;
     std::vector<std::unique_ptr<BrainRegions::BrainRegion>> Regions;
     //std::unordered_map<std::string, std::shared_ptr<CoreStructs::NeuralCircuit>> NeuralCircuits;
@@ -120,11 +173,14 @@ public:
 
     std::vector<std::shared_ptr<CoreStructs::Neuron>> Neurons; /** List of neurons, index is their id. Notice that this takes a Neuron base class object (not BSNeuron and other derivatives). */
 
+    BallAndStick::BSNeuronArrays NeuronArrays; /**Structure-of-arrays neuron state used by SIMMETHOD_NEURON_ARRAYS*/
+
     std::vector<Connections::Staple> Staples; /**List of staple connections, index is their id (also stored in struct)*/
     // The following must contain smart pointers, because content will be
     // moved as the vector is expanded and remapped, and InputReceptorAdded delivers
     // a static pointer:
     std::vector<std::unique_ptr<Connections::Receptor>> Receptors; /**List of receptor connections, index is their id (and it's also stored in the struct itself)*/
+    Connections::SynapseIndex ReceptorIndex; /**Receptor IDs by presynaptic and postsynaptic neuron, kept up to date by AddReceptor*/
 
     std::vector<Tools::PatchClampDAC> PatchClampDACs; /**List of patchclamp dacs, id is index*/
     std::vector<Tools::PatchClampADC> PatchClampADCs; /**List of patchclamp adcs, id is index*/
@@ -164,10 +220,32 @@ public:
     int AddSCNeuron(CoreStructs::SCNeuronStruct& _N);
     int AddReceptor(Connections::Receptor& _C);
 
+    //! Bulk builder functions
+    //!   Add a batch with one reserve per container, at consecutive IDs.
+    //!   They return the first ID of the batch (the current size of the
+    //!   container for an empty batch), or -1 without adding anything if
+    //!   any element refers to a missing shape or compartment.
+    int AddSpheres(std::vector<Geometries::Sphere>& _S);
+    int AddCylinders(std::vector<Geometries::Cylinder>& _S);
+    int AddBoxes(std::vector<Geometries::Box>& _S);
+    int AddSCCompartments(std::vector<Compartments::BS>& _C);
+    int AddReceptors(std::vector<Connections::Receptor>& _C);
+
+    //! Cross-linking done by AddSCNeuron and AddReceptor, for neurons and
+    //! receptors that are already stored at their index, e.g. by LoadModel.
+    void LinkSCNeuron(const CoreStructs::SCNeuronStruct& _N);
+    bool LinkReceptor(Connections::Receptor& _C);
+
     bool SaveModel(const std::string& Name);
     bool LoadModel(const std::string& Name);
     void InspectSavedModel(const std::string& Name) const;
 
+    //! Save and restore all dynamic state (membrane potentials, spike and
+    //! stimulation times, filter states, random generator states, time and
+    //! recordings) of a simulation with an unchanged model.
+    bool SaveCheckpoint(const std::string& Name);
+    bool LoadCheckpoint(const std::string& Name);
+
     size_t GetTotalNumberOfNeurons();
     std::vector<std::shared_ptr<CoreStructs::Neuron>> GetAllNeurons();
     std::vector<size_t> GetAllNeuronIDs();
@@ -193,6 +271,13 @@ public:
     //! Setting t_max_ms to -1 means record forever.
     void SetRecordAll(float tMax_ms = _RECORD_FOREVER_TMAX_MS);
     bool IsRecording() const;
+
+    //! Streams RecordAll recordings into _Path from the next RunFor on, or
+    //! keeps them in memory again if _Path is empty.
+    void SetRecordingFile(const std::string & _Path, Tools::ColumnSignal _Signal, const std::map<int, Tools::ColumnSignal> & _NeuronSignals = {});
+    void SetInstrumentsRecordingFile(const std::string & _Path, Tools::ColumnSignal _Signal);
+    bool OpenRecorders(float tRun_ms);
+
     std::unordered_map<std::string, CoreStructs::CircuitRecording> GetRecording();
     nlohmann::json GetSpikeTimesJSON() const;
     nlohmann::json GetRecordingJSON() const;
@@ -207,20 +292,22 @@ public:
     nlohmann::json GetSomaPositionsJSON() const;
     nlohmann::json GetConnectomeJSON() const;
     size_t GetAbstractConnection(int PreSynID, int PostSynID, bool NonZero) const;
-    std::vector<std::vector<size_t>> GetAbstractConnectome(bool NonZero) const;
+    std::vector<AbstractConnection> GetAbstractConnectome(bool NonZero) const;
     nlohmann::json GetAbstractConnectomeJSON(bool Sparse, bool NonZero) const;
+    std::vector<char> GetAbstractConnectomeBinary(bool NonZero) const;
 
     void RunFor(float tRun_ms);
 
     void Show();
 
-    std::string WrapAsNESRequest(const std::string & _RequestJSON, const std::string & _Route);
-    void StoreRequestHandled(const std::string & _Route, const std::string & _RequestJSON);
-    size_t NumStoredRequests() const { return StoredRequests.size(); }
+    void StoreRequestHandled(const std::string & _Route, const nlohmann::json & _Request, bool _Succeeded = true);
+    size_t NumStoredRequests() const { return StoredRequests.Size(); }
+    const RequestLog& GetStoredRequests() const { return StoredRequests; }
     std::string StoredRequestsToString() const;
-    std::string StoredRequestsToNESRequestArray() const;
-    std::string StoredRequestsSave() const;
-    void ClearStoredRequests() { StoredRequests.clear(); }
+    //! With _Compact, runs of single create requests are first collapsed
+    //! into bulk create requests (see RequestLog::Compact()).
+    std::string StoredRequestsSave(bool _Compact = true);
+    void ClearStoredRequests() { StoredRequests.Clear(); }
 };
 
 }; // namespace Simulator
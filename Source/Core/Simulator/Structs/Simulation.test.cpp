@@ -9,6 +9,13 @@
 */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 
@@ -16,6 +23,7 @@
 #include <Simulator/BallAndStick/BSAlignedBrainRegion.h>
 #include <Simulator/BallAndStick/BSAlignedNC.h>
 #include <Simulator/Distributions/TruncNorm.h>
+#include <Simulator/Geometries/Sphere.h>
 #include <Simulator/Structs/Simulation.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
@@ -373,3 +381,301 @@ TEST_F(SimulationTest, test_RunFor_default) {
             ASSERT_FALSE(((circuitData.at(cellID)).at("Vm_mV")).empty());
     }
 }
+
+TEST_F(SimulationTest, test_WaitUntilIdle_wakes_when_work_done) {
+    ASSERT_TRUE(testSimulation->WaitUntilIdle(std::chrono::milliseconds(0)));
+
+    // Stands in for the engine thread. It only records what it saw and always
+    // hands the simulation back, the checks are made once it has been joined.
+    std::atomic<bool> gotRequest{false};
+    std::atomic<int> seenTask{-1};
+    std::thread worker([this, &gotRequest, &seenTask]() {
+        gotRequest = testSimulation->WaitForWorkRequest(std::chrono::seconds(10));
+        if (gotRequest) {
+            testSimulation->SetProcessing();
+            seenTask = testSimulation->CurrentTask;
+            testSimulation->RunFor(10.0);
+        }
+        testSimulation->WorkDone();
+    });
+
+    testSimulation->RequestWork(BG::NES::Simulator::SIMULATION_RUNFOR);
+    bool becameIdle = testSimulation->WaitUntilIdle(std::chrono::seconds(10));
+    worker.join();
+
+    ASSERT_TRUE(gotRequest);
+    ASSERT_TRUE(becameIdle);
+    ASSERT_EQ(seenTask, BG::NES::Simulator::SIMULATION_RUNFOR);
+    ASSERT_EQ(testSimulation->CurrentTask, BG::NES::Simulator::SIMULATION_NONE);
+    ASSERT_GT(testSimulation->T_ms, 0.0);
+
+    // Nothing was requested, so the worker would time out.
+    ASSERT_FALSE(testSimulation->WaitForWorkRequest(std::chrono::milliseconds(1)));
+}
+
+/**
+ * @brief Test class for unit tests for Simulation checkpoints.
+ * Builds a small network with spontaneous activity, the same network can be
+ * built again to restore a checkpoint into.
+ */
+struct SimulationCheckpointTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> testSimulation{};
+    std::string path;
+
+    const int NumNeurons = 10;
+
+    void BuildNetwork(BG::NES::Simulator::Simulation & sim, int _NumNeurons) {
+        using namespace BG::NES::Simulator;
+
+        for (int i = 0; i < _NumNeurons; i++) {
+            Geometries::Sphere soma(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+            sim.AddSphere(soma);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = i;
+            sim.AddSCCompartment(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { i };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            sim.AddSCNeuron(neuron);
+        }
+
+        for (int i = 0; i < _NumNeurons; i++) {
+            for (int Offset : { 1, 3 }) {
+                Connections::Receptor receptor;
+                receptor.SourceCompartmentID = i;
+                receptor.DestinationCompartmentID = (i + Offset) % _NumNeurons;
+                receptor.Conductance_nS = 30.0 + 5.0 * (i % 4);
+                receptor.TimeConstantRise_ms = 2.0;
+                receptor.TimeConstantDecay_ms = 15.0;
+                std::strcpy(receptor.Neurotransmitter, "AMPA");
+                sim.AddReceptor(receptor);
+            }
+        }
+
+        for (auto & neuron_ptr : sim.Neurons) {
+            static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get())->SetCaFilter(5.0, 20.0, sim.Dt_ms, 0.1);
+        }
+        sim.SetRecordAll(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    std::vector<float> GetVm_mV(BG::NES::Simulator::Simulation & sim) {
+        std::vector<float> Vm_mV;
+        for (auto & neuron : sim.Neurons) {
+            Vm_mV.push_back(static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(neuron.get())->Vm_mV);
+        }
+        return Vm_mV;
+    }
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("SimulationCheckpointTest-" + std::to_string(::getpid()) + ".bgckp")).string();
+
+        testSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        BuildNetwork(*testSimulation, NumNeurons);
+        testSimulation->Neurons.at(0)->AddSpecificAPTime(2.0);
+    }
+
+    void TearDown() {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(SimulationCheckpointTest, test_LoadCheckpoint_continues_run) {
+    using namespace BG::NES::Simulator;
+
+    // Spontaneous activity and a direct stimulation that is still pending
+    // at the checkpoint.
+    static_cast<BallAndStick::BSNeuron*>(testSimulation->Neurons.at(3).get())->SetSpontaneousActivity(20.0, 5.0, 7);
+    testSimulation->Neurons.at(8)->AddSpecificAPTime(90.0);
+
+    testSimulation->RunFor(60.0);
+    ASSERT_TRUE(testSimulation->SaveCheckpoint(path));
+    testSimulation->RunFor(60.0);
+
+    // A fresh copy of the model, restored from the checkpoint.
+    auto restoredSimulation = std::make_unique<Simulation>(&Logger);
+    BuildNetwork(*restoredSimulation, NumNeurons);
+    ASSERT_TRUE(restoredSimulation->LoadCheckpoint(path));
+    ASSERT_EQ(restoredSimulation->T_ms, 60.0);
+    restoredSimulation->RunFor(60.0);
+
+    ASSERT_GT(testSimulation->TotalSpikes(), 0);
+    ASSERT_EQ(testSimulation->TotalSpikes(), restoredSimulation->TotalSpikes());
+    ASSERT_EQ(testSimulation->GetRecordingJSON(), restoredSimulation->GetRecordingJSON());
+    for (int i = 0; i < NumNeurons; i++) {
+        auto testNeuron = static_cast<BallAndStick::BSNeuron*>(testSimulation->Neurons.at(i).get());
+        auto restoredNeuron = static_cast<BallAndStick::BSNeuron*>(restoredSimulation->Neurons.at(i).get());
+
+        ASSERT_EQ(testNeuron->TAct_ms, restoredNeuron->TAct_ms);
+        ASSERT_EQ(testNeuron->Vm_mV, restoredNeuron->Vm_mV);
+        ASSERT_EQ(testNeuron->SpontDraws, restoredNeuron->SpontDraws);
+        ASSERT_EQ(testNeuron->CaStateRise, restoredNeuron->CaStateRise);
+        ASSERT_EQ(testNeuron->CaStateDecay, restoredNeuron->CaStateDecay);
+    }
+
+    // A model with different neurons is rejected.
+    auto otherSimulation = std::make_unique<Simulation>(&Logger);
+    BuildNetwork(*otherSimulation, 6);
+    ASSERT_FALSE(otherSimulation->LoadCheckpoint(path));
+}
+
+TEST_F(SimulationCheckpointTest, test_LoadCheckpoint_failure_leaves_state) {
+    using namespace BG::NES::Simulator;
+    std::string truncatedPath = path + ".truncated";
+    std::string recordingPath = path + ".bgrec";
+
+    testSimulation->SetRecordingFile(recordingPath, Tools::ColumnSignal());
+    testSimulation->RunFor(60.0);
+    ASSERT_TRUE(testSimulation->SaveCheckpoint(path));
+    testSimulation->SetRecordingFile("", Tools::ColumnSignal());
+
+    auto otherSimulation = std::make_unique<Simulation>(&Logger);
+    BuildNetwork(*otherSimulation, NumNeurons);
+    otherSimulation->RunFor(30.0);
+    std::vector<float> Vm_mV = GetVm_mV(*otherSimulation);
+
+    // Sizes in the header that do not fit in the file are rejected.
+    std::filesystem::copy_file(path, truncatedPath, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(truncatedPath, std::filesystem::file_size(path) / 2);
+    ASSERT_FALSE(otherSimulation->LoadCheckpoint(truncatedPath));
+    ASSERT_EQ(otherSimulation->T_ms, 30.0);
+    ASSERT_EQ(GetVm_mV(*otherSimulation), Vm_mV);
+
+    // Without its recording file the checkpoint can not be resumed, and
+    // none of it is applied.
+    std::filesystem::remove(recordingPath);
+    ASSERT_FALSE(otherSimulation->LoadCheckpoint(path));
+    ASSERT_EQ(otherSimulation->T_ms, 30.0);
+    ASSERT_EQ(GetVm_mV(*otherSimulation), Vm_mV);
+
+    std::filesystem::remove(truncatedPath);
+}
+
+/**
+ * @brief Test class for unit tests for the bulk create functions of the Simulation struct.
+ * Holds the shapes, compartments, neurons and receptors of a small network,
+ * which is added one by one to singleSimulation.
+ */
+struct SimulationBulkCreateTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> singleSimulation{};
+
+    const int NumNeurons = 8;
+
+    std::vector<BG::NES::Simulator::Geometries::Sphere> somas;
+    std::vector<BG::NES::Simulator::Compartments::BS> compartments;
+    std::vector<BG::NES::Simulator::CoreStructs::SCNeuronStruct> neurons;
+    std::vector<BG::NES::Simulator::Connections::Receptor> receptors;
+
+    // Neurons have no bulk create, they are added one by one either way.
+    void AddNeurons(BG::NES::Simulator::Simulation & sim) {
+        for (auto & neuron : neurons) {
+            sim.AddSCNeuron(neuron);
+        }
+    }
+
+    void Stimulate(BG::NES::Simulator::Simulation & sim) {
+        sim.Neurons.at(0)->AddSpecificAPTime(2.0);
+        sim.Neurons.at(5)->AddSpecificAPTime(40.0);
+        sim.SetRecordAll(_RECORD_FOREVER_TMAX_MS);
+    }
+
+    void SetUp() {
+        using namespace BG::NES::Simulator;
+
+        for (int i = 0; i < NumNeurons; i++) {
+            somas.emplace_back(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 5.0);
+
+            Compartments::BS compartment;
+            compartment.ShapeID = i;
+            compartments.emplace_back(compartment);
+
+            CoreStructs::SCNeuronStruct neuron;
+            neuron.SomaCompartmentIDs = { i };
+            neuron.MembranePotential_mV = -60.0;
+            neuron.RestingPotential_mV = -60.0;
+            neuron.SpikeThreshold_mV = -50.0;
+            neuron.DecayTime_ms = 30.0;
+            neuron.AfterHyperpolarizationAmplitude_mV = -20.0;
+            neuron.PostsynapticPotentialRiseTime_ms = 5.0;
+            neuron.PostsynapticPotentialDecayTime_ms = 25.0;
+            neuron.PostsynapticPotentialAmplitude_nA = 870.0;
+            neurons.emplace_back(neuron);
+
+            for (int Offset : { 1, 3 }) {
+                Connections::Receptor receptor;
+                receptor.SourceCompartmentID = i;
+                receptor.DestinationCompartmentID = (i + Offset) % NumNeurons;
+                receptor.Conductance_nS = 30.0 + 5.0 * (i % 4);
+                receptor.TimeConstantRise_ms = 2.0;
+                receptor.TimeConstantDecay_ms = 15.0;
+                std::strcpy(receptor.Neurotransmitter, "AMPA");
+                receptors.emplace_back(receptor);
+            }
+        }
+
+        singleSimulation = std::make_unique<Simulation>(&Logger);
+        for (int i = 0; i < NumNeurons; i++) {
+            singleSimulation->AddSphere(somas[i]);
+            singleSimulation->AddSCCompartment(compartments[i]);
+        }
+        AddNeurons(*singleSimulation);
+        for (auto & receptor : receptors) {
+            singleSimulation->AddReceptor(receptor);
+        }
+        Stimulate(*singleSimulation);
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(SimulationBulkCreateTest, test_BulkCreate_same_as_single) {
+    auto bulkSimulation = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+    ASSERT_EQ(bulkSimulation->AddSpheres(somas), 0);
+    ASSERT_EQ(bulkSimulation->AddSCCompartments(compartments), 0);
+    AddNeurons(*bulkSimulation);
+    ASSERT_EQ(bulkSimulation->AddReceptors(receptors), 0);
+    Stimulate(*bulkSimulation);
+
+    ASSERT_EQ(bulkSimulation->Collection.Size(), singleSimulation->Collection.Size());
+    ASSERT_EQ(bulkSimulation->BSCompartments.size(), singleSimulation->BSCompartments.size());
+    ASSERT_EQ(bulkSimulation->Receptors.size(), singleSimulation->Receptors.size());
+    ASSERT_EQ(bulkSimulation->GetConnectomeJSON(), singleSimulation->GetConnectomeJSON());
+
+    bulkSimulation->RunFor(100.0);
+    singleSimulation->RunFor(100.0);
+    ASSERT_GT(singleSimulation->TotalSpikes(), 0);
+    ASSERT_EQ(bulkSimulation->GetRecordingJSON(), singleSimulation->GetRecordingJSON());
+}
+
+TEST_F(SimulationBulkCreateTest, test_BulkCreate_adds_nothing_on_failure) {
+    using namespace BG::NES::Simulator;
+    std::vector<Compartments::BS> badCompartments(2);
+    badCompartments[0].ShapeID = 0;
+    badCompartments[1].ShapeID = singleSimulation->Collection.Size();
+    ASSERT_EQ(singleSimulation->AddSCCompartments(badCompartments), -1);
+    ASSERT_EQ(singleSimulation->BSCompartments.size(), NumNeurons);
+
+    std::vector<Connections::Receptor> badReceptors(2);
+    badReceptors[0].SourceCompartmentID = 0;
+    badReceptors[0].DestinationCompartmentID = 1;
+    badReceptors[1].SourceCompartmentID = 0;
+    badReceptors[1].DestinationCompartmentID = NumNeurons;
+    ASSERT_EQ(singleSimulation->AddReceptors(badReceptors), -1);
+    ASSERT_EQ(singleSimulation->Receptors.size(), receptors.size());
+
+    // An empty batch starts at the current size.
+    std::vector<Geometries::Box> boxes;
+    ASSERT_EQ(singleSimulation->AddBoxes(boxes), NumNeurons);
+}
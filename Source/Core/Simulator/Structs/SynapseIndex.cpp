@@ -0,0 +1,201 @@
+#include <Simulator/Structs/SynapseIndex.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Connections {
+
+void SynapseIndex::Clear() {
+    std::lock_guard<std::mutex> Lock(UpdateMutex_);
+    Entries_.clear();
+    NumIndexed_ = 0;
+    NumNeurons_ = 0;
+    ByPost_.Clear();
+    ByPre_.Clear();
+}
+
+void SynapseIndex::Add(int _ReceptorID, int _PreNeuronID, int _PostNeuronID) {
+    assert(_PreNeuronID >= 0 && _PostNeuronID >= 0);
+    assert(Entries_.empty() || (Entries_.back().ReceptorID < _ReceptorID));
+    Entries_.push_back({ _ReceptorID, _PreNeuronID, _PostNeuronID });
+}
+
+size_t SynapseIndex::Size() const {
+    return Entries_.size();
+}
+
+size_t SynapseIndex::NumNeurons() const {
+    Update();
+    return NumNeurons_;
+}
+
+/**
+ * A batch of at least a quarter of the indexed receptors is merged by
+ * rebuilding, anything smaller is inserted into the rows it touches.
+ * Either way each receptor costs amortized O(1) plus the length of its rows.
+ */
+void SynapseIndex::Update() const {
+    if (NumIndexed_.load(std::memory_order_acquire) == Entries_.size()) return;
+
+    std::lock_guard<std::mutex> Lock(UpdateMutex_);
+    size_t NumIndexed = NumIndexed_.load(std::memory_order_relaxed);
+    if (NumIndexed == Entries_.size()) return;
+
+    for (size_t e = NumIndexed; e < Entries_.size(); e++) {
+        NumNeurons_ = std::max<size_t>(NumNeurons_, std::max(Entries_[e].Pre, Entries_[e].Post) + 1);
+    }
+
+    if (4 * (Entries_.size() - NumIndexed) >= NumIndexed) {
+        Rebuild();
+    } else {
+        for (size_t e = NumIndexed; e < Entries_.size(); e++) {
+            ByPost_.Insert(Entries_[e].Post, Entries_[e].Pre, Entries_[e].ReceptorID);
+            ByPre_.Insert(Entries_[e].Pre, Entries_[e].Post, Entries_[e].ReceptorID);
+        }
+    }
+
+    NumIndexed_.store(Entries_.size(), std::memory_order_release);
+}
+
+/**
+ * Rebuilds both row sets with stable counting sorts in O(neurons + receptors).
+ * Entries_ is in ID order, so sorting by the other neuron and then by the
+ * row neuron leaves each row sorted by (other neuron, receptor ID).
+ * The rows are packed without spare capacity.
+ */
+void SynapseIndex::Rebuild() const {
+    auto CountingSort = [this](const std::vector<size_t>& _In, bool _ByPre, std::vector<size_t>* _Offset) {
+        std::vector<size_t> Offset(NumNeurons_ + 1, 0);
+        for (size_t e : _In) Offset[(_ByPre ? Entries_[e].Pre : Entries_[e].Post) + 1]++;
+        for (size_t n = 0; n < NumNeurons_; n++) Offset[n + 1] += Offset[n];
+        std::vector<size_t> Fill(Offset.begin(), Offset.end() - 1);
+        std::vector<size_t> Out(_In.size());
+        for (size_t e : _In) Out[Fill[_ByPre ? Entries_[e].Pre : Entries_[e].Post]++] = e;
+        if (_Offset != nullptr) *_Offset = std::move(Offset);
+        return Out;
+    };
+
+    std::vector<size_t> Order(Entries_.size());
+    for (size_t e = 0; e < Entries_.size(); e++) Order[e] = e;
+
+    auto Fill = [this](RowSet& _Set, const std::vector<size_t>& _Sorted, std::vector<size_t>& _Offset, bool _ByPre) {
+        _Set.Clear();
+        _Set.Neuron.resize(_Sorted.size());
+        _Set.Receptor.resize(_Sorted.size());
+        for (size_t i = 0; i < _Sorted.size(); i++) {
+            const Entry& E = Entries_[_Sorted[i]];
+            _Set.Neuron[i] = _ByPre ? E.Post : E.Pre;
+            _Set.Receptor[i] = E.ReceptorID;
+        }
+        _Set.Size.resize(NumNeurons_);
+        for (size_t n = 0; n < NumNeurons_; n++) _Set.Size[n] = _Offset[n + 1] - _Offset[n];
+        _Offset.pop_back();
+        _Set.Offset = std::move(_Offset);
+        _Set.Capacity = _Set.Size;
+    };
+
+    // Rows by postsynaptic neuron.
+    std::vector<size_t> PostOffset;
+    std::vector<size_t> ByPost = CountingSort(CountingSort(Order, true, nullptr), false, &PostOffset);
+    Fill(ByPost_, ByPost, PostOffset, false);
+
+    // Rows by presynaptic neuron.
+    std::vector<size_t> PreOffset;
+    std::vector<size_t> ByPre = CountingSort(CountingSort(Order, false, nullptr), true, &PreOffset);
+    Fill(ByPre_, ByPre, PreOffset, true);
+}
+
+void SynapseIndex::RowSet::Clear() {
+    Offset.clear();
+    Size.clear();
+    Capacity.clear();
+    Neuron.clear();
+    Receptor.clear();
+    Unused = 0;
+}
+
+/**
+ * The new receptor has the highest ID so far, so it goes after all entries
+ * of the row with the same other neuron.
+ */
+void SynapseIndex::RowSet::Insert(int _Row, int _Neuron, int _ReceptorID) {
+    if (size_t(_Row) >= Offset.size()) {
+        Offset.resize(_Row + 1, Neuron.size());
+        Size.resize(_Row + 1, 0);
+        Capacity.resize(_Row + 1, 0);
+    }
+
+    if (Size[_Row] == Capacity[_Row]) {
+        // Move the row to the end, with room to grow.
+        size_t NewOffset = Neuron.size();
+        size_t NewCapacity = std::max<size_t>(2 * Capacity[_Row], 4);
+        Neuron.resize(NewOffset + NewCapacity);
+        Receptor.resize(NewOffset + NewCapacity);
+        std::copy_n(Neuron.begin() + Offset[_Row], Size[_Row], Neuron.begin() + NewOffset);
+        std::copy_n(Receptor.begin() + Offset[_Row], Size[_Row], Receptor.begin() + NewOffset);
+        Unused += Capacity[_Row];
+        Offset[_Row] = NewOffset;
+        Capacity[_Row] = NewCapacity;
+    }
+
+    auto Begin = Neuron.begin() + Offset[_Row];
+    auto End = Begin + Size[_Row];
+    size_t Position = std::upper_bound(Begin, End, _Neuron) - Begin;
+    auto ReceptorBegin = Receptor.begin() + Offset[_Row];
+    std::copy_backward(Begin + Position, End, End + 1);
+    std::copy_backward(ReceptorBegin + Position, ReceptorBegin + Size[_Row], ReceptorBegin + Size[_Row] + 1);
+    Begin[Position] = _Neuron;
+    ReceptorBegin[Position] = _ReceptorID;
+    Size[_Row]++;
+
+    if (2 * Unused > Neuron.size()) {
+        Compact();
+    }
+}
+
+//! Packs the rows back in row order, keeping their spare capacity.
+void SynapseIndex::RowSet::Compact() {
+    std::vector<int> NewNeuron(Neuron.size() - Unused);
+    std::vector<int> NewReceptor(Receptor.size() - Unused);
+    size_t NewOffset = 0;
+    for (size_t n = 0; n < Offset.size(); n++) {
+        std::copy_n(Neuron.begin() + Offset[n], Size[n], NewNeuron.begin() + NewOffset);
+        std::copy_n(Receptor.begin() + Offset[n], Size[n], NewReceptor.begin() + NewOffset);
+        Offset[n] = NewOffset;
+        NewOffset += Capacity[n];
+    }
+    Neuron = std::move(NewNeuron);
+    Receptor = std::move(NewReceptor);
+    Unused = 0;
+}
+
+SynapseIndex::Row SynapseIndex::RowSet::Get(int _Row) const {
+    if ((_Row < 0) || (size_t(_Row) >= Offset.size())) return Row();
+    return Row{ Neuron.data() + Offset[_Row], Receptor.data() + Offset[_Row], Size[_Row] };
+}
+
+SynapseIndex::Row SynapseIndex::ByPost(int _PostNeuronID) const {
+    Update();
+    return ByPost_.Get(_PostNeuronID);
+}
+
+SynapseIndex::Row SynapseIndex::ByPre(int _PreNeuronID) const {
+    Update();
+    return ByPre_.Get(_PreNeuronID);
+}
+
+SynapseIndex::Row SynapseIndex::Between(int _PreNeuronID, int _PostNeuronID) const {
+    Row PostRow = ByPost(_PostNeuronID);
+    if (PostRow.Size == 0) return Row();
+    auto Range = std::equal_range(PostRow.Neuron, PostRow.Neuron + PostRow.Size, _PreNeuronID);
+    size_t Begin = Range.first - PostRow.Neuron;
+    return Row{ Range.first, PostRow.Receptor + Begin, size_t(Range.second - Range.first) };
+}
+
+}; // Close Namespace Connections
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
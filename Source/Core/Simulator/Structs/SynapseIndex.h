@@ -0,0 +1,138 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the SynapseIndex struct, a compressed sparse row index
+                 of receptors by presynaptic and by postsynaptic neuron.
+    Additional Notes: Receptors are appended in O(1) and merged into the CSR arrays on the
+                      next query. A small batch is inserted into the rows it touches, only a
+                      large one rebuilds the arrays, so interleaved adds and queries stay cheap.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Connections {
+
+/**
+ * @brief Compressed sparse row index of receptors by neuron.
+ *
+ * Two row sets are kept: by postsynaptic neuron (entries sorted by
+ * presynaptic neuron, then receptor ID) and by presynaptic neuron (entries
+ * sorted by postsynaptic neuron, then receptor ID). All receptors of a
+ * neuron pair are therefore a contiguous run in ascending ID order, found
+ * by binary search.
+ *
+ * Rows keep spare capacity, so that receptors added between queries are
+ * inserted into their rows in place. A full row is moved to the end of the
+ * arrays with twice its capacity, and the arrays are compacted once the
+ * space left behind exceeds half of them.
+ *
+ * A Row points into the CSR arrays, so every Row obtained before is invalid
+ * after any Add(), and after any merge of new receptors, which the first
+ * query after an Add() makes.
+ *
+ * Queries may be made from several threads at once. The merge is guarded by
+ * a mutex against other merges only, it must not overlap with threads that
+ * read rows or hold a Row. So after adding receptors, make one query before
+ * several threads start reading. Add() must not run concurrently with
+ * queries.
+ */
+struct SynapseIndex {
+
+    /**
+     * @brief A row of the index, i.e. all receptors of one neuron.
+     * Neuron[i] is the other neuron of the i-th receptor in the row.
+     * Invalid after the next Add() or merge, see above.
+     */
+    struct Row {
+        const int* Neuron = nullptr;
+        const int* Receptor = nullptr;
+        size_t Size = 0;
+    };
+
+    //! Removes all receptors.
+    void Clear();
+
+    //! Adds a receptor, IDs must be added in increasing order.
+    void Add(int _ReceptorID, int _PreNeuronID, int _PostNeuronID);
+
+    //! Number of indexed receptors.
+    size_t Size() const;
+
+    //! Number of rows, i.e. the highest neuron ID seen plus one.
+    size_t NumNeurons() const;
+
+    //! Receptors into a postsynaptic neuron, with their presynaptic neurons.
+    Row ByPost(int _PostNeuronID) const;
+
+    //! Receptors out of a presynaptic neuron, with their postsynaptic neurons.
+    Row ByPre(int _PreNeuronID) const;
+
+    //! Receptors from _PreNeuronID to _PostNeuronID in ascending ID order.
+    //! Neuron of the returned row points at the presynaptic IDs.
+    Row Between(int _PreNeuronID, int _PostNeuronID) const;
+
+private:
+
+    //! Merges receptors added since the last query into the CSR arrays.
+    void Update() const;
+
+    struct Entry {
+        int ReceptorID;
+        int Pre;
+        int Post;
+    };
+
+    /**
+     * @brief One set of rows with spare capacity. Row n is at Offset[n],
+     * with Size[n] entries sorted by (other neuron, receptor ID) followed by
+     * Capacity[n] - Size[n] unused slots.
+     */
+    struct RowSet {
+        std::vector<size_t> Offset;
+        std::vector<size_t> Size;
+        std::vector<size_t> Capacity;
+        std::vector<int> Neuron;
+        std::vector<int> Receptor;
+        size_t Unused = 0; /**Slots left behind by rows that were moved*/
+
+        void Clear();
+        void Insert(int _Row, int _Neuron, int _ReceptorID);
+        void Compact();
+        Row Get(int _Row) const;
+    };
+
+    //! Rebuilds both row sets from all entries with stable counting sorts.
+    void Rebuild() const;
+
+    std::vector<Entry> Entries_; /**All receptors in ID order*/
+
+    // The CSR arrays are a cache of Entries_, merged lazily by const queries.
+    mutable std::mutex UpdateMutex_;
+    mutable std::atomic<size_t> NumIndexed_{0}; /**Number of entries included in the CSR arrays*/
+    mutable size_t NumNeurons_ = 0;
+    mutable RowSet ByPost_;
+    mutable RowSet ByPre_;
+
+};
+
+}; // Close Namespace Connections
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,126 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the SynapseIndex struct.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Structs/SynapseIndex.h>
+
+
+/**
+ * @brief Test class for unit tests for the SynapseIndex struct.
+ *
+ */
+struct SynapseIndexTest : testing::Test {
+    BG::NES::Simulator::Connections::SynapseIndex testIndex;
+
+    void SetUp() {
+        // Receptor ID: pre -> post
+        testIndex.Add(0, 2, 1);
+        testIndex.Add(1, 0, 1);
+        testIndex.Add(2, 2, 1);
+        testIndex.Add(3, 1, 3);
+        testIndex.Add(4, 2, 0);
+    }
+
+    std::vector<int> Receptors(const BG::NES::Simulator::Connections::SynapseIndex::Row & _Row) {
+        return std::vector<int>(_Row.Receptor, _Row.Receptor + _Row.Size);
+    }
+
+    std::vector<int> Neurons(const BG::NES::Simulator::Connections::SynapseIndex::Row & _Row) {
+        return std::vector<int>(_Row.Neuron, _Row.Neuron + _Row.Size);
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(SynapseIndexTest, test_Size_default) {
+    ASSERT_EQ(testIndex.Size(), 5);
+    ASSERT_EQ(testIndex.NumNeurons(), 4);
+}
+
+TEST_F(SynapseIndexTest, test_ByPost_sorted_by_pre_then_ID) {
+    ASSERT_EQ(Neurons(testIndex.ByPost(1)), std::vector<int>({ 0, 2, 2 }));
+    ASSERT_EQ(Receptors(testIndex.ByPost(1)), std::vector<int>({ 1, 0, 2 }));
+    ASSERT_EQ(testIndex.ByPost(2).Size, 0);
+    ASSERT_EQ(testIndex.ByPost(7).Size, 0);
+    ASSERT_EQ(testIndex.ByPost(-1).Size, 0);
+}
+
+TEST_F(SynapseIndexTest, test_ByPre_sorted_by_post_then_ID) {
+    ASSERT_EQ(Neurons(testIndex.ByPre(2)), std::vector<int>({ 0, 1, 1 }));
+    ASSERT_EQ(Receptors(testIndex.ByPre(2)), std::vector<int>({ 4, 0, 2 }));
+}
+
+TEST_F(SynapseIndexTest, test_Between_default) {
+    ASSERT_EQ(Receptors(testIndex.Between(2, 1)), std::vector<int>({ 0, 2 }));
+    ASSERT_EQ(Receptors(testIndex.Between(1, 3)), std::vector<int>({ 3 }));
+    ASSERT_EQ(testIndex.Between(1, 2).Size, 0);
+}
+
+TEST_F(SynapseIndexTest, test_Add_after_query) {
+    ASSERT_EQ(testIndex.Between(0, 3).Size, 0);
+
+    testIndex.Add(5, 0, 3);
+    testIndex.Add(6, 5, 2);
+
+    ASSERT_EQ(Receptors(testIndex.Between(0, 3)), std::vector<int>({ 5 }));
+    ASSERT_EQ(Receptors(testIndex.ByPost(2)), std::vector<int>({ 6 }));
+    ASSERT_EQ(testIndex.NumNeurons(), 6);
+}
+
+TEST_F(SynapseIndexTest, test_Clear_default) {
+    testIndex.Clear();
+    ASSERT_EQ(testIndex.Size(), 0);
+    ASSERT_EQ(testIndex.ByPost(1).Size, 0);
+}
+
+TEST_F(SynapseIndexTest, test_interleaved_Add_same_as_batch) {
+    // Querying after every add inserts into the rows, moving and compacting
+    // them, querying once at the end rebuilds. Both must give the same rows.
+    BG::NES::Simulator::Connections::SynapseIndex batchIndex;
+    BG::NES::Simulator::Connections::SynapseIndex interleavedIndex;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> neuron(0, 29);
+    for (int id = 0; id < 2000; id++) {
+        int pre = neuron(random);
+        int post = neuron(random);
+        batchIndex.Add(id, pre, post);
+        interleavedIndex.Add(id, pre, post);
+        ASSERT_GE(interleavedIndex.ByPre(pre).Size, 1);
+    }
+
+    ASSERT_EQ(batchIndex.NumNeurons(), interleavedIndex.NumNeurons());
+    for (int n = 0; n < 30; n++) {
+        ASSERT_EQ(Neurons(batchIndex.ByPost(n)), Neurons(interleavedIndex.ByPost(n)));
+        ASSERT_EQ(Receptors(batchIndex.ByPost(n)), Receptors(interleavedIndex.ByPost(n)));
+        ASSERT_EQ(Neurons(batchIndex.ByPre(n)), Neurons(interleavedIndex.ByPre(n)));
+        ASSERT_EQ(Receptors(batchIndex.ByPre(n)), Receptors(interleavedIndex.ByPre(n)));
+    }
+}
+
+TEST_F(SynapseIndexTest, test_concurrent_queries_after_Add) {
+    testIndex.Add(5, 0, 3);
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<int>> results(4);
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([this, t, &results]() { results[t] = Receptors(testIndex.ByPost(1)); });
+    }
+    for (auto & thread : threads) thread.join();
+
+    for (const auto & result : results) {
+        ASSERT_EQ(result, std::vector<int>({ 1, 0, 2 }));
+    }
+    ASSERT_EQ(Receptors(testIndex.Between(0, 3)), std::vector<int>({ 5 }));
+}
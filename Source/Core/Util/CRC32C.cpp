@@ -0,0 +1,79 @@
+#include <Util/CRC32C.h>
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+#if defined(__SSE4_2__)
+
+uint32_t CRC32C(const void* _Data, size_t _Size, uint32_t _CRC) {
+    const uint8_t* Bytes = static_cast<const uint8_t*>(_Data);
+    uint64_t CRC = ~_CRC;
+    for (; _Size >= sizeof(uint64_t); _Size -= sizeof(uint64_t), Bytes += sizeof(uint64_t)) {
+        uint64_t Word;
+        std::memcpy(&Word, Bytes, sizeof(Word));
+        CRC = _mm_crc32_u64(CRC, Word);
+    }
+    uint32_t CRC32 = uint32_t(CRC);
+    for (; _Size > 0; _Size--, Bytes++) {
+        CRC32 = _mm_crc32_u8(CRC32, *Bytes);
+    }
+    return ~CRC32;
+}
+
+#else
+
+//! Reflected Castagnoli polynomial.
+#define _CRC32C_POLYNOMIAL 0x82F63B78
+
+//! Table[k][b] is the CRC of byte b followed by k zero bytes.
+static const std::array<std::array<uint32_t, 256>, 8> & CRC32CTable() {
+    static const std::array<std::array<uint32_t, 256>, 8> Table = [] {
+        std::array<std::array<uint32_t, 256>, 8> T{};
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t CRC = b;
+            for (int Bit = 0; Bit < 8; Bit++) {
+                CRC = (CRC >> 1) ^ ((CRC & 1) ? _CRC32C_POLYNOMIAL : 0);
+            }
+            T[0][b] = CRC;
+        }
+        for (uint32_t b = 0; b < 256; b++) {
+            for (size_t k = 1; k < 8; k++) {
+                T[k][b] = (T[k - 1][b] >> 8) ^ T[0][T[k - 1][b] & 0xFF];
+            }
+        }
+        return T;
+    }();
+    return Table;
+}
+
+uint32_t CRC32C(const void* _Data, size_t _Size, uint32_t _CRC) {
+    const auto & Table = CRC32CTable();
+    const uint8_t* Bytes = static_cast<const uint8_t*>(_Data);
+    uint32_t CRC = ~_CRC;
+    for (; _Size >= 8; _Size -= 8, Bytes += 8) {
+        uint32_t Low, High;
+        std::memcpy(&Low, Bytes, sizeof(Low));
+        std::memcpy(&High, Bytes + 4, sizeof(High));
+        Low ^= CRC; // Little endian
+        CRC = Table[7][Low & 0xFF] ^ Table[6][(Low >> 8) & 0xFF] ^ Table[5][(Low >> 16) & 0xFF] ^ Table[4][Low >> 24]
+            ^ Table[3][High & 0xFF] ^ Table[2][(High >> 8) & 0xFF] ^ Table[1][(High >> 16) & 0xFF] ^ Table[0][High >> 24];
+    }
+    for (; _Size > 0; _Size--, Bytes++) {
+        CRC = (CRC >> 8) ^ Table[0][(CRC ^ *Bytes) & 0xFF];
+    }
+    return ~CRC;
+}
+
+#endif
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
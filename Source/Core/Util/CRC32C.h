@@ -0,0 +1,39 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the CRC32C (Castagnoli) checksum.
+    Additional Notes: Uses the SSE4.2 crc32 instruction when the build enables it, and a
+                      slicing-by-8 table implementation otherwise. Both give the same result.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+/**
+ * @brief Computes the CRC32C of a buffer.
+ *
+ * @param _Data Start of the buffer.
+ * @param _Size Size of the buffer in bytes.
+ * @param _CRC CRC32C of the preceding data, to checksum a buffer in parts.
+ * @return CRC32C of the preceding data followed by the buffer.
+ */
+uint32_t CRC32C(const void* _Data, size_t _Size, uint32_t _CRC = 0);
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
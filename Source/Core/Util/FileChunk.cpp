@@ -0,0 +1,71 @@
+#include <Util/FileChunk.h>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+bool ReadFileChunk(const std::string& _Path, uint64_t _Offset, uint64_t _Length, FileChunk& _Chunk) {
+    _Chunk.Offset = _Offset;
+    _Chunk.Data.clear();
+
+    int FileDescriptor = open(_Path.c_str(), O_RDONLY);
+    if (FileDescriptor < 0) {
+        return false;
+    }
+    struct stat FileStat;
+    if ((fstat(FileDescriptor, &FileStat) != 0) || (!S_ISREG(FileStat.st_mode))) {
+        close(FileDescriptor);
+        return false;
+    }
+    _Chunk.FileSize = FileStat.st_size;
+    if (_Offset >= _Chunk.FileSize) {
+        close(FileDescriptor);
+        return true;
+    }
+
+    uint64_t Length = std::min<uint64_t>({ _Length, _FILECHUNK_MAX_BYTES, _Chunk.FileSize - _Offset });
+    _Chunk.Data.resize(Length);
+    uint64_t Done = 0;
+    while (Done < Length) {
+        ssize_t Bytes = pread(FileDescriptor, _Chunk.Data.data() + Done, Length - Done, _Offset + Done);
+        if (Bytes <= 0) {
+            close(FileDescriptor);
+            _Chunk.Data.clear();
+            return false;
+        }
+        Done += Bytes;
+    }
+
+    // The next requests of a download are most likely for the following
+    // chunks, have them read while this one is sent.
+    uint64_t Next = _Offset + Length;
+    if ((Next < _Chunk.FileSize) && (Length > 0)) {
+        posix_fadvise(FileDescriptor, Next, Length * _FILECHUNK_READAHEAD_CHUNKS, POSIX_FADV_WILLNEED);
+    }
+
+    close(FileDescriptor);
+    return true;
+}
+
+std::string SafeFilePath(BG::Common::Logger::LoggingSystem* _Logger, std::string _Handle, const std::string& _Directory, const std::string& _Extension) {
+    std::string Pattern = "..";
+    std::string::size_type i = _Handle.find(Pattern);
+    while (i != std::string::npos) {
+        if (_Logger != nullptr) {
+            _Logger->Log("Detected '..' In File Handle, It's Possible That Someone Is Trying To Do Something Nasty", 8);
+        }
+        _Handle.erase(i, Pattern.length());
+        i = _Handle.find(Pattern, i);
+    }
+    return _Directory + _Handle + _Extension;
+}
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
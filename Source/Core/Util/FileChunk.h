@@ -0,0 +1,67 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides chunked reading of files that are downloaded through the API.
+    Additional Notes: A chunk is read with a single pread, and the kernel is asked to read ahead
+                      the following chunks, so that a client downloading a file chunk by chunk
+                      streams it from the page cache while the server holds one chunk at a time.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+//! Largest chunk returned by a single request, which bounds the memory used
+//! per download.
+#define _FILECHUNK_MAX_BYTES (16 * 1024 * 1024)
+//! Number of chunks after the one requested that the kernel is asked to
+//! read ahead.
+#define _FILECHUNK_READAHEAD_CHUNKS 4
+
+struct FileChunk {
+    uint64_t Offset = 0;    /**Position of the chunk in the file*/
+    uint64_t FileSize = 0;  /**Size of the whole file*/
+    std::vector<char> Data; /**Bytes of the chunk, fewer than requested at the end of the file*/
+};
+
+/**
+ * @brief Reads up to _Length bytes (at most _FILECHUNK_MAX_BYTES) of the file
+ * at _Path, starting at _Offset.
+ *
+ * @return false if the file can not be opened or read. An _Offset at or
+ * past the end of the file gives an empty chunk.
+ */
+bool ReadFileChunk(const std::string& _Path, uint64_t _Offset, uint64_t _Length, FileChunk& _Chunk);
+
+/**
+ * @brief Turns a file handle received through the API into a path below
+ * _Directory, _Directory + _Handle + _Extension.
+ *
+ * Every ".." is removed from the handle, so that clients can not read files
+ * outside of _Directory. This is a minor security feature and probably still
+ * exploitable, so be warned!
+ *
+ * @param _Logger Warned when a ".." is removed, may be null.
+ */
+std::string SafeFilePath(BG::Common::Logger::LoggingSystem* _Logger, std::string _Handle, const std::string& _Directory, const std::string& _Extension = "");
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,71 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for chunked file reading.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <Util/FileChunk.h>
+
+
+/**
+ * @brief Test class for unit tests for ReadFileChunk.
+ *
+ */
+struct FileChunkTest : testing::Test {
+    std::string path;
+    std::string contents;
+
+    void SetUp() {
+        path = (std::filesystem::temp_directory_path() / ("FileChunkTest-" + std::to_string(::getpid()) + ".bin")).string();
+        for (int i = 0; i < 1000; i++) {
+            contents += char(i % 251);
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(contents.data(), contents.size());
+    }
+
+    void TearDown() {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(FileChunkTest, test_ReadFileChunk_chunks_make_up_file) {
+    std::string downloaded;
+    BG::NES::Util::FileChunk chunk;
+    for (uint64_t offset = 0; offset < contents.size(); offset += 300) {
+        ASSERT_TRUE(BG::NES::Util::ReadFileChunk(path, offset, 300, chunk));
+        ASSERT_EQ(chunk.Offset, offset);
+        ASSERT_EQ(chunk.FileSize, contents.size());
+        downloaded.append(chunk.Data.begin(), chunk.Data.end());
+    }
+    ASSERT_EQ(chunk.Data.size(), 100);
+    ASSERT_EQ(downloaded, contents);
+}
+
+TEST_F(FileChunkTest, test_ReadFileChunk_past_end_and_missing_file) {
+    BG::NES::Util::FileChunk chunk;
+    ASSERT_TRUE(BG::NES::Util::ReadFileChunk(path, contents.size(), 300, chunk));
+    ASSERT_TRUE(chunk.Data.empty());
+    ASSERT_EQ(chunk.FileSize, contents.size());
+
+    ASSERT_FALSE(BG::NES::Util::ReadFileChunk(path + ".missing", 0, 300, chunk));
+    ASSERT_FALSE(BG::NES::Util::ReadFileChunk(std::filesystem::temp_directory_path().string(), 0, 300, chunk));
+}
+
+TEST_F(FileChunkTest, test_SafeFilePath_stays_in_directory) {
+    ASSERT_EQ(BG::NES::Util::SafeFilePath(nullptr, "Image.png", "./"), "./Image.png");
+    ASSERT_EQ(BG::NES::Util::SafeFilePath(nullptr, "../../etc/passwd", "./"), ".///etc/passwd");
+    ASSERT_EQ(BG::NES::Util::SafeFilePath(nullptr, "...../Sim", "SavedSimulations/", ".NES"), "SavedSimulations/./Sim.NES");
+}
@@ -0,0 +1,89 @@
+#include <Util/WorkerTeam.h>
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+//! Number of polls before a waiting thread blocks on a condition variable.
+#define _WORKERTEAM_SPIN_LIMIT 4096
+
+WorkerTeam::WorkerTeam(size_t _NumMembers) {
+    size_t NumWorkers = (_NumMembers > 1) ? _NumMembers - 1 : 0;
+    Workers_.reserve(NumWorkers);
+    for (size_t i = 0; i < NumWorkers; i++) {
+        Workers_.emplace_back(&WorkerTeam::WorkerLoop, this, i + 1);
+    }
+}
+
+WorkerTeam::~WorkerTeam() {
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        Stop_.store(true);
+    }
+    StartCV_.notify_all();
+    for (auto & Worker : Workers_) {
+        Worker.join();
+    }
+}
+
+size_t WorkerTeam::Size() const {
+    return Workers_.size() + 1;
+}
+
+void WorkerTeam::Run(const std::function<void(size_t)>& _Task) {
+    if (Workers_.empty()) {
+        _Task(0);
+        return;
+    }
+
+    // Publish the task, then release the workers by starting a new generation.
+    Task_ = &_Task;
+    Pending_.store(Workers_.size(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        Generation_.fetch_add(1, std::memory_order_release);
+    }
+    StartCV_.notify_all();
+
+    _Task(0);
+
+    // Barrier: wait until every worker is done with this generation.
+    for (size_t Spins = 0; Pending_.load(std::memory_order_acquire) != 0; Spins++) {
+        if (Spins < _WORKERTEAM_SPIN_LIMIT) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> Lock(Mutex_);
+        DoneCV_.wait(Lock, [this]() { return Pending_.load(std::memory_order_acquire) == 0; });
+    }
+    Task_ = nullptr;
+}
+
+void WorkerTeam::WorkerLoop(size_t _MemberIndex) {
+    uint64_t SeenGeneration = 0;
+    while (true) {
+        for (size_t Spins = 0; Generation_.load(std::memory_order_acquire) == SeenGeneration; Spins++) {
+            if (Stop_.load()) return;
+            if (Spins < _WORKERTEAM_SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> Lock(Mutex_);
+            StartCV_.wait(Lock, [this, SeenGeneration]() {
+                return Stop_.load() || (Generation_.load(std::memory_order_acquire) != SeenGeneration);
+            });
+        }
+        SeenGeneration = Generation_.load(std::memory_order_acquire);
+
+        (*Task_)(_MemberIndex);
+
+        if (Pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> Lock(Mutex_);
+            DoneCV_.notify_one();
+        }
+    }
+}
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,93 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides a persistent team of worker threads for fork-join parallel loops.
+    Additional Notes: Threads are started once and reused for every Run() call, so that per-step
+                      parallel phases do not pay for thread creation.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Util {
+
+
+/**
+ * @brief Persistent fork-join thread team.
+ *
+ * Run() executes a task once on each member of the team and returns when all
+ * of them have finished, so consecutive Run() calls are separated by a barrier.
+ * The calling thread takes part as member 0, the other members are worker
+ * threads that wait between calls, briefly spinning before they block.
+ */
+class WorkerTeam {
+
+public:
+
+    /**
+     * @brief Starts _NumMembers - 1 worker threads.
+     *
+     * @param _NumMembers Number of team members including the calling thread, at least 1.
+     */
+    WorkerTeam(size_t _NumMembers);
+
+    /**
+     * @brief Stops and joins all worker threads.
+     */
+    ~WorkerTeam();
+
+    WorkerTeam(const WorkerTeam&) = delete;
+    WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+    /**
+     * @brief Returns the number of team members including the calling thread.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Calls _Task(MemberIndex) on every member and waits for all of them.
+     * Must only be called from one thread at a time, and not from inside a task.
+     *
+     * @param _Task Task to run, receives the member index in [0, Size()).
+     */
+    void Run(const std::function<void(size_t)>& _Task);
+
+private:
+
+    void WorkerLoop(size_t _MemberIndex);
+
+    std::vector<std::thread> Workers_; /**Worker threads, member i + 1 is Workers_[i]*/
+
+    std::mutex Mutex_;
+    std::condition_variable StartCV_;
+    std::condition_variable DoneCV_;
+
+    const std::function<void(size_t)>* Task_ = nullptr; /**Task of the current generation*/
+    std::atomic<uint64_t> Generation_{0}; /**Incremented for every Run() call*/
+    std::atomic<size_t> Pending_{0};      /**Workers that have not finished the current task*/
+    std::atomic<bool> Stop_{false};
+
+};
+
+
+}; // Close Namespace Util
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -197,8 +197,18 @@ bool ExecuteCaSubRenderOperations(BG::Common::Logger::LoggingSystem* _Logger, Si
     // -- Phase 3 -- 
     // Now, we're just going to go and render each of the different regions
     // This is done through simply running a for loop, and calling the rendersubregion code on each
+    // The shapes are indexed once here, as all subregions share the rotation of the base region
+    WorldInfo CullingInfo;
+    CullingInfo.VoxelScale_um = Params->VoxelResolution_um;
+    CullingInfo.WorldRotationOffsetX_rad = BaseRegion->SampleRotationX_rad;
+    CullingInfo.WorldRotationOffsetY_rad = BaseRegion->SampleRotationY_rad;
+    CullingInfo.WorldRotationOffsetZ_rad = BaseRegion->SampleRotationZ_rad;
+    Simulator::ShapeCullingIndex CullingIndex;
+    CullingIndex.Build(_Simulation, CullingInfo);
+
     _Logger->Log("Rendering " + std::to_string(SubRegions.size()) + " Calcium Sub Regions", 4);
     for (size_t i = 0; i < SubRegions.size(); i++) {
+        SubRegions[i].CullingIndex = &CullingIndex;
         CaRenderSubRegion(_Logger, &SubRegions[i], _ImageProcessorPool, _GeneratorPool);
         _Simulation->CaData_.CurrentRegion_ = i + 1;
     }
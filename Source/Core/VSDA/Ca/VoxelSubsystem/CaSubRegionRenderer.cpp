@@ -90,7 +90,7 @@ bool CaRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
         CaData_->Array_->ClearArrayThreaded(std::thread::hardware_concurrency());
         CaData_->Array_->SetBB(RequestedRegion);
     }
-    CaCreateVoxelArrayFromSimulation(_Logger, Sim, &CaData_->Params_, CaData_->Array_.get(), RequestedRegion, _GeneratorPool);
+    CaCreateVoxelArrayFromSimulation(_Logger, Sim, &CaData_->Params_, CaData_->Array_.get(), RequestedRegion, _GeneratorPool, _SubRegion->CullingIndex);
 
 
 
@@ -49,7 +49,7 @@ bool IsShapeInsideRegion(Simulator::Simulation* _Sim, size_t _ShapeID, Simulator
 
 }
 
-bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulator::Simulation* _Sim, CaMicroscopeParameters* _Params, VoxelArray* _Array, Simulator::ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool) {
+bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulator::Simulation* _Sim, CaMicroscopeParameters* _Params, VoxelArray* _Array, Simulator::ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool, const Simulator::ShapeCullingIndex* _CullingIndex) {
     assert(_Array != nullptr);
     assert(_Params != nullptr);
     assert(_Sim != nullptr);
@@ -79,14 +79,25 @@ bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger
     Info.WorldRotationOffsetZ_rad = _Region.SampleRotationZ_rad;
 
 
+    // Find the compartments inside the region, through the culling index of the render if there is one
+    std::vector<size_t> CompartmentIndices;
+    if (_CullingIndex != nullptr) {
+        _CullingIndex->Compartments.Query(RegionBoundingBox, CompartmentIndices);
+    } else {
+        for (size_t i = 0; i < _Sim->BSCompartments.size(); i++) {
+            if (IsShapeInsideRegion(_Sim, _Sim->BSCompartments[i].ShapeID, RegionBoundingBox, Info)) {
+                CompartmentIndices.push_back(i);
+            }
+        }
+    }
+
+
     // Build Bounding Boxes For All Compartments
     int AddedShapes = 0;
-    int TotalShapes = 0;
-    for (unsigned int i = 0; i < _Sim->BSCompartments.size(); i++) {
-
-        Simulator::Compartments::BS* ThisCompartment = &_Sim->BSCompartments[i];
+    int TotalShapes = _Sim->BSCompartments.size();
+    for (size_t i = 0; i < CompartmentIndices.size(); i++) {
 
-        TotalShapes++;
+        Simulator::Compartments::BS* ThisCompartment = &_Sim->BSCompartments[CompartmentIndices[i]];
 
         // Create a working task for the generatorpool to complete
         // Note that for calcium imaging, we need to keep track of the index of ths compartment which created this voxel
@@ -99,8 +110,8 @@ bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger
         Task->WorldInfo_ = Info;
         Task->CompartmentID_ = ThisCompartment->ID;
 
-        // Now submit to render queue if it's inside the region, otherwise skip it
-        if (IsShapeInsideRegion(_Sim, ThisCompartment->ShapeID, RegionBoundingBox, Info)) {
+        // Now submit to render queue, only shapes inside the region were selected above
+        {
             
             AddedShapes++;
 
@@ -36,6 +36,7 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <Simulator/Structs/Simulation.h>
+#include <VSDA/Common/Structs/ShapeCullingIndex.h>
 
 #include <VSDA/Ca/VoxelSubsystem/Structs/CaMicroscopeParameters.h>
 #include <VSDA/Ca/VoxelSubsystem/Structs/CaVoxelArray.h>
@@ -60,10 +61,11 @@ namespace Calcium {
  * @param _Sim Pointer to simulation that data is to be generated from
  * @param _Region Pointer to region in that simulation where we'll be generating an array
  * @param _Array Pointer to array to be populated.
+ * @param _CullingIndex Index of the shapes of _Sim built for this render, if null every shape is tested against the region.
  * @return true On success
  * @return false On failure (eg: out of memory, out of bounds, etc.)
  */
-bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulator::Simulation* _Sim, CaMicroscopeParameters* _Params, VoxelArray* _Array, Simulator::ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool);
+bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulator::Simulation* _Sim, CaMicroscopeParameters* _Params, VoxelArray* _Array, Simulator::ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool, const Simulator::ShapeCullingIndex* _CullingIndex = nullptr);
 
 
 
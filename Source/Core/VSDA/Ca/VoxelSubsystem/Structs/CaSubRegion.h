@@ -41,6 +41,7 @@
 // Internal Libraries (BG convention: use <> instead of "")
 // #include <VSDA/VoxelSubsystem/Structs/VoxelArray.h>
 #include <VSDA/Common/Structs/ScanRegion.h>
+#include <VSDA/Common/Structs/ShapeCullingIndex.h>
 
 #include <Simulator/Structs/Simulation.h>
 
@@ -72,6 +73,7 @@ struct SubRegion {
     // Working Data Params
     Simulator::ScanRegion Region;                       /**Region that we're going to perform the rendering on*/
     Simulator::Simulation* Sim;                         /**Simulation that we're rendering*/
+    const Simulator::ShapeCullingIndex* CullingIndex = nullptr; /**Index of the shapes of Sim, shared by all subregions of the render*/
     // std::unique_ptr<VoxelArray> RegionArray; /**Array for this region, which we deallocate when we're done with*/
     
 
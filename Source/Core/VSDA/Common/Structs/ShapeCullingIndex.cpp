@@ -0,0 +1,52 @@
+#include <cmath>
+
+#include <VSDA/Common/Structs/ShapeCullingIndex.h>
+
+
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+
+//! Culling box of the shape, NaN for shapes that are not rendered or are
+//! missing from the collection, which the hierarchy leaves out.
+static BoundingBox GetShapeCullingBox(Simulation* _Sim, size_t _ShapeID, VSDA::WorldInfo& _WorldInfo) {
+
+    Geometries::GeometryCollection* GeometryCollection = &_Sim->Collection;
+    if (_ShapeID >= GeometryCollection->Size()) {
+        return BoundingBox{ { NAN, NAN, NAN }, { NAN, NAN, NAN } };
+    }
+    if (GeometryCollection->IsSphere(_ShapeID)) {
+        return GeometryCollection->GetSphere(_ShapeID).GetCullingBox(_WorldInfo);
+    }
+    else if (GeometryCollection->IsBox(_ShapeID)) {
+        return GeometryCollection->GetBox(_ShapeID).GetCullingBox(_WorldInfo);
+    }
+    else if (GeometryCollection->IsCylinder(_ShapeID)) {
+        return GeometryCollection->GetCylinder(_ShapeID).GetCullingBox(_WorldInfo);
+    }
+
+    return BoundingBox{ { NAN, NAN, NAN }, { NAN, NAN, NAN } };
+}
+
+void ShapeCullingIndex::Build(Simulation* _Sim, VSDA::WorldInfo _WorldInfo) {
+
+    std::vector<BoundingBox> Boxes(_Sim->BSCompartments.size());
+    for (size_t i = 0; i < _Sim->BSCompartments.size(); i++) {
+        Boxes[i] = GetShapeCullingBox(_Sim, _Sim->BSCompartments[i].ShapeID, _WorldInfo);
+    }
+    Compartments.Build(Boxes);
+
+    Boxes.resize(_Sim->Receptors.size());
+    for (size_t i = 0; i < _Sim->Receptors.size(); i++) {
+        Boxes[i] = GetShapeCullingBox(_Sim, _Sim->Receptors[i]->ShapeID, _WorldInfo);
+    }
+    Receptors.Build(Boxes);
+}
+
+
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
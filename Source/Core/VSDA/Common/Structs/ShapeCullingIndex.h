@@ -0,0 +1,53 @@
+//=================================//
+// This file is part of BrainGenix //
+//=================================//
+
+/*
+    Description: This file defines the shape culling index, which finds the shapes of a simulation inside a scan region.
+    Additional Notes: It is built once per render and queried for every subregion of the render.
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Structs/BoundingVolumeHierarchy.h>
+#include <Simulator/Structs/Simulation.h>
+#include <VSDA/Common/Structs/WorldInfo.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+
+/**
+ * @brief Bounding volume hierarchies over the culling boxes of the shapes that are rendered.
+ * A shape is found for a region exactly when its IsInsideRegion is true for it.
+ */
+struct ShapeCullingIndex {
+
+    BoundingVolumeHierarchy Compartments; /**Shapes of Simulation::BSCompartments, by compartment index*/
+    BoundingVolumeHierarchy Receptors;    /**Shapes of Simulation::Receptors, by receptor index*/
+
+    /**
+     * @brief Builds both hierarchies for the shapes of _Sim in the rotated world of _WorldInfo.
+     * The simulation must not be changed until the index is no longer used.
+     *
+     * @param _Sim Simulation whose shapes are indexed
+     * @param _WorldInfo World rotation of the render
+     */
+    void Build(Simulation* _Sim, VSDA::WorldInfo _WorldInfo);
+
+};
+
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
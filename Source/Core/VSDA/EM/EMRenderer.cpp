@@ -36,6 +36,31 @@ namespace VSDA {
 
 
 
+/**
+ * @brief Splits the given subregion into a lower and an upper half along z, on a slice boundary.
+ * Used to retry a subregion whose voxel array did not fit in memory, returns false if it is only one slice thick.
+ */
+static bool SplitSubRegionZ(const SubRegion& _SubRegion, double _VoxelResolution_um, int _NumVoxelsPerSlice, SubRegion* _Lower, SubRegion* _Upper) {
+
+    int NumVoxelsZ = abs(_SubRegion.Region.Point2Z_um - _SubRegion.Region.Point1Z_um) / _VoxelResolution_um;
+    int NumSlices = ceil(double(NumVoxelsZ) / double(_NumVoxelsPerSlice));
+    if (NumSlices < 2) {
+        return false;
+    }
+
+    // The images are numbered from the layer offset, so the upper half continues where the lower one stops
+    int LowerVoxelsZ = (NumSlices / 2) * _NumVoxelsPerSlice;
+    double SplitZ_um = _SubRegion.Region.Point1Z_um + LowerVoxelsZ * _VoxelResolution_um;
+    (*_Lower) = _SubRegion;
+    _Lower->Region.Point2Z_um = SplitZ_um;
+    (*_Upper) = _SubRegion;
+    _Upper->Region.Point1Z_um = SplitZ_um;
+    _Upper->LayerOffset += LowerVoxelsZ;
+    return true;
+
+}
+
+
 bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Simulation, ImageProcessorPool* _ImageProcessorPool, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool) {
 
     // Check that the simulation has been initialized and everything is ready to have work done
@@ -64,18 +89,25 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
     double ScalingFactor = _Config->VoxelArrayPercentOfSystemMemory_ / 100.;
 
 
+    // The voxel array only allocates the bricks that shapes are drawn into, so if only part of the volume is expected to be occupied,
+    // the array can cover correspondingly more voxels (and we need fewer subregions)
+    double ExpectedOccupancy = std::clamp(_Config->VoxelArrayExpectedOccupancyPercent_ / 100., 0.01, 1.);
+
     // Now, calculate the maximum number of voxels in system ram
-    uint64_t MaxVoxels = uint64_t(double(getTotalSystemMemory()) * ScalingFactor) / sizeof(VoxelType);
+    uint64_t MaxVoxels = uint64_t(double(getTotalSystemMemory()) * ScalingFactor / ExpectedOccupancy) / sizeof(VoxelType);
     size_t MaxVoxelArraySizeOnAxisInRAM = std::cbrt(MaxVoxels);
 
     size_t MaxVoxelArrayAxisSize_vox = std::min(MaxVoxelSizeLimit, MaxVoxelArraySizeOnAxisInRAM);
 
+    // The occupancy is only a guess, so the bricks actually allocated are held to the memory limit itself
+    uint64_t MaxArrayMemory_bytes = uint64_t(double(getTotalSystemMemory()) * ScalingFactor);
+
 
     // Make Log Message about memory consumption figures
-    double MemorySize_MB = ((MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox) * sizeof(VoxelType)) / 1024. / 1024;
+    double MemorySize_MB = ((MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox) * sizeof(VoxelType)) * ExpectedOccupancy / 1024. / 1024;
     double SystemRAM_MB = double(getTotalSystemMemory()) / 1024. / 1024.; 
     std::string LogMessage = "Using Maximum Voxel Array Dimensions Of '" + std::to_string(MaxVoxelArrayAxisSize_vox) + "', This May Use Up To ~" + std::to_string(round(MemorySize_MB)) + "MiB";
-    LogMessage += " (" + std::to_string(ScalingFactor*100) + "% of ~" + std::to_string(round(SystemRAM_MB)) + "MiB System Memory)";
+    LogMessage += " (" + std::to_string(ScalingFactor*100) + "% of ~" + std::to_string(round(SystemRAM_MB)) + "MiB System Memory, At " + std::to_string(ExpectedOccupancy*100) + "% Occupancy)";
     _Logger->Log(LogMessage, 3);
 
 
@@ -106,6 +138,7 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
     if (ImagesPerSubRegionX == 0 || ImagesPerSubRegionY == 0) {
         _Logger->Log("Error, You Don't Have Enough Memory To Render Images At " + std::to_string(Params->ImageWidth_px) + " by " + std::to_string(Params->ImageHeight_px) + " Try Reducing The Image Resolution", 8);
         _Logger->Log("Render Aborted", 9);
+        _Simulation->VSDAData_.State_ = VSDA_RENDER_FAILED;
         return false;
     }
     double SubRegionStepSizeX_um = ImagesPerSubRegionX * ImageStepSizeX_um;
@@ -201,6 +234,7 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
                 ThisSubRegion.MaxImagesX = ImagesPerSubRegionX;
                 ThisSubRegion.MaxImagesY = ImagesPerSubRegionY;                
                 ThisSubRegion.LayerOffset = ZStep * MaxVoxelArrayAxisSize_vox;
+                ThisSubRegion.MaxArrayMemory_bytes = MaxArrayMemory_bytes;
                 ThisSubRegion.Region = ThisRegion;
 
                 _Logger->Log("Created SubRegion At Location " + ThisRegion.ToString() + " Of Size " + ThisRegion.GetDimensionsInVoxels(Params->VoxelResolution_um), 3);
@@ -218,10 +252,39 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
     // -- Phase 3 -- 
     // Now, we're just going to go and render each of the different regions
     // This is done through simply running a for loop, and calling the rendersubregion code on each
+    // The shapes are indexed once here, as all subregions share the rotation of the base region
+    _Simulation->VSDAData_.CurrentOperation_ = "Indexing Shapes";
+    BG::NES::VSDA::WorldInfo CullingInfo;
+    CullingInfo.VoxelScale_um = Params->VoxelResolution_um;
+    CullingInfo.WorldRotationOffsetX_rad = BaseRegion->SampleRotationX_rad;
+    CullingInfo.WorldRotationOffsetY_rad = BaseRegion->SampleRotationY_rad;
+    CullingInfo.WorldRotationOffsetZ_rad = BaseRegion->SampleRotationZ_rad;
+    ShapeCullingIndex CullingIndex;
+    CullingIndex.Build(_Simulation, CullingInfo);
+    _Logger->Log("Indexed " + std::to_string(CullingIndex.Compartments.Size()) + " Compartment And " + std::to_string(CullingIndex.Receptors.Size()) + " Receptor Shapes", 4);
+
+    // If a subregion runs out of memory (more of it is occupied than expected), it is split in half along z and the halves are rendered instead
+    int NumVoxelsPerSliceZ = std::max(1, int(Params->SliceThickness_um / Params->VoxelResolution_um));
+    bool RenderFailed = false;
+    size_t NumSplits = 0;
     _Logger->Log("Rendering " + std::to_string(SubRegions.size()) + " Sub Regions", 4);
     for (size_t i = 0; i < SubRegions.size(); i++) {
-        EMRenderSubRegion(_Logger, &SubRegions[i], _ImageProcessorPool, _GeneratorPool);
-        _Simulation->VSDAData_.CurrentRegion_ = i + 1;
+        SubRegions[i].CullingIndex = &CullingIndex;
+        if (!EMRenderSubRegion(_Logger, &SubRegions[i], _ImageProcessorPool, _GeneratorPool)) {
+            SubRegion Lower, Upper;
+            if (!SplitSubRegionZ(SubRegions[i], Params->VoxelResolution_um, NumVoxelsPerSliceZ, &Lower, &Upper)) {
+                _Logger->Log("Error, SubRegion At " + SubRegions[i].Region.ToString() + " Does Not Fit In Memory Even At One Slice Thick, Try Raising VSDA_EM_PercentOfSysteMemoryLimit", 8);
+                _Logger->Log("Render Aborted", 9);
+                RenderFailed = true;
+                break;
+            }
+            _Logger->Log("Splitting SubRegion At " + SubRegions[i].Region.ToString() + " In Two Along Z And Retrying", 6);
+            SubRegions.insert(SubRegions.begin() + i + 1, {Lower, Upper});
+            NumSplits++;
+            _Simulation->VSDAData_.TotalRegions_ = SubRegions.size() - NumSplits;
+            continue;
+        }
+        _Simulation->VSDAData_.CurrentRegion_ = i + 1 - NumSplits;
     }
 
 
@@ -234,9 +297,11 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
     Empty.Point2Y_um = 0.;
     Empty.Point2Z_um = 0.;
     _Simulation->VSDAData_.Array_ = std::make_unique<VoxelArray>(_Logger, Empty, 999.);
-    _Simulation->VSDAData_.State_ = VSDA_RENDER_DONE;
 
-    return true;
+    // A client polling the render status must be able to tell a partial image stack from a complete one
+    _Simulation->VSDAData_.State_ = RenderFailed ? VSDA_RENDER_FAILED : VSDA_RENDER_DONE;
+
+    return !RenderFailed;
 
 }
 
@@ -53,8 +53,8 @@ bool EMRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
 
     // Create Voxel Array
     _Logger->Log(std::string("Creating Voxel Array Of Size ") + RequestedRegion.Dimensions() + std::string(" With Points ") + RequestedRegion.ToString(), 2);
-    uint64_t TargetArraySize = RequestedRegion.GetVoxelSize(VSDAData_->Params_.VoxelResolution_um);
-    if (VSDAData_->Array_.get() == nullptr || VSDAData_->Array_->GetSize() <= TargetArraySize) {
+    uint64_t TargetArraySize = VoxelArray::GetStorageLength(RequestedRegion, VSDAData_->Params_.VoxelResolution_um);
+    if (VSDAData_->Array_.get() == nullptr || VSDAData_->Array_->GetSize() < TargetArraySize) {
         _Logger->Log("Voxel Array Does Not Exist Yet Or Is Wrong Size, (Re)Creating Now", 2);
         VSDAData_->Array_ = std::make_unique<VoxelArray>(_Logger, ScanRegion(), 99.);
         VSDAData_->Array_ = std::make_unique<VoxelArray>(_Logger, RequestedRegion, VSDAData_->Params_.VoxelResolution_um);
@@ -65,10 +65,11 @@ bool EMRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
             _Logger->Log("Critical Internal Error, Failed to Set Size Of Voxel Array! This Should NEVER HAPPEN", 10);
             exit(999);
         }
-        VSDAData_->Array_->ClearArrayThreaded(std::thread::hardware_concurrency());
+        VSDAData_->Array_->ClearArrayThreaded();
         // VSDAData_->Array_->ClearArray();
         VSDAData_->Array_->SetBB(RequestedRegion);
     }
+    VSDAData_->Array_->SetBrickBudget(_SubRegion->MaxArrayMemory_bytes);
 
 
     // Initialize Stats
@@ -80,7 +81,20 @@ bool EMRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
     VSDAData_->VoxelQueueLength_ = 0;
     VSDAData_->TotalVoxelQueueLength_ = 0;
 
-    CreateVoxelArrayFromSimulation(_Logger, Sim, &VSDAData_->Params_, VSDAData_->Array_.get(), RequestedRegion, _GeneratorPool);
+    CreateVoxelArrayFromSimulation(_Logger, Sim, &VSDAData_->Params_, VSDAData_->Array_.get(), RequestedRegion, _GeneratorPool, _SubRegion->CullingIndex);
+
+    // Now that rasterization is done, free the bricks that ended up uniform (such as those fully inside a shape without noise)
+    uint64_t FreedBricks = VSDAData_->Array_->CompactBricks();
+    uint64_t AllocatedBricks, TotalBricks;
+    VSDAData_->Array_->GetBrickUsage(&AllocatedBricks, &TotalBricks);
+    _Logger->Log("Voxel Array Uses " + std::to_string(AllocatedBricks) + " Of " + std::to_string(TotalBricks) + " Bricks After Freeing " + std::to_string(FreedBricks) + " Uniform Bricks", 3);
+
+    // If bricks could not be allocated, some shapes are missing from the array, so don't render any images from it
+    if (VSDAData_->Array_->HasRunOutOfMemory()) {
+        _Logger->Log("Voxel Array Ran Out Of Memory While Rasterizing This SubRegion, Not Rendering It", 8);
+        VSDAData_->Array_->ClearArrayThreaded();
+        return false;
+    }
 
 
 
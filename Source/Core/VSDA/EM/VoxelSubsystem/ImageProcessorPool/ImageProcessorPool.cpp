@@ -106,73 +106,32 @@ void ImageProcessorPool::EncoderThreadMainFunction(int _ThreadNumber) {
             Image OneToOneVoxelImage(VoxelsPerStepX, VoxelsPerStepY, NumChannels);
             OneToOneVoxelImage.TargetFileName_ = Task->TargetFileName_;
 
-            // Now enumerate the voxel array and populate the image with the desired pixels (for the subregion we're on)
-            for (unsigned int XVoxelIndex = Task->VoxelStartingX; XVoxelIndex < Task->VoxelEndingX; XVoxelIndex++) {
-                for (unsigned int YVoxelIndex = Task->VoxelStartingY; YVoxelIndex < Task->VoxelEndingY; YVoxelIndex++) {
-
-                    // -- Compositor Rules -- //
-                    // In order for us to have some way that the system can repeatibly handle information, we define these rules
-                    // They specify what will show up from a multilayer voxel array
-                    // Firstly, we render from bottom to top - that is, from a lower Z height to a higher Z Height.
-                    // Any debug colors (from bottom to top, whichever is encountered earlier), will overwrite any color in the pixels
-                    // This will also terminate the continuation of enumerating up the Z height
-                    // Other than those enums, we will pick the darkest color currently <--- NO WE DON'T WE JUST PICK THE TOP ONE!
-                    // This isn't super realistic and needs to be fixed later, (such as with a focal distance, and blurring), but it works for now
-
-
-                    // Enumerate Depth, Compose based on rules defined above
-                    VoxelType PresentingVoxel;
-                    uint8_t DarkestVoxel = __UINT8_MAX__;
-                    for (size_t ZIndex = Task->VoxelZ; ZIndex < Task->VoxelZ + Task->SliceThickness_vox; ZIndex++) {
-
-                        // Get Voxel At Position
-                        VoxelType ThisVoxel = Task->Array_->GetVoxel(XVoxelIndex, YVoxelIndex, ZIndex);
-                        // if (ThisVoxel.State_ == VOXELSTATE_INTENSITY) {
-                            // if (ThisVoxel.Intensity_ < DarkestVoxel) {
-                        PresentingVoxel = ThisVoxel;
-                        DarkestVoxel = ThisVoxel.Intensity_;
-                            // }
-                        // Else, we have a special debug voxel, set this to be the one shown, and exit.
-                        // } else {
-                        //     PresentingVoxel = ThisVoxel;
-                        //     break;
-                        // }
-
-                    }
-
-                    // Add Noise, Intensity Based On Noise Amount
-                    int Intensity = PresentingVoxel.Intensity_;
-                    // if (Task->EnableImageNoise) {
-                    //     Intensity += (RandomGenerator() % Task->ImageNoiseAmount) - int(Task->ImageNoiseAmount/2);
-                    //     Intensity = std::clamp(Intensity, 0, 255);
-                    // }
-
-                    // Now Set The Pixel
-                    int ThisPixelX = XVoxelIndex - Task->VoxelStartingX;
-                    int ThisPixelY = YVoxelIndex - Task->VoxelStartingY;
-
-                    // Check if the voxel is in the enum reserved range, otherwise it's a color value from 128-255
-                    // if (PresentingVoxel.State_ == VOXELSTATE_INTENSITY) {
-                    OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, Intensity);
-                        
-                    // } else {
-                    //     if (PresentingVoxel.State_ == BORDER) {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 255, 128, 50);
-                    //     } else if (PresentingVoxel.State_ == OUT_OF_RANGE) {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0, 0, 255);
-                    //     } else if (PresentingVoxel.State_ == VOXELSTATE_RED) {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 255, 0, 0);
-                    //     } else if (PresentingVoxel.State_ == VOXELSTATE_GREEN) {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0, 255, 0);
-                    //     } else if (PresentingVoxel.State_ == VOXELSTATE_BLUE) {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0, 0, 255);
-                    //     } else {
-                    //         OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 200, 200, 200);
-                    //     }
-                    // }
-
-                }
-            }
+            // -- Compositor Rules -- //
+            // In order for us to have some way that the system can repeatibly handle information, we define these rules
+            // They specify what will show up from a multilayer voxel array
+            // Firstly, we render from bottom to top - that is, from a lower Z height to a higher Z Height.
+            // Other than those enums, we will pick the darkest color currently <--- NO WE DON'T WE JUST PICK THE TOP ONE!
+            // This isn't super realistic and needs to be fixed later, (such as with a focal distance, and blurring), but it works for now
+            // Since the top voxel always wins, only the top slice of the depth range is read.
+            int PresentingZ = Task->VoxelZ + std::max(Task->SliceThickness_vox, 1) - 1;
+
+            // Now read that slice of the voxel array brick by brick and populate the image with the desired pixels (for the subregion we're on)
+            // Pixels outside of the array are left at 0, as the image is created zeroed
+            Task->Array_->ForEachVoxelInSlice(Task->VoxelStartingX, Task->VoxelEndingX, Task->VoxelStartingY, Task->VoxelEndingY, PresentingZ, [&](int _X, int _Y, const VoxelType& _Voxel) {
+
+                // Add Noise, Intensity Based On Noise Amount
+                int Intensity = _Voxel.Intensity_;
+                // if (Task->EnableImageNoise) {
+                //     Intensity += (RandomGenerator() % Task->ImageNoiseAmount) - int(Task->ImageNoiseAmount/2);
+                //     Intensity = std::clamp(Intensity, 0, 255);
+                // }
+
+                // Now Set The Pixel
+                int ThisPixelX = _X - Task->VoxelStartingX;
+                int ThisPixelY = _Y - Task->VoxelStartingY;
+                OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, Intensity);
+
+            });
 
             // Note, when we do image processing (for like noise and that stuff, we should do it here!) (or after resizing depending on what is needed)
             // so then this will be phase two, and phase 3 is saving after processing
@@ -47,7 +47,7 @@ Geometries::Vec3D RotatedVec(float _X, float _Y, float _Z, float _RY, float _RZ,
 VoxelType GenerateVoxelColor(float _X_um, float _Y_um, float _Z_um, MicroscopeParameters* _Params, noise::module::Perlin* _Generator, int _Offset=0) {
 
     // Now, generate the color based on some noise constraints, Clamp it between 0 and 1, then scale based on parameters
-    double NoiseValue;
+    double NoiseValue = 0.;
     if (_Params->GeneratePerlinNoise_) {
         float SpatialScale = _Params->SpatialScale_;
         NoiseValue = _Generator->GetValue(_X_um * SpatialScale, _Y_um * SpatialScale, _Z_um * SpatialScale);
@@ -109,51 +109,70 @@ VoxelType CalculateBorderColor(VoxelType _Source, float _DistanceFromEdge, Micro
 }
 
 bool FillSphere(VoxelArray* _Array, Geometries::Sphere* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
-    assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
-    assert(_Params != nullptr);
-    assert(_Generator != nullptr);
-
-    BoundingBox BB = _Shape->GetBoundingBox(_WorldInfo);
-
-    for (float X = BB.bb_point1[0]; X < BB.bb_point2[0]; X+= _WorldInfo.VoxelScale_um) {
-        for (float Y = BB.bb_point1[1]; Y < BB.bb_point2[1]; Y+= _WorldInfo.VoxelScale_um) {
-            for (float Z = BB.bb_point1[2]; Z < BB.bb_point2[2]; Z+= _WorldInfo.VoxelScale_um) {
-                if (_Shape->IsPointInShape(Geometries::Vec3D(X, Y, Z), _WorldInfo)) {
-                    VoxelType FinalVoxelValue = GenerateVoxelColor(X, Y, Z, _Params, _Generator);
-                    if (_Params->RenderBorders) {
-                        float DistanceToEdge = _Shape->Radius_um - Geometries::Vec3D(X, Y, Z).Distance(_Shape->Center_um);
-                        FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, DistanceToEdge, _Params);
-                    }
-                    _Array->SetVoxelIfNotDarker(X, Y, Z, FinalVoxelValue);
-                }
-            }
-        }
-    }
-
-    return true;
-
+    return FillSpherePart(1, 0, _Array, _Shape, _WorldInfo, _Params, _Generator);
 }
 
 bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Sphere*_Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
-    assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
+    assert(_WorldInfo.VoxelScale_um != 0);
     assert(_Params != nullptr);
     assert(_Generator != nullptr);
 
-    BoundingBox BB = _Shape->GetBoundingBox(_WorldInfo);
+    // The sphere is drawn one (Y,Z) row of voxels at a time. For each row, the sphere equation gives the X span
+    // inside the sphere directly, and a second, smaller sphere (shrunk by the border thickness) gives the part
+    // of that span which is plain interior. Only the voxels between the two get border shading.
+    Geometries::Vec3D Center_um = _Shape->Center_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+    double Radius_um = _Shape->Radius_um;
+    double InnerRadius_um = _Params->RenderBorders ? Radius_um - _Params->BorderThickness_um : Radius_um;
+    double Scale_um = _WorldInfo.VoxelScale_um;
+    Geometries::Vec3D Origin_um = _Array->GetPositionAtIndex(0, 0, 0);
+
+    // Without noise, every interior voxel gets the same value
+    bool UniformInterior = !_Params->GeneratePerlinNoise_;
+    VoxelType InteriorValue = GenerateVoxelColor(Center_um.x, Center_um.y, Center_um.z, _Params, _Generator);
+
+    int StartZ = std::max(0, int(ceil((Center_um.z - Radius_um - Origin_um.z) / Scale_um)));
+    int EndZ = std::min(_Array->GetZ() - 1, int(floor((Center_um.z + Radius_um - Origin_um.z) / Scale_um)));
+    int StartY = std::max(0, int(ceil((Center_um.y - Radius_um - Origin_um.y) / Scale_um)));
+    int EndY = std::min(_Array->GetY() - 1, int(floor((Center_um.y + Radius_um - Origin_um.y) / Scale_um)));
+
+    // Rows are split between the parts by Z, so parts never write the same voxel
+    for (int Z = StartZ + _ThisThread; Z <= EndZ; Z += _TotalThreads) {
+        double DZ = Origin_um.z + Z * Scale_um - Center_um.z;
+        for (int Y = StartY; Y <= EndY; Y++) {
+            double DY = Origin_um.y + Y * Scale_um - Center_um.y;
+            double RowDistance2 = DY * DY + DZ * DZ;
+            double HalfSpan2 = Radius_um * Radius_um - RowDistance2;
+            if (HalfSpan2 < 0.) {
+                continue;
+            }
 
-    for (float X = BB.bb_point1[0] + (_ThisThread * _WorldInfo.VoxelScale_um); X < BB.bb_point2[0]; X+= (_TotalThreads * _WorldInfo.VoxelScale_um)) {
-        for (float Y = BB.bb_point1[1]; Y < BB.bb_point2[1]; Y+= _WorldInfo.VoxelScale_um) {
-            for (float Z = BB.bb_point1[2]; Z < BB.bb_point2[2]; Z+= _WorldInfo.VoxelScale_um) {
-                if (_Shape->IsPointInShape(Geometries::Vec3D(X, Y, Z), _WorldInfo)) {
-                    VoxelType FinalVoxelValue = GenerateVoxelColor(X, Y, Z, _Params, _Generator);
+            // Voxel X indices whose centers are inside the sphere, and those inside the inner sphere
+            double HalfSpan_um = sqrt(HalfSpan2);
+            int SpanStartX = int(ceil((Center_um.x - HalfSpan_um - Origin_um.x) / Scale_um));
+            int SpanEndX = int(floor((Center_um.x + HalfSpan_um - Origin_um.x) / Scale_um));
+            int InnerStartX = SpanEndX + 1;
+            int InnerEndX = SpanEndX;
+            double InnerHalfSpan2 = InnerRadius_um * InnerRadius_um - RowDistance2;
+            if (InnerRadius_um > 0. && InnerHalfSpan2 > 0.) {
+                double InnerHalfSpan_um = sqrt(InnerHalfSpan2);
+                InnerStartX = int(ceil((Center_um.x - InnerHalfSpan_um - Origin_um.x) / Scale_um));
+                InnerEndX = int(floor((Center_um.x + InnerHalfSpan_um - Origin_um.x) / Scale_um));
+            }
 
-                    if (_Params->RenderBorders) {
-                        float DistanceToEdge = _Shape->Radius_um - Geometries::Vec3D(X, Y, Z).Distance(_Shape->Center_um);
-                        FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, DistanceToEdge, _Params);
-                    }
-                    _Array->SetVoxelIfNotDarker(X, Y, Z, FinalVoxelValue);
+            _Array->ForEachVoxelInSliceForWrite(SpanStartX, SpanEndX + 1, Y, Y + 1, Z, [&](int _X, int _Y, VoxelType& _Voxel) {
+                VoxelType FinalVoxelValue = InteriorValue;
+                float X_um = Origin_um.x + _X * Scale_um;
+                if (!UniformInterior) {
+                    FinalVoxelValue = GenerateVoxelColor(X_um, Origin_um.y + _Y * Scale_um, Origin_um.z + Z * Scale_um, _Params, _Generator);
                 }
-            }
+                if (_Params->RenderBorders && (_X < InnerStartX || _X > InnerEndX)) {
+                    double DX = X_um - Center_um.x;
+                    FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, Radius_um - sqrt(DX * DX + RowDistance2), _Params);
+                }
+                if (VoxelArray::IsReplacedBy(_Voxel, FinalVoxelValue)) {
+                    _Voxel = FinalVoxelValue;
+                }
+            });
         }
     }
 
@@ -161,130 +180,11 @@ bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geom
 
 }
 
-int isPointInCylinder(const Geometries::Vec3D& P1, const Geometries::Vec3D& P2, double r1, double r2, const Geometries::Vec3D& point) {
-	// Vector from P1 to P2
-	Geometries::Vec3D axis = P2 - P1;
-	double height = axis.Magnitude();
-	Geometries::Vec3D axisDir = axis.Normalize();
-    
-	// Vector from P1 to the point
-	Geometries::Vec3D pointVector = point - P1;
-    
-	// Projection of pointVector onto the axis
-	double projectionLength = pointVector.Dot(axisDir);
-    
-	// Check if the point is within the bounds along the axis
-	if (projectionLength < 0) {
-        return 1;
-    }
-    if (projectionLength > height) {
-        return 2;
-    	//return false;
-	}
-
-	// Calculate the radius at the projection point along the cylinder's height
-	double currentRadius = r1 + (r2 - r1) * (projectionLength / height);
-
-	// Closest point on the axis to the given point
-	Geometries::Vec3D closestPointOnAxis = P1 + axisDir * projectionLength;
 
-	// Distance from the point to the closest point on the axis
-	double distanceToAxis = (point - closestPointOnAxis).Magnitude();
-    
-	// Check if the distance is within the current radius
-	//return distanceToAxis <= currentRadius;
-    if (distanceToAxis <= currentRadius) {
-        return 0;
-    }
-    return 3;
+bool FillCylinder(VoxelArray* _Array, Geometries::Cylinder* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
+    return FillCylinderPart(1, 0, _Array, _Shape, _WorldInfo, _Params, _Generator);
 }
 
-// THIS ONE IS RIDDLED WITH BUGS! USE FillCylinderPart()!!!!!
-// Note that _WorldInfo.VoxelScale_um == _Params->VoxelResolution_um.
-// bool FillCylinder(VoxelArray* _Array, Geometries::Cylinder* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
-//     assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
-//     assert(_Params != nullptr);
-//     assert(_Generator != nullptr);
-
-//     // Rotate The Endpoints Around World Origin By Amount Set In World Info
-//     //   This deals with the rotation of the whole model
-//     Geometries::Vec3D RotatedEnd0_um = _Shape->End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-//     Geometries::Vec3D RotatedEnd1_um = _Shape->End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-
-//     /**
-//      * New method:
-//      * 1) Walk along integer Z steps of the 3D Voxel space (layers).
-//      * 2) For each Z step, we know where that is in 3D float space.
-//      * 3) We know a point in 3D float space (x,y,z) on the cylinder mid-line.
-//      * 4) We find a 2D bounding box around that point expressed in Voxel space X,Y voxels.
-//      * 5) We test each point in that voxel space to see if it is in the cylinder.
-//      */
-//     // Calculate all the points and stuff them into the array
-
-//     // Firstly calculate the Z height of the start and end points on the cylinder
-
-//     Geometries::Vec3D DifferenceVector = RotatedEnd1_um - RotatedEnd0_um;
-//     Geometries::Vec3D UnitVector = DifferenceVector / RotatedEnd1_um.Distance(RotatedEnd0_um);
-//     Geometries::Vec3D ScaledUnitVector_um = UnitVector * _Params->VoxelResolution_um;
-
-//     float MaxRadius_um = std::max(_Shape->End0Radius_um, _Shape->End1Radius_um);
-//     Geometries::Vec3D Offset_um = UnitVector * MaxRadius_um;
-
-//     Geometries::Vec3D ShiftedEnd0_um = RotatedEnd0_um - Offset_um;
-//     Geometries::Vec3D ShiftedEnd1_um = RotatedEnd1_um + Offset_um;
-
-//     int StartZ = _Array->GetZIndexAtPosition(std::min(ShiftedEnd0_um.z, ShiftedEnd1_um.z));
-//     int EndZ = _Array->GetZIndexAtPosition(std::max(ShiftedEnd0_um.z, RotatedEnd1_um.z));
-
-    
-//     // Now enumerate the entire cylinder one z layer at a time, and test voxels in a square (of size r) at that layer
-//     // Notice that this loop does not count from 0 but from StartZ! Beware of this when mapping back to world coordinates!
-//     for (int CurrentZIndex = StartZ; CurrentZIndex < EndZ; CurrentZIndex++) {
-
-//         Geometries::Vec3D CylinderMidpointAtCurrentLayer_um = ShiftedEnd0_um + (ScaledUnitVector_um * (CurrentZIndex - StartZ ));
-
-//         // Now create a square at the midpoint here, and then test all points in that square
-//         int XTestSpaceMin = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x - MaxRadius_um);
-//         int XTestSpaceMax = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x + MaxRadius_um);
-//         int YTestSpaceMin = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y - MaxRadius_um);
-//         int YTestSpaceMax = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y + MaxRadius_um);
-
-//         for (int CurrentYIndex = YTestSpaceMin; CurrentYIndex <= YTestSpaceMax; CurrentYIndex++) {
-//             for (int CurrentXIndex = XTestSpaceMin; CurrentXIndex <= XTestSpaceMax; CurrentXIndex++) {
-
-
-//                 Geometries::Vec3D CurrentWorldSpacePosition_um = _Array->GetPositionAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex);
-
-//                 int res = isPointInCylinder(RotatedEnd0_um, RotatedEnd1_um, _Shape->End0Radius_um, _Shape->End1Radius_um, CurrentWorldSpacePosition_um);
-//                 if (res==0) {
-
-
-//                     VoxelType FinalVoxelValue = GenerateVoxelColor(CurrentWorldSpacePosition_um.x, CurrentWorldSpacePosition_um.y, CurrentWorldSpacePosition_um.z, _Params, _Generator);
-//                     if (_Params->RenderBorders) {
-//                         float DistanceToEdge = CurrentWorldSpacePosition_um.Distance(CylinderMidpointAtCurrentLayer_um);
-//                         FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, DistanceToEdge, _Params);
-//                     }
-
-//                     _Array->SetVoxelAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex, FinalVoxelValue);
-
-//                 }
-
-//             }
-//         }
-
-
-//     }
-
-//     // if (tot<1) {
-//     //     std::cout << "StartZ == EndZ!\n";
-//     // } else {
-//     //     std::cout << "tot: " << tot << " within: " << within << " above: " << above << " below: " << below << " toofar: " << toofar << '\n';
-//     // }
-
-//     return true;
-
-// }
-
 /**
  * This is the older version. It would be interesting to do an actual head-to-head speed comparison between old and new versions.
  */
@@ -360,129 +260,80 @@ bool TEST_FillCylinder(VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA
 }
 
 bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Cylinder* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
-    assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
+    assert(_WorldInfo.VoxelScale_um != 0);
     assert(_Params != nullptr);
     assert(_Generator != nullptr);
 
-    // Rotate The Endpoints Around World Origin By Amount Set In World Info
-    //   This deals with the rotation of the whole model
-    Geometries::Vec3D RotatedEnd0_um = _Shape->End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-    Geometries::Vec3D RotatedEnd1_um = _Shape->End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-
-    /**
-     * New method:
-     * 1) Walk along integer Z steps of the 3D Voxel space (layers).
-     * 2) For each Z step, we know where that is in 3D float space.
-     * 3) We know a point in 3D float space (x,y,z) on the cylinder mid-line.
-     * 4) We find a 2D bounding box around that point expressed in Voxel space X,Y voxels.
-     * 5) We test each point in that voxel space to see if it is in the cylinder.
-     */
-    // Calculate all the points and stuff them into the array
-
-    // Firstly calculate the Z height of the start and end points on the cylinder
-
-    Geometries::Vec3D DifferenceVector_um = RotatedEnd1_um - RotatedEnd0_um;
-    float CylinderLength_um = RotatedEnd1_um.Distance(RotatedEnd0_um);
-    Geometries::Vec3D UnitVector = DifferenceVector_um / CylinderLength_um;
-    Geometries::Vec3D ScaledUnitVector_um = UnitVector * _Params->VoxelResolution_um;
-
-    float MaxRadius_um = std::max(_Shape->End0Radius_um, _Shape->End1Radius_um);
-    Geometries::Vec3D Offset_um = UnitVector * MaxRadius_um;
-
-    Geometries::Vec3D ShiftedEnd0_um = RotatedEnd0_um - Offset_um;
-    Geometries::Vec3D ShiftedEnd1_um = RotatedEnd1_um + Offset_um;
-
-    int StartZ = _Array->GetZIndexAtPosition(ShiftedEnd0_um.z);
-    int EndZ = _Array->GetZIndexAtPosition(ShiftedEnd1_um.z);
-
-    if (StartZ == EndZ) return true; // To avoid divide by 0 below.
-
-    if (StartZ < EndZ) {
-
-        int ZDiff = EndZ - StartZ;
-
-        // Now enumerate the entire cylinder one z layer at a time, and test voxels in a square (of size r) at that layer
-        // Notice that this loop does not count from 0 but from StartZ! Beware of this when mapping back to world coordinates!
-        for (int CurrentZIndex = StartZ + _ThisThread; CurrentZIndex < EndZ; CurrentZIndex += _TotalThreads) {
-
-            int ZOffset = CurrentZIndex - StartZ;
-            float ZRatio = float(ZOffset)/float(ZDiff); // Because we can't divide by 0, we can't do this if StartZ == EndZ.
-            float CurrentRadius_um = (1.0 - ZRatio)*_Shape->End0Radius_um + ZRatio*_Shape->End1Radius_um;
-
-            Geometries::Vec3D CylinderMidpointAtCurrentLayer_um = ShiftedEnd0_um + (ScaledUnitVector_um * ZOffset);
-
-            // Now create a square at the midpoint here, and then test all points in that square
-            int XTestSpaceMin = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x - MaxRadius_um);
-            int XTestSpaceMax = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x + MaxRadius_um);
-            int YTestSpaceMin = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y - MaxRadius_um);
-            int YTestSpaceMax = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y + MaxRadius_um);
-
-            for (int CurrentYIndex = YTestSpaceMin; CurrentYIndex <= YTestSpaceMax; CurrentYIndex++) {
-                for (int CurrentXIndex = XTestSpaceMin; CurrentXIndex <= XTestSpaceMax; CurrentXIndex++) {
-
-                    Geometries::Vec3D CurrentWorldSpacePosition_um = _Array->GetPositionAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex);
-
-                    int res = isPointInCylinder(RotatedEnd0_um, RotatedEnd1_um, _Shape->End0Radius_um, _Shape->End1Radius_um, CurrentWorldSpacePosition_um);
-                    if (res==0) {
-
-                        VoxelType FinalVoxelValue = GenerateVoxelColor(CurrentWorldSpacePosition_um.x, CurrentWorldSpacePosition_um.y, CurrentWorldSpacePosition_um.z, _Params, _Generator);
-                        if (_Params->RenderBorders) {
-                            float DistanceToCenter_um = CurrentWorldSpacePosition_um.Distance(CylinderMidpointAtCurrentLayer_um);
-                            FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, CurrentRadius_um - DistanceToCenter_um, _Params);
-                        }
-
-                        _Array->SetVoxelAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex, FinalVoxelValue);
-
-                    }
-
-                }
-            }
-
+    // The axis, length and radius slope are worked out once here, then the cylinder (or truncated cone) is drawn
+    // one (Y,Z) row of voxels at a time. For each row, the frame solves for the X span inside the shape directly,
+    // and for the span inside the shape shrunk by the border thickness, which is plain interior.
+    // Only the voxels between the two get border shading, which is the distance from the surface along the radius.
+    Geometries::CylinderFrame Frame(*_Shape, _WorldInfo);
+    if (Frame.Length_um <= 0.) {
+        return true;
+    }
+    double Scale_um = _WorldInfo.VoxelScale_um;
+    Geometries::Vec3D Origin_um = _Array->GetPositionAtIndex(0, 0, 0);
+
+    // The shrunk shape is only solved for if it is still a frustum, otherwise every voxel is shaded
+    double BorderThickness_um = _Params->BorderThickness_um;
+    bool HasInnerSpan = !_Params->RenderBorders || std::min(_Shape->End0Radius_um, _Shape->End1Radius_um) - BorderThickness_um >= 0.;
+    double Inset_um = _Params->RenderBorders ? BorderThickness_um : 0.;
+
+    // Without noise, every interior voxel gets the same value
+    bool UniformInterior = !_Params->GeneratePerlinNoise_;
+    VoxelType InteriorValue = GenerateVoxelColor(Frame.End0_um[0], Frame.End0_um[1], Frame.End0_um[2], _Params, _Generator);
+
+    double StartZ_um, EndZ_um;
+    Frame.GetZRange(&StartZ_um, &EndZ_um);
+    int StartZ = std::max(0, int(ceil((StartZ_um - Origin_um.z) / Scale_um)));
+    int EndZ = std::min(_Array->GetZ() - 1, int(floor((EndZ_um - Origin_um.z) / Scale_um)));
+
+    // Rows are split between the parts by Z, so parts never write the same voxel
+    for (int Z = StartZ + _ThisThread; Z <= EndZ; Z += _TotalThreads) {
+        double Z_um = Origin_um.z + Z * Scale_um;
+        double StartY_um, EndY_um;
+        if (!Frame.GetLayerYRange(Z_um, &StartY_um, &EndY_um)) {
+            continue;
         }
+        int StartY = std::max(0, int(ceil((StartY_um - Origin_um.y) / Scale_um)));
+        int EndY = std::min(_Array->GetY() - 1, int(floor((EndY_um - Origin_um.y) / Scale_um)));
+
+        for (int Y = StartY; Y <= EndY; Y++) {
+            double Y_um = Origin_um.y + Y * Scale_um;
+            double SpanStart_um, SpanEnd_um;
+            if (!Frame.SolveRowSpan(Y_um, Z_um, 0., &SpanStart_um, &SpanEnd_um)) {
+                continue;
+            }
 
-    } else {
-
-        int ZDiff = StartZ - EndZ;
-
-        // Now enumerate the entire cylinder one z layer at a time, and test voxels in a square (of size r) at that layer
-        // Notice that this loop does not count from 0 but from StartZ! Beware of this when mapping back to world coordinates!
-        for (int CurrentZIndex = EndZ + _ThisThread; CurrentZIndex < StartZ; CurrentZIndex += _TotalThreads) {
-
-            int ZOffset = CurrentZIndex - EndZ;
-            float ZRatio = float(ZOffset)/float(ZDiff); // Because we can't divide by 0, we can't do this if StartZ == EndZ.
-            float CurrentRadius_um = (1.0 - ZRatio)*_Shape->End1Radius_um + ZRatio*_Shape->End0Radius_um;
-
-            Geometries::Vec3D CylinderMidpointAtCurrentLayer_um = ShiftedEnd1_um - (ScaledUnitVector_um * ZOffset); // ScaledUnitVector_um always points from end0 to end1.
-
-            // Now create a square at the midpoint here, and then test all points in that square
-            int XTestSpaceMin = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x - MaxRadius_um);
-            int XTestSpaceMax = _Array->GetXIndexAtPosition(CylinderMidpointAtCurrentLayer_um.x + MaxRadius_um);
-            int YTestSpaceMin = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y - MaxRadius_um);
-            int YTestSpaceMax = _Array->GetYIndexAtPosition(CylinderMidpointAtCurrentLayer_um.y + MaxRadius_um);
-
-            for (int CurrentYIndex = YTestSpaceMin; CurrentYIndex <= YTestSpaceMax; CurrentYIndex++) {
-                for (int CurrentXIndex = XTestSpaceMin; CurrentXIndex <= XTestSpaceMax; CurrentXIndex++) {
-
-                    Geometries::Vec3D CurrentWorldSpacePosition_um = _Array->GetPositionAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex);
-
-                    int res = isPointInCylinder(RotatedEnd0_um, RotatedEnd1_um, _Shape->End0Radius_um, _Shape->End1Radius_um, CurrentWorldSpacePosition_um);
-                    if (res==0) {
-
-                        VoxelType FinalVoxelValue = GenerateVoxelColor(CurrentWorldSpacePosition_um.x, CurrentWorldSpacePosition_um.y, CurrentWorldSpacePosition_um.z, _Params, _Generator);
-                        if (_Params->RenderBorders) {
-                            float DistanceToCenter_um = CurrentWorldSpacePosition_um.Distance(CylinderMidpointAtCurrentLayer_um);
-                            FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, CurrentRadius_um - DistanceToCenter_um, _Params);
-                        }
-
-                        _Array->SetVoxelAtIndex(CurrentXIndex, CurrentYIndex, CurrentZIndex, FinalVoxelValue);
-
-                    }
-
-                }
+            // Voxel X indices whose centers are inside the shape, and those inside the shrunk shape
+            int SpanStartX = std::max(0, int(ceil((SpanStart_um - Origin_um.x) / Scale_um)));
+            int SpanEndX = std::min(_Array->GetX() - 1, int(floor((SpanEnd_um - Origin_um.x) / Scale_um)));
+            if (SpanStartX > SpanEndX) {
+                continue;
+            }
+            int InnerStartX = SpanEndX + 1;
+            int InnerEndX = SpanEndX;
+            double InnerStart_um, InnerEnd_um;
+            if (HasInnerSpan && Frame.SolveRowSpan(Y_um, Z_um, Inset_um, &InnerStart_um, &InnerEnd_um)) {
+                InnerStartX = std::max(SpanStartX, int(ceil((InnerStart_um - Origin_um.x) / Scale_um)));
+                InnerEndX = std::min(SpanEndX, int(floor((InnerEnd_um - Origin_um.x) / Scale_um)));
             }
 
+            _Array->ForEachVoxelInSliceForWrite(SpanStartX, SpanEndX + 1, Y, Y + 1, Z, [&](int _X, int _Y, VoxelType& _Voxel) {
+                VoxelType FinalVoxelValue = InteriorValue;
+                double X_um = Origin_um.x + _X * Scale_um;
+                if (!UniformInterior) {
+                    FinalVoxelValue = GenerateVoxelColor(X_um, Y_um, Z_um, _Params, _Generator);
+                }
+                if (_Params->RenderBorders && (_X < InnerStartX || _X > InnerEndX)) {
+                    double T_um, AxisDistance2_um2;
+                    Frame.Project(X_um, Y_um, Z_um, &T_um, &AxisDistance2_um2);
+                    FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, Frame.RadiusAt_um(T_um) - sqrt(AxisDistance2_um2), _Params);
+                }
+                _Voxel = FinalVoxelValue;
+            });
         }
-
     }
 
     return true;
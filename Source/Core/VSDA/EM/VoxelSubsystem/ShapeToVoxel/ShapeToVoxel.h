@@ -65,7 +65,9 @@ namespace VoxelArrayGenerator {
 bool FillBox(VoxelArray* _Array, Geometries::Box* _Box, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 
 /**
- * @brief Rasterize the given cylinder struct, and writes it into the given voxelarray at the given scale.
+ * @brief Rasterizes the given cylinder (or truncated cone) into the voxelarray, one row of voxels at a time.
+ * The shape's frame is computed once, and the span of each row is solved from it, so no voxel outside the shape is tested.
+ * FillCylinderPart only draws the rows of every _TotalThreads'th Z layer, starting at _ThisThread.
  * 
  * @param _Array 
  * @param _Cylinder 
@@ -77,8 +79,9 @@ bool FillCylinder(VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA::Wor
 bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 
 /**
- * @brief Uses a generic ispointinshape function to write an object into the voxelarray.
- * Some objects don't support this (such as boxes and cylinders).
+ * @brief Rasterizes the given sphere into the voxelarray, one row of voxels at a time.
+ * The span of each row is solved from the sphere equation, so no voxel outside the sphere is tested.
+ * FillSpherePart only draws the rows of every _TotalThreads'th Z layer, starting at _ThisThread.
  * 
  * @param _Array 
  * @param _Shape 
@@ -0,0 +1,159 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the shape rasterizers.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <VSDA/EM/VoxelSubsystem/ShapeToVoxel/ShapeToVoxel.h>
+
+
+/**
+ * @brief Test class for the rasterizers, with an empty 40x40x32 voxel array at 1um per voxel.
+ *
+ */
+struct ShapeToVoxelTest: testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+    std::unique_ptr<BG::NES::Simulator::VoxelArray> array = nullptr;
+    BG::NES::VSDA::WorldInfo info;
+    BG::NES::Simulator::MicroscopeParameters params;
+    noise::module::Perlin generator;
+
+    void SetUp() {
+        BG::NES::Simulator::ScanRegion region;
+        region.Point1X_um = 0.0f; region.Point1Y_um = 0.0f; region.Point1Z_um = 0.0f;
+        region.Point2X_um = 40.0f; region.Point2Y_um = 40.0f; region.Point2Z_um = 32.0f;
+        array = std::make_unique<BG::NES::Simulator::VoxelArray>(&Logger, region, 1.0f);
+
+        info.WorldRotationOffsetX_rad = 0.0f;
+        info.WorldRotationOffsetY_rad = 0.0f;
+        info.WorldRotationOffsetZ_rad = 0.0f;
+        info.VoxelScale_um = 1.0f;
+
+        params.GeneratePerlinNoise_ = false;
+        params.DefaultIntensity_ = 100;
+        params.RenderBorders = true;
+        params.BorderThickness_um = 1.5f;
+        params.BorderEdgeIntensity = 20;
+    }
+};
+
+TEST_F( ShapeToVoxelTest, test_FillSphere_matches_point_test ) {
+    BG::NES::Simulator::Geometries::Sphere sphere(BG::NES::Simulator::Geometries::Vec3D(20.3f, 18.7f, 15.2f), 9.5f);
+    ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillSphere(array.get(), &sphere, info, &params, &generator));
+
+    int filled = 0;
+    for (int z = 0; z < 32; z++) {
+        for (int y = 0; y < 40; y++) {
+            for (int x = 0; x < 40; x++) {
+                float distance = sphere.Center_um.Distance(BG::NES::Simulator::Geometries::Vec3D(x, y, z));
+                if (std::fabs(distance - sphere.Radius_um) < 1e-3f || std::fabs(distance - (sphere.Radius_um - params.BorderThickness_um)) < 1e-3f) {
+                    continue; // too close to call
+                }
+                BG::NES::Simulator::VoxelType voxel = array->GetVoxel(x, y, z);
+                if (distance > sphere.Radius_um) {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_EMPTY);
+                } else if (distance > sphere.Radius_um - params.BorderThickness_um) {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_BORDER);
+                    ASSERT_LT(voxel.Intensity_, 100);
+                    filled++;
+                } else {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_INTERIOR);
+                    ASSERT_EQ(voxel.Intensity_, 100);
+                    filled++;
+                }
+            }
+        }
+    }
+    float volume = sphere.Volume_um3();
+    ASSERT_NEAR(filled, volume, 0.05f * volume);
+}
+
+TEST_F( ShapeToVoxelTest, test_FillSpherePart_parts_add_up ) {
+    // A sphere that sticks out of the array is clipped to it
+    BG::NES::Simulator::Geometries::Sphere sphere(BG::NES::Simulator::Geometries::Vec3D(35.0f, 4.0f, 28.0f), 7.25f);
+    ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillSphere(array.get(), &sphere, info, &params, &generator));
+
+    BG::NES::Simulator::ScanRegion region;
+    region.Point1X_um = 0.0f; region.Point1Y_um = 0.0f; region.Point1Z_um = 0.0f;
+    region.Point2X_um = 40.0f; region.Point2Y_um = 40.0f; region.Point2Z_um = 32.0f;
+    BG::NES::Simulator::VoxelArray parts(&Logger, region, 1.0f);
+    for (int part = 0; part < 3; part++) {
+        ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillSpherePart(3, part, &parts, &sphere, info, &params, &generator));
+    }
+
+    for (int z = 0; z < 32; z++) {
+        for (int y = 0; y < 40; y++) {
+            for (int x = 0; x < 40; x++) {
+                ASSERT_EQ(array->GetVoxel(x, y, z), parts.GetVoxel(x, y, z));
+            }
+        }
+    }
+    ASSERT_EQ(array->GetVoxel(35, 4, 28).State_, BG::NES::Simulator::VoxelState_INTERIOR);
+}
+
+TEST_F( ShapeToVoxelTest, test_FillCylinder_matches_point_test ) {
+    // A slanted truncated cone
+    BG::NES::Simulator::Geometries::Cylinder cylinder(6.5f, BG::NES::Simulator::Geometries::Vec3D(8.3f, 9.1f, 6.4f), 3.25f, BG::NES::Simulator::Geometries::Vec3D(31.2f, 27.6f, 24.9f));
+    ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillCylinder(array.get(), &cylinder, info, &params, &generator));
+
+    BG::NES::Simulator::Geometries::CylinderFrame frame(cylinder, info);
+    int filled = 0;
+    for (int z = 0; z < 32; z++) {
+        for (int y = 0; y < 40; y++) {
+            for (int x = 0; x < 40; x++) {
+                double t, distance2;
+                frame.Project(x, y, z, &t, &distance2);
+                double edge = frame.RadiusAt_um(t) - std::sqrt(distance2);
+                if (std::fabs(edge) < 1e-3 || std::fabs(edge - params.BorderThickness_um) < 1e-3 || std::fabs(t) < 1e-3 || std::fabs(t - frame.Length_um) < 1e-3) {
+                    continue; // too close to call
+                }
+                BG::NES::Simulator::VoxelType voxel = array->GetVoxel(x, y, z);
+                if (!cylinder.IsPointInShape(BG::NES::Simulator::Geometries::Vec3D(x, y, z), info)) {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_EMPTY);
+                } else if (edge < params.BorderThickness_um) {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_BORDER);
+                    filled++;
+                } else {
+                    ASSERT_EQ(voxel.State_, BG::NES::Simulator::VoxelState_INTERIOR);
+                    ASSERT_EQ(voxel.Intensity_, 100);
+                    filled++;
+                }
+            }
+        }
+    }
+    float volume = cylinder.Volume_um3();
+    ASSERT_NEAR(filled, volume, 0.05f * volume);
+}
+
+TEST_F( ShapeToVoxelTest, test_FillCylinderPart_parts_add_up ) {
+    // A thin cylinder along X that sticks out of the array
+    BG::NES::Simulator::Geometries::Cylinder cylinder(1.75f, BG::NES::Simulator::Geometries::Vec3D(-5.0f, 20.2f, 10.6f), 1.75f, BG::NES::Simulator::Geometries::Vec3D(30.0f, 20.2f, 10.6f));
+    ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillCylinder(array.get(), &cylinder, info, &params, &generator));
+
+    BG::NES::Simulator::ScanRegion region;
+    region.Point1X_um = 0.0f; region.Point1Y_um = 0.0f; region.Point1Z_um = 0.0f;
+    region.Point2X_um = 40.0f; region.Point2Y_um = 40.0f; region.Point2Z_um = 32.0f;
+    BG::NES::Simulator::VoxelArray parts(&Logger, region, 1.0f);
+    for (int part = 0; part < 3; part++) {
+        ASSERT_TRUE(BG::NES::Simulator::VoxelArrayGenerator::FillCylinderPart(3, part, &parts, &cylinder, info, &params, &generator));
+    }
+
+    for (int z = 0; z < 32; z++) {
+        for (int y = 0; y < 40; y++) {
+            for (int x = 0; x < 40; x++) {
+                ASSERT_EQ(array->GetVoxel(x, y, z), parts.GetVoxel(x, y, z));
+            }
+        }
+    }
+    ASSERT_EQ(array->GetVoxel(0, 20, 11).State_, BG::NES::Simulator::VoxelState_BORDER);
+    ASSERT_EQ(array->GetVoxel(29, 20, 11).State_, BG::NES::Simulator::VoxelState_BORDER);
+    ASSERT_EQ(array->GetVoxel(31, 20, 11).State_, BG::NES::Simulator::VoxelState_EMPTY);
+}
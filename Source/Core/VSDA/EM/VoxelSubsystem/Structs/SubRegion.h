@@ -34,6 +34,7 @@
 // Standard Libraries (BG convention: use <> instead of "")
 // #include <string>
 // #include <memory>
+#include <inttypes.h>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 
@@ -41,6 +42,7 @@
 // Internal Libraries (BG convention: use <> instead of "")
 // #include <VSDA/VoxelSubsystem/Structs/VoxelArray.h>
 #include <VSDA/Common/Structs/ScanRegion.h>
+#include <VSDA/Common/Structs/ShapeCullingIndex.h>
 
 #include <Simulator/Structs/Simulation.h>
 
@@ -69,11 +71,13 @@ struct SubRegion {
     int MaxImagesX;          /**Set a limit on the number of images in the x direction, useful for fixing subregion rounding errors*/
     int MaxImagesY;          /**Set a limit on the number of images in the y direction, useful for fixing subregion rounding errors*/
     size_t LayerOffset;      /**Layer offset from bottom of the image stack in microns*/
+    uint64_t MaxArrayMemory_bytes = UINT64_MAX; /**Memory budget for the allocated bricks of the voxel array, the subregion fails if it is exceeded*/
 
 
     // Working Data Params
     ScanRegion Region;                       /**Region that we're going to perform the rendering on*/
     Simulation* Sim;                         /**Simulation that we're rendering*/
+    const ShapeCullingIndex* CullingIndex = nullptr; /**Index of the shapes of Sim, shared by all subregions of the render*/
     // std::unique_ptr<VoxelArray> RegionArray; /**Array for this region, which we deallocate when we're done with*/
     
 
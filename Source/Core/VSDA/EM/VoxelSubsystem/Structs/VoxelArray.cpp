@@ -2,6 +2,7 @@
 #include <cstring>
 #include <future>
 #include <cstdlib>
+#include <thread>
 #include <vector>
 
 #include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
@@ -31,15 +32,13 @@ VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _
     VoxelScale_um = _VoxelScale_um;
 
 
-    // Malloc array
-    DataMaxLength_ = (uint64_t)SizeX_ * (uint64_t)SizeY_ * (uint64_t)SizeZ_;
+    // Create the brick table, the bricks themselves only get memory once they are written to
+    DataMaxLength_ = GetStorageLength(SizeX_, SizeY_, SizeZ_);
+    UpdateBrickCounts();
+    Bricks_ = std::make_unique<Brick[]>(DataMaxLength_ >> _VOXEL_BRICK_SHIFT);
     float SizeMiB = (sizeof(VoxelType) * DataMaxLength_) / 1024. / 1024.;
-    _Logger->Log("Allocating Array Of Size " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
-    Data_ = std::make_unique<VoxelType[]>(DataMaxLength_);
-
-    // We don't need to clear this because make unique does it for us
-    // Reset the array so we don't get a bunch of crap in it
-    // ClearArray();
+    _Logger->Log("Creating Sparse Array Of Up To " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
+    ClearArray();
 }
 VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _Region, float _VoxelScale_um) {
     Logger_ = _Logger;
@@ -68,69 +67,113 @@ VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _R
     VoxelScale_um = _VoxelScale_um;
 
 
-    // Malloc array
-    DataMaxLength_ = (uint64_t)SizeX_ * (uint64_t)SizeY_ * (uint64_t)SizeZ_;
+    // Create the brick table, the bricks themselves only get memory once they are written to
+    DataMaxLength_ = GetStorageLength(SizeX_, SizeY_, SizeZ_);
+    UpdateBrickCounts();
+    Bricks_ = std::make_unique<Brick[]>(DataMaxLength_ >> _VOXEL_BRICK_SHIFT);
     float SizeMiB = (sizeof(VoxelType) * DataMaxLength_) / 1024. / 1024.;
-    _Logger->Log("Allocating Array Of Size " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
-    VoxelType* VoxelArrayPtr = (VoxelType*)std::malloc(DataMaxLength_ * sizeof(VoxelType));
-    Data_ = std::unique_ptr<VoxelType[]>(VoxelArrayPtr);
-
-    ClearArrayThreaded(std::thread::hardware_concurrency());
-    // make unique already clears memory, so we're doing it twice.
-    // Reset the array so we don't get a bunch of crap in it
-    // ClearArray();
+    _Logger->Log("Creating Sparse Array Of Up To " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
+    ClearArrayThreaded();
 }
 
 
 VoxelArray::~VoxelArray() {
+    ResetBricks(VoxelType());
+}
 
-    // delete[] Data_;
+void VoxelArray::UpdateBrickCounts() {
+    BricksX_ = (SizeX_ + (1 << _VOXEL_BRICK_SHIFT_X) - 1) >> _VOXEL_BRICK_SHIFT_X;
+    BricksY_ = (SizeY_ + (1 << _VOXEL_BRICK_SHIFT_Y) - 1) >> _VOXEL_BRICK_SHIFT_Y;
 }
 
-void VoxelArray::ClearArray() {
+VoxelType* VoxelArray::AllocateBrick(Brick& _Brick) {
+
+    // Reserve the brick in the budget first, this runs on rasterizer threads so running out must not throw
+    if (NumAllocatedBricks_.fetch_add(1, std::memory_order_relaxed) >= MaxAllocatedBricks_) {
+        NumAllocatedBricks_.fetch_sub(1, std::memory_order_relaxed);
+        OutOfMemory_.store(true, std::memory_order_relaxed);
+        return nullptr;
+    }
+    VoxelType* NewData = new (std::nothrow) VoxelType[uint64_t(1) << _VOXEL_BRICK_SHIFT];
+    if (NewData == nullptr) {
+        NumAllocatedBricks_.fetch_sub(1, std::memory_order_relaxed);
+        OutOfMemory_.store(true, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Fill it with the uniform value, then publish it unless another thread was faster
+    std::fill(NewData, NewData + (uint64_t(1) << _VOXEL_BRICK_SHIFT), _Brick.Uniform_);
+    VoxelType* Expected = nullptr;
+    if (_Brick.Data_.compare_exchange_strong(Expected, NewData, std::memory_order_acq_rel)) {
+        return NewData;
+    }
+    delete[] NewData;
+    NumAllocatedBricks_.fetch_sub(1, std::memory_order_relaxed);
+    return Expected;
+
+}
+
+void VoxelArray::ResetBricks(VoxelType _Value) {
+    uint64_t NumBricks = DataMaxLength_ >> _VOXEL_BRICK_SHIFT;
+    for (uint64_t i = 0; i < NumBricks; i++) {
+        delete[] Bricks_[i].Data_.exchange(nullptr);
+        Bricks_[i].Uniform_ = _Value;
+    }
+    NumAllocatedBricks_ = 0;
+    OutOfMemory_ = false;
+}
+
+uint64_t VoxelArray::CompactBricks() {
+
+    uint64_t NumBricks = DataMaxLength_ >> _VOXEL_BRICK_SHIFT;
+    uint64_t NumFreed = 0;
+    for (uint64_t i = 0; i < NumBricks; i++) {
+        VoxelType* Data = Bricks_[i].Data_.load();
+        if (Data == nullptr) {
+            continue;
+        }
+        if (std::all_of(Data + 1, Data + (uint64_t(1) << _VOXEL_BRICK_SHIFT), [Data](const VoxelType& _Voxel) { return _Voxel == Data[0]; })) {
+            Bricks_[i].Uniform_ = Data[0];
+            Bricks_[i].Data_.store(nullptr);
+            delete[] Data;
+            NumFreed++;
+        }
+    }
+    NumAllocatedBricks_ -= NumFreed;
+    return NumFreed;
+
+}
 
-    std::memset(Data_.get(), 0, DataMaxLength_*sizeof(VoxelType));
+void VoxelArray::GetBrickUsage(uint64_t* _Allocated, uint64_t* _Total) {
+    uint64_t NumBricks = DataMaxLength_ >> _VOXEL_BRICK_SHIFT;
+    (*_Allocated) = 0;
+    for (uint64_t i = 0; i < NumBricks; i++) {
+        (*_Allocated) += (Bricks_[i].Data_.load() != nullptr);
+    }
+    (*_Total) = NumBricks;
+}
 
-    // // Reset everything to 0s
-    // for (uint64_t i = 0; i < DataMaxLength_; i++) {
-    //     Data_.get()[i] = 0;
-    // }
+void VoxelArray::SetBrickBudget(uint64_t _MaxBytes) {
+    MaxAllocatedBricks_ = _MaxBytes / (sizeof(VoxelType) << _VOXEL_BRICK_SHIFT);
+}
 
+bool VoxelArray::HasRunOutOfMemory() {
+    return OutOfMemory_.load();
 }
 
+void VoxelArray::ClearArray() {
+    ResetBricks(VoxelType{0, VoxelState_EMPTY});
+}
 
-void VoxelArray::ClearArrayThreaded(int _NumThreads) {
 
-    uint64_t ElementStepSize = DataMaxLength_ / _NumThreads;
-    // VoxelType* StartAddress = Data_.get();
+void VoxelArray::ClearArrayThreaded() {
 
     // Initializer
     VoxelType Empty;
     Empty.Intensity_ = 240;
     Empty.State_ = VoxelState_EMPTY;
-    // Empty.State_ = EMPTY;
-
-    // Create a bunch of memset tasks
-    std::vector<std::future<int>> AsyncTasks;
-    for (size_t i = 0; i < _NumThreads; i++) {
-        // VoxelType* ThreadStartAddress = StartAddress + (ElementStepSize * i);
-        uint64_t ThreadStartIndex = (ElementStepSize * i);
-        uint64_t ThreadEndIndex = (ElementStepSize * i) + ElementStepSize;
-        VoxelType* Array = Data_.get();
-
-        AsyncTasks.push_back(std::async(std::launch::async, [Array, ThreadStartIndex, ThreadEndIndex, Empty]{
-            for (uint64_t i = ThreadStartIndex; i < ThreadEndIndex; i++) {
-                Array[i] = Empty;
-            }
-            return 0;
-        }));
-    }
-
-    // Now, wait for this to finish
-    for (size_t i = 0; i < AsyncTasks.size(); i++) {
-        AsyncTasks[i].get();
-    }
 
+    ResetBricks(Empty);
 
 }
 
@@ -157,8 +200,18 @@ bool VoxelArray::SetBB(ScanRegion _NewBoundingBox) {
     return true;
 }
 
-uint64_t VoxelArray::GetIndex(int _X, int _Y, int _Z) {
-    return uint64_t(_X)*(SizeY_*SizeZ_) + uint64_t(_Y)*SizeZ_ + uint64_t(_Z);
+uint64_t VoxelArray::GetStorageLength(int _X, int _Y, int _Z) {
+    uint64_t BricksX = (uint64_t(_X) + (1 << _VOXEL_BRICK_SHIFT_X) - 1) >> _VOXEL_BRICK_SHIFT_X;
+    uint64_t BricksY = (uint64_t(_Y) + (1 << _VOXEL_BRICK_SHIFT_Y) - 1) >> _VOXEL_BRICK_SHIFT_Y;
+    uint64_t BricksZ = (uint64_t(_Z) + (1 << _VOXEL_BRICK_SHIFT_Z) - 1) >> _VOXEL_BRICK_SHIFT_Z;
+    return (BricksX * BricksY * BricksZ) << _VOXEL_BRICK_SHIFT;
+}
+
+uint64_t VoxelArray::GetStorageLength(ScanRegion _TargetSize, float _VoxelScale_um) {
+    int VoxelSizeX = _TargetSize.SizeX() / _VoxelScale_um;
+    int VoxelSizeY = _TargetSize.SizeY() / _VoxelScale_um;
+    int VoxelSizeZ = _TargetSize.SizeZ() / _VoxelScale_um;
+    return GetStorageLength(VoxelSizeX, VoxelSizeY, VoxelSizeZ);
 }
 
 VoxelType VoxelArray::GetVoxel(int _X, int _Y, int _Z) {
@@ -171,36 +224,38 @@ VoxelType VoxelArray::GetVoxel(int _X, int _Y, int _Z) {
         return Ret;
     }
 
-    // Hope this works (please work dear god don't segfault)
-    uint64_t Index = GetIndex(_X, _Y, _Z);
-    if (Index < DataMaxLength_) {
-        return Data_.get()[Index];
+    Brick& ThisBrick = Bricks_[GetBrickIndex(_X, _Y, _Z)];
+    const VoxelType* Data = ThisBrick.Data_.load(std::memory_order_acquire);
+    if (Data == nullptr) {
+        return ThisBrick.Uniform_;
     }
-    VoxelType Ret;
-    Ret.Intensity_ = 0;
-    // Ret.State_ = OUT_OF_RANGE;
-    return Ret;
+    return Data[GetIndexInBrick(_X, _Y, _Z)];
 
 }
 
 void VoxelArray::SetVoxel(int _X, int _Y, int _Z, VoxelType _Value) {
-    uint64_t CurrentIndex = GetIndex(_X, _Y, _Z);
-    if (CurrentIndex < 0 || CurrentIndex >= DataMaxLength_) {
+    if (!IsIndexInRange(_X, _Y, _Z)) {
         std::string ErrorMsg = std::string("E: Cannot Set Voxel At ") + std::to_string(_X);
         ErrorMsg += std::string(" ") + std::to_string(_Y) + std::string(" ") + std::to_string(_Z);
-        ErrorMsg += std::string(" As This Would Be Out Of Range (index): ") + std::to_string(CurrentIndex) + "!";
+        ErrorMsg += std::string(" As This Would Be Out Of Range!");
         throw std::out_of_range(ErrorMsg.c_str());
     }
-    Data_[CurrentIndex] = _Value;
+    VoxelType* Data = GetBrickForWrite(Bricks_[GetBrickIndex(_X, _Y, _Z)]);
+    if (Data != nullptr) {
+        Data[GetIndexInBrick(_X, _Y, _Z)] = _Value;
+    }
 }
 
 void VoxelArray::SetVoxelAtIndex(int _XIndex, int _YIndex, int _ZIndex, VoxelType _Value) {
     
-    uint64_t CurrentIndex = GetIndex(_XIndex, _YIndex, _ZIndex);
-    if (CurrentIndex < 0 || CurrentIndex >= DataMaxLength_) {
+    // Coords outside of the array would land in another brick, so they are checked rather than the index
+    if (!IsIndexInRange(_XIndex, _YIndex, _ZIndex)) {
         return;
     }
-    Data_[CurrentIndex] = _Value;
+    VoxelType* Data = GetBrickForWrite(Bricks_[GetBrickIndex(_XIndex, _YIndex, _ZIndex)]);
+    if (Data != nullptr) {
+        Data[GetIndexInBrick(_XIndex, _YIndex, _ZIndex)] = _Value;
+    }
 
 }
 
@@ -258,14 +313,8 @@ void VoxelArray::SetVoxelIfNotDarker(float _X, float _Y, float _Z, VoxelType _Va
     VoxelType ThisVoxel = GetVoxel(XIndex, YIndex, ZIndex);
 
     // Only set the color if it's not in the enum range, and it's darker than the current value (except if it's empty)
-    if (_Value.State_ == VoxelState_INTERIOR) {
-        if ((ThisVoxel.Intensity_ > _Value.Intensity_) || (ThisVoxel.State_ == VoxelState_BORDER)) {
-            SetVoxel(XIndex, YIndex, ZIndex, _Value);
-        }
-    } else if (_Value.State_ == VoxelState_BORDER) {
-        if ((ThisVoxel.State_ != VoxelState_INTERIOR) && (ThisVoxel.Intensity_ > _Value.Intensity_)) {
-            SetVoxel(XIndex, YIndex, ZIndex, _Value);
-        }
+    if (IsReplacedBy(ThisVoxel, _Value)) {
+        SetVoxel(XIndex, YIndex, ZIndex, _Value);
     }
 
 }
@@ -287,14 +336,8 @@ void VoxelArray::SetVoxelIfNotDarkerAtIndex(int _X, int _Y, int _Z, VoxelType _V
     VoxelType ThisVoxel = GetVoxel(XIndex, YIndex, ZIndex);
 
     // Only set the color if it's not in the enum range, and it's darker than the current value (except if it's empty)
-    if (_Value.State_ == VoxelState_INTERIOR) {
-        if ((ThisVoxel.Intensity_ > _Value.Intensity_) || (ThisVoxel.State_ == VoxelState_BORDER)) {
-            SetVoxel(XIndex, YIndex, ZIndex, _Value);
-        }
-    } else if (_Value.State_ == VoxelState_BORDER) {
-        if ((ThisVoxel.State_ != VoxelState_INTERIOR) && (ThisVoxel.Intensity_ > _Value.Intensity_)) {
-            SetVoxel(XIndex, YIndex, ZIndex, _Value);
-        }
+    if (IsReplacedBy(ThisVoxel, _Value)) {
+        SetVoxel(XIndex, YIndex, ZIndex, _Value);
     }
 
 }
@@ -307,9 +350,9 @@ void VoxelArray::GetSize(int* _X, int* _Y, int* _Z) {
 
 bool VoxelArray::SetSize(int _X, int _Y, int _Z) {
 
-    uint64_t ProposedSize = uint64_t(_X) * uint64_t(_Y) * uint64_t(_Z);
+    uint64_t ProposedSize = GetStorageLength(_X, _Y, _Z);
     
-    if (ProposedSize < DataMaxLength_) {
+    if (ProposedSize <= DataMaxLength_) {
 
         std::string ResizePercent = std::to_string((double(ProposedSize) / double(DataMaxLength_)) * 100.);
         Logger_->Log("Resizing Voxel Array To " + std::to_string(_X) + "XVox, " + std::to_string(_Y) + "YVox, " + std::to_string(_Z) + "ZVox, ~" + ResizePercent + "% of Allocated Size", 4);
@@ -317,6 +360,7 @@ bool VoxelArray::SetSize(int _X, int _Y, int _Z) {
         SizeX_ = _X;
         SizeY_ = _Y;
         SizeZ_ = _Z;
+        UpdateBrickCounts();
 
         return true;
     } else {
@@ -32,9 +32,12 @@
 
 
 // Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <atomic>
 #include <inttypes.h>
 #include <math.h>
 #include <memory>
+#include <new>
 
 
 // Third-Party Libraries (BG convention: use <> instead of "")
@@ -53,6 +56,16 @@ namespace NES {
 namespace Simulator {
 
 
+// Voxels are stored in bricks of 32x32x8 voxels, given here as powers of two.
+// Within a brick X is contiguous, then Y, then Z, and the bricks themselves are ordered the same way,
+// so the voxels of one XY slice of a brick are one contiguous run of memory.
+// Bricks whose voxels all have the same value are not allocated, see VoxelArray.
+#define _VOXEL_BRICK_SHIFT_X 5
+#define _VOXEL_BRICK_SHIFT_Y 5
+#define _VOXEL_BRICK_SHIFT_Z 3
+#define _VOXEL_BRICK_SHIFT (_VOXEL_BRICK_SHIFT_X + _VOXEL_BRICK_SHIFT_Y + _VOXEL_BRICK_SHIFT_Z)
+
+
 enum VoxelState {
     VoxelState_EMPTY=0,
     VoxelState_INTERIOR=1,
@@ -65,24 +78,45 @@ struct VoxelType {
     uint8_t Intensity_; /**Value from 0-255 representing the intensity (brightness) of this voxel*/
     VoxelState State_; /**Determine if this voxel is near the edge of a shape or not*/
 
+    bool operator==(const VoxelType& _Other) const {
+        return Intensity_ == _Other.Intensity_ && State_ == _Other.State_;
+    }
+
 };
 
 
 /**
  * @brief Defines the voxel array.
- * 
+ * The array is sparse: a brick only gets memory once a voxel in it is written, until then all its voxels
+ * have the brick's uniform value (the cleared value in most of an array, as tissue is mostly empty space).
+ * Bricks may be allocated by several rasterizer threads at once. Clearing and compacting must not
+ * overlap with anything else.
+ * The allocated bricks can be limited to a memory budget, see SetBrickBudget. Writes to bricks that can not
+ * be allocated (over the budget or out of memory) are dropped, and HasRunOutOfMemory reports it.
  */
 class VoxelArray {
 
 private:
 
-    std::unique_ptr<VoxelType[]> Data_; /**Big blob of memory that holds all the voxels*/
-    uint64_t DataMaxLength_ = 0;
+    struct Brick {
+        std::atomic<VoxelType*> Data_{nullptr}; /**Voxels of this brick, nullptr while all of them are Uniform_*/
+        VoxelType Uniform_; /**Value of every voxel of this brick while Data_ is nullptr*/
+    };
+
+    std::unique_ptr<Brick[]> Bricks_; /**Every brick of the array, in the brick order above*/
+    uint64_t DataMaxLength_ = 0; /**Number of voxels that Bricks_ covers*/
+
+    uint64_t MaxAllocatedBricks_ = UINT64_MAX; /**Number of bricks that may have memory at once, see SetBrickBudget*/
+    std::atomic<uint64_t> NumAllocatedBricks_{0}; /**Number of bricks that currently have memory*/
+    std::atomic<bool> OutOfMemory_{false}; /**Set when a brick could not be allocated since the last clear*/
 
     uint64_t SizeX_; /**Number of voxels in x dimension*/
     uint64_t SizeY_; /**Number of voxels in y dimension*/
     uint64_t SizeZ_; /**Number of voxels in z dimension*/
 
+    uint64_t BricksX_; /**Number of bricks in x dimension*/
+    uint64_t BricksY_; /**Number of bricks in y dimension*/
+
     float VoxelScale_um; /**Set the size of each voxel in micrometers*/
 
     BoundingBox BoundingBox_; /**Set the bounding box of this voxel array (relative to the simulation orign), used by subregions*/
@@ -91,14 +125,101 @@ private:
 
 
     /**
-     * @brief Returns the flat index for the voxel at the given coords.
+     * @brief Returns the index of the brick holding the voxel at the given coords.
+     * The coords must be inside the array, see the brick layout above.
      * 
      * @param _X 
      * @param _Y 
      * @param _Z 
      * @return uint64_t 
      */
-    uint64_t GetIndex(int _X, int _Y, int _Z);
+    inline uint64_t GetBrickIndex(int _X, int _Y, int _Z) {
+        return (uint64_t(_Z >> _VOXEL_BRICK_SHIFT_Z) * BricksY_ + uint64_t(_Y >> _VOXEL_BRICK_SHIFT_Y)) * BricksX_ + uint64_t(_X >> _VOXEL_BRICK_SHIFT_X);
+    }
+
+    /**
+     * @brief Returns the index of the voxel at the given coords within its brick.
+     * 
+     * @param _X 
+     * @param _Y 
+     * @param _Z 
+     * @return uint64_t 
+     */
+    inline uint64_t GetIndexInBrick(int _X, int _Y, int _Z) {
+        uint64_t InBrickZ = uint64_t(_Z) & ((1 << _VOXEL_BRICK_SHIFT_Z) - 1);
+        uint64_t InBrickY = uint64_t(_Y) & ((1 << _VOXEL_BRICK_SHIFT_Y) - 1);
+        uint64_t InBrickX = uint64_t(_X) & ((1 << _VOXEL_BRICK_SHIFT_X) - 1);
+        return (((InBrickZ << _VOXEL_BRICK_SHIFT_Y) | InBrickY) << _VOXEL_BRICK_SHIFT_X) | InBrickX;
+    }
+
+    /**
+     * @brief Returns the voxels of the given brick, allocating them (filled with its uniform value) if needed.
+     * Returns nullptr if the brick can not be allocated, the write must then be dropped.
+     * 
+     * @param _Brick 
+     * @return VoxelType* 
+     */
+    inline VoxelType* GetBrickForWrite(Brick& _Brick) {
+        VoxelType* Data = _Brick.Data_.load(std::memory_order_acquire);
+        return (Data != nullptr) ? Data : AllocateBrick(_Brick);
+    }
+    VoxelType* AllocateBrick(Brick& _Brick);
+
+    /**
+     * @brief Frees every brick and sets all voxels to _Value, this also clears the out of memory flag.
+     * 
+     * @param _Value 
+     */
+    void ResetBricks(VoxelType _Value);
+
+    /**
+     * @brief Sets up the brick table for the current size, which must be within DataMaxLength_.
+     */
+    void UpdateBrickCounts();
+
+    /**
+     * @brief Checks if the given voxel coords are inside the array.
+     */
+    inline bool IsIndexInRange(int _X, int _Y, int _Z) {
+        return (_X >= 0 && uint64_t(_X) < SizeX_) && (_Y >= 0 && uint64_t(_Y) < SizeY_) && (_Z >= 0 && uint64_t(_Z) < SizeZ_);
+    }
+
+    /**
+     * @brief Clips the given slice window to the array, returns false if nothing is left of it.
+     */
+    inline bool ClipSlice(int& _StartX, int& _EndX, int& _StartY, int& _EndY, int _Z) {
+        if (_Z < 0 || uint64_t(_Z) >= SizeZ_) {
+            return false;
+        }
+        _StartX = std::max(_StartX, 0);
+        _StartY = std::max(_StartY, 0);
+        _EndX = int(std::min(int64_t(_EndX), int64_t(SizeX_)));
+        _EndY = int(std::min(int64_t(_EndY), int64_t(SizeY_)));
+        return _StartX < _EndX && _StartY < _EndY;
+    }
+
+    /**
+     * @brief Calls _Function(Y, Brick, StartX, EndX) for every brick row of the clipped slice window,
+     * brick by brick in the order they are stored.
+     */
+    template <typename Function>
+    void ForEachBrickRowInSlice(int _StartX, int _EndX, int _StartY, int _EndY, int _Z, Function _Function) {
+        if (!ClipSlice(_StartX, _EndX, _StartY, _EndY, _Z)) {
+            return;
+        }
+        for (int BrickY = _StartY >> _VOXEL_BRICK_SHIFT_Y; BrickY <= ((_EndY - 1) >> _VOXEL_BRICK_SHIFT_Y); BrickY++) {
+            int BrickStartY = std::max(_StartY, BrickY << _VOXEL_BRICK_SHIFT_Y);
+            int BrickEndY = std::min(_EndY, (BrickY + 1) << _VOXEL_BRICK_SHIFT_Y);
+            for (int BrickX = _StartX >> _VOXEL_BRICK_SHIFT_X; BrickX <= ((_EndX - 1) >> _VOXEL_BRICK_SHIFT_X); BrickX++) {
+                int BrickStartX = std::max(_StartX, BrickX << _VOXEL_BRICK_SHIFT_X);
+                int BrickEndX = std::min(_EndX, (BrickX + 1) << _VOXEL_BRICK_SHIFT_X);
+                Brick& ThisBrick = Bricks_[GetBrickIndex(BrickStartX, BrickStartY, _Z)];
+                for (int Y = BrickStartY; Y < BrickEndY; Y++) {
+                    _Function(Y, ThisBrick, BrickStartX, BrickEndX);
+                }
+            }
+        }
+    }
 
 
 
@@ -174,6 +295,118 @@ public:
     void SetVoxelIfNotDarker(float _X, float _Y, float _Z, VoxelType _Value);
     void SetVoxelIfNotDarkerAtIndex(int _X, int _Y, int _Z, VoxelType _Value);
 
+    /**
+     * @brief The rule used by SetVoxelIfNotDarker: returns true if _Value should replace _Current.
+     * Interior voxels replace brighter voxels and borders, border voxels replace brighter non-interior voxels.
+     * 
+     * @param _Current 
+     * @param _Value 
+     * @return true 
+     * @return false 
+     */
+    static inline bool IsReplacedBy(const VoxelType& _Current, const VoxelType& _Value) {
+        if (_Value.State_ == VoxelState_INTERIOR) {
+            return (_Current.Intensity_ > _Value.Intensity_) || (_Current.State_ == VoxelState_BORDER);
+        } else if (_Value.State_ == VoxelState_BORDER) {
+            return (_Current.State_ != VoxelState_INTERIOR) && (_Current.Intensity_ > _Value.Intensity_);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Calls _Function(X, Y, Voxel) with every voxel of the slice at _Z
+     * from _StartX to _EndX and _StartY to _EndY (ends excluded). Coords outside the array are skipped.
+     * The voxels are visited brick by brick, in the order they are stored, rather than row by row.
+     * This is the fast way to read whole XY slices, it does not allocate any bricks.
+     * 
+     * @param _StartX 
+     * @param _EndX 
+     * @param _StartY 
+     * @param _EndY 
+     * @param _Z 
+     * @param _Function Callable taking (int X, int Y, const VoxelType& Voxel)
+     */
+    template <typename Function>
+    void ForEachVoxelInSlice(int _StartX, int _EndX, int _StartY, int _EndY, int _Z, Function _Function) {
+        ForEachBrickRowInSlice(_StartX, _EndX, _StartY, _EndY, _Z, [&](int _Y, Brick& _Brick, int _RowStartX, int _RowEndX) {
+            const VoxelType* Data = _Brick.Data_.load(std::memory_order_acquire);
+            if (Data == nullptr) {
+                for (int X = _RowStartX; X < _RowEndX; X++) {
+                    _Function(X, _Y, _Brick.Uniform_);
+                }
+                return;
+            }
+            const VoxelType* Row = Data + GetIndexInBrick(_RowStartX, _Y, _Z);
+            for (int X = _RowStartX; X < _RowEndX; X++) {
+                _Function(X, _Y, Row[X - _RowStartX]);
+            }
+        });
+    }
+
+    /**
+     * @brief Like ForEachVoxelInSlice, but passes a reference that may be written to.
+     * This allocates every brick that the clipped window touches, rows of bricks that can not be allocated are skipped.
+     * 
+     * @param _Function Callable taking (int X, int Y, VoxelType& Voxel)
+     */
+    template <typename Function>
+    void ForEachVoxelInSliceForWrite(int _StartX, int _EndX, int _StartY, int _EndY, int _Z, Function _Function) {
+        ForEachBrickRowInSlice(_StartX, _EndX, _StartY, _EndY, _Z, [&](int _Y, Brick& _Brick, int _RowStartX, int _RowEndX) {
+            VoxelType* Data = GetBrickForWrite(_Brick);
+            if (Data == nullptr) {
+                return;
+            }
+            VoxelType* Row = Data + GetIndexInBrick(_RowStartX, _Y, _Z);
+            for (int X = _RowStartX; X < _RowEndX; X++) {
+                _Function(X, _Y, Row[X - _RowStartX]);
+            }
+        });
+    }
+
+    /**
+     * @brief Collapses every allocated brick whose voxels all have the same value back into that value, freeing its memory.
+     * 
+     * @return uint64_t Number of bricks that were freed
+     */
+    uint64_t CompactBricks();
+
+    /**
+     * @brief Returns the number of bricks that currently have memory allocated, and the total number of bricks.
+     * 
+     * @param _Allocated 
+     * @param _Total 
+     */
+    void GetBrickUsage(uint64_t* _Allocated, uint64_t* _Total);
+
+    /**
+     * @brief Limits the memory that the allocated bricks may use, in bytes (the brick table itself is not counted).
+     * Bricks that are already allocated stay, even if they are over the new budget.
+     * 
+     * @param _MaxBytes 
+     */
+    void SetBrickBudget(uint64_t _MaxBytes);
+
+    /**
+     * @brief Returns true if a brick could not be allocated since the array was last cleared.
+     * Some writes were dropped then, so the contents of the array are incomplete.
+     * 
+     * @return true 
+     * @return false 
+     */
+    bool HasRunOutOfMemory();
+
+    /**
+     * @brief Returns the number of voxels in the bricks covering an array of the given size.
+     * This is more than _X * _Y * _Z, as the bricks on the far edges are always whole.
+     * 
+     * @param _X Dimension In Voxels
+     * @param _Y Dimension In Voxels
+     * @param _Z Dimension In Voxels
+     * @return uint64_t 
+     */
+    static uint64_t GetStorageLength(int _X, int _Y, int _Z);
+    static uint64_t GetStorageLength(ScanRegion _TargetSize, float _VoxelScale_um);
+
     /**
      * @brief Get the size of the array, populate the int ptrs
      * 
@@ -275,14 +508,16 @@ public:
 
 
     /**
-     * @brief Clears the given array to all 0s
+     * @brief Clears the given array to all 0s (ClearArray) or to empty space (ClearArrayThreaded).
+     * Both just free every brick, so ClearArrayThreaded no longer starts any threads.
      * 
      */
     void ClearArray();
-    void ClearArrayThreaded(int _NumThreads=10);
+    void ClearArrayThreaded();
 
     /**
-     * @brief Returns the size of the array.
+     * @brief Returns the number of voxels the brick table can cover, see GetStorageLength.
+     * Only the bricks that were written to take up memory, see GetBrickUsage.
      * 
      * @return uint64_t 
      */
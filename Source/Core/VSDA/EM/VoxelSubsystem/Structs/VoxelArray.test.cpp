@@ -0,0 +1,234 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+     Description: This file provides unit tests for the sparse bricked voxel array.
+     Additional Notes: None
+     Date Created: 2026-10-17
+*/
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+
+
+static BG::NES::Simulator::ScanRegion Region(float x, float y, float z) {
+    BG::NES::Simulator::ScanRegion region;
+    region.Point1X_um = 0.0f; region.Point1Y_um = 0.0f; region.Point1Z_um = 0.0f;
+    region.Point2X_um = x; region.Point2Y_um = y; region.Point2Z_um = z;
+    return region;
+}
+
+static uint8_t Pattern(int x, int y, int z) {
+    return uint8_t(x * 7 + y * 13 + z * 29);
+}
+
+TEST(VoxelArrayTest, test_SetVoxel_GetVoxel_roundtrip) {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Simulator::VoxelArray array(&Logger, Region(37.0f, 70.0f, 13.0f), 1.0f);
+    ASSERT_EQ(array.GetX(), 37);
+    ASSERT_EQ(array.GetY(), 70);
+    ASSERT_EQ(array.GetZ(), 13);
+    ASSERT_EQ(array.GetSize(), BG::NES::Simulator::VoxelArray::GetStorageLength(37, 70, 13));
+    ASSERT_GE(array.GetSize(), 37u * 70u * 13u);
+
+    for (int z = 0; z < 13; z++) {
+        for (int y = 0; y < 70; y++) {
+            for (int x = 0; x < 37; x++) {
+                BG::NES::Simulator::VoxelType voxel;
+                voxel.Intensity_ = Pattern(x, y, z);
+                voxel.State_ = BG::NES::Simulator::VoxelState_INTERIOR;
+                array.SetVoxel(x, y, z, voxel);
+            }
+        }
+    }
+    for (int z = 0; z < 13; z++) {
+        for (int y = 0; y < 70; y++) {
+            for (int x = 0; x < 37; x++) {
+                ASSERT_EQ(array.GetVoxel(x, y, z).Intensity_, Pattern(x, y, z));
+            }
+        }
+    }
+
+    // Out of range coords do not wrap into other bricks
+    BG::NES::Simulator::VoxelType dark;
+    dark.Intensity_ = 1;
+    dark.State_ = BG::NES::Simulator::VoxelState_INTERIOR;
+    array.SetVoxelAtIndex(37, 0, 0, dark);
+    array.SetVoxelAtIndex(-1, 5, 5, dark);
+    ASSERT_THROW(array.SetVoxel(0, 70, 0, dark), std::out_of_range);
+    ASSERT_EQ(array.GetVoxel(37, 0, 0).Intensity_, 0);
+    ASSERT_EQ(array.GetVoxel(5, 0, 0).Intensity_, Pattern(5, 0, 0));
+}
+
+TEST(VoxelArrayTest, test_ForEachVoxelInSlice_visits_window_once) {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Simulator::VoxelArray array(&Logger, Region(80.0f, 45.0f, 20.0f), 1.0f);
+
+    // Every voxel of the array has its own storage
+    std::set<BG::NES::Simulator::VoxelType*> addresses;
+    for (int z = 0; z < 20; z++) {
+        array.ForEachVoxelInSliceForWrite(0, 80, 0, 45, z, [&](int x, int y, BG::NES::Simulator::VoxelType& voxel) {
+            voxel.Intensity_ = Pattern(x, y, z);
+            addresses.insert(&voxel);
+        });
+    }
+    ASSERT_EQ(addresses.size(), 80u * 45u * 20u);
+
+    // A window that sticks out of the array is clipped to it
+    std::set<std::pair<int, int>> visited;
+    array.ForEachVoxelInSlice(-10, 50, 30, 100, 9, [&](int x, int y, const BG::NES::Simulator::VoxelType& voxel) {
+        ASSERT_EQ(voxel.Intensity_, array.GetVoxel(x, y, 9).Intensity_);
+        ASSERT_EQ(voxel.Intensity_, Pattern(x, y, 9));
+        ASSERT_TRUE(visited.insert({x, y}).second);
+    });
+    ASSERT_EQ(visited.size(), 50u * 15u);
+    ASSERT_EQ(visited.begin()->first, 0);
+    ASSERT_EQ(visited.rbegin()->second, 44);
+
+    int calls = 0;
+    array.ForEachVoxelInSlice(0, 80, 0, 45, 20, [&](int, int, const BG::NES::Simulator::VoxelType&) { calls++; });
+    array.ForEachVoxelInSlice(10, 10, 0, 45, 3, [&](int, int, const BG::NES::Simulator::VoxelType&) { calls++; });
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(VoxelArrayTest, test_SetSize_keeps_bricks_within_allocation) {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Simulator::VoxelArray array(&Logger, Region(64.0f, 64.0f, 16.0f), 1.0f);
+
+    // Fewer voxels that still need more bricks than allocated do not fit
+    ASSERT_FALSE(array.SetSize(65, 60, 16));
+    ASSERT_TRUE(array.SetSize(33, 64, 9));
+    ASSERT_EQ(array.GetX(), 33);
+
+    BG::NES::Simulator::VoxelType voxel;
+    voxel.Intensity_ = 42;
+    voxel.State_ = BG::NES::Simulator::VoxelState_BORDER;
+    array.SetVoxel(32, 63, 8, voxel);
+    ASSERT_EQ(array.GetVoxel(32, 63, 8).Intensity_, 42);
+}
+
+TEST(VoxelArrayTest, test_bricks_allocated_on_write_and_compacted) {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Simulator::VoxelArray array(&Logger, Region(100.0f, 100.0f, 40.0f), 1.0f);
+    uint64_t allocated, total;
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 0u);
+    ASSERT_EQ(total, 4u * 4u * 5u);
+
+    // Reading does not allocate, and gives the cleared value
+    int reads = 0;
+    array.ForEachVoxelInSlice(0, 100, 0, 100, 7, [&](int, int, const BG::NES::Simulator::VoxelType& voxel) {
+        ASSERT_EQ(voxel.Intensity_, 240);
+        reads++;
+    });
+    ASSERT_EQ(reads, 100 * 100);
+    ASSERT_EQ(array.GetVoxel(99, 99, 39).Intensity_, 240);
+
+    // Threads writing into the same bricks share them
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&array, t]() {
+            for (int x = t; x < 64; x += 4) {
+                BG::NES::Simulator::VoxelType voxel;
+                voxel.Intensity_ = uint8_t(x);
+                voxel.State_ = BG::NES::Simulator::VoxelState_INTERIOR;
+                array.SetVoxelAtIndex(x, 5, 3, voxel);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 2u);
+    for (int x = 0; x < 64; x++) {
+        ASSERT_EQ(array.GetVoxel(x, 5, 3).Intensity_, x);
+    }
+    ASSERT_EQ(array.GetVoxel(0, 6, 3).Intensity_, 240);
+
+    // A brick filled with one value collapses to it
+    BG::NES::Simulator::VoxelType inside;
+    inside.Intensity_ = 90;
+    inside.State_ = BG::NES::Simulator::VoxelState_INTERIOR;
+    for (int z = 8; z < 16; z++) {
+        array.ForEachVoxelInSliceForWrite(32, 64, 64, 96, z, [&](int, int, BG::NES::Simulator::VoxelType& voxel) {
+            voxel = inside;
+        });
+    }
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 3u);
+    ASSERT_EQ(array.CompactBricks(), 1u);
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 2u);
+    ASSERT_EQ(array.GetVoxel(40, 70, 10).Intensity_, 90);
+    ASSERT_EQ(array.GetVoxel(40, 70, 10).State_, BG::NES::Simulator::VoxelState_INTERIOR);
+
+    // Writing to a collapsed brick brings back its value
+    BG::NES::Simulator::VoxelType border;
+    border.Intensity_ = 10;
+    border.State_ = BG::NES::Simulator::VoxelState_BORDER;
+    array.SetVoxel(40, 70, 10, border);
+    ASSERT_EQ(array.GetVoxel(40, 70, 10).Intensity_, 10);
+    ASSERT_EQ(array.GetVoxel(41, 70, 10).Intensity_, 90);
+
+    array.ClearArrayThreaded();
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 0u);
+    ASSERT_EQ(array.GetVoxel(41, 70, 10).Intensity_, 240);
+}
+
+TEST(VoxelArrayTest, test_brick_budget_drops_writes_instead_of_throwing) {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Simulator::VoxelArray array(&Logger, Region(128.0f, 128.0f, 16.0f), 1.0f);
+    uint64_t brickBytes = sizeof(BG::NES::Simulator::VoxelType) << _VOXEL_BRICK_SHIFT;
+    array.SetBrickBudget(3 * brickBytes);
+
+    BG::NES::Simulator::VoxelType inside;
+    inside.Intensity_ = 90;
+    inside.State_ = BG::NES::Simulator::VoxelState_INTERIOR;
+
+    // Rasterizer threads write into every brick at once, only three of them get memory
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&array, inside, t]() {
+            for (int z = t * 4; z < (t + 1) * 4; z++) {
+                array.ForEachVoxelInSliceForWrite(0, 128, 0, 128, z, [&](int, int, BG::NES::Simulator::VoxelType& voxel) {
+                    voxel = inside;
+                });
+                array.SetVoxel(127, 127, z, inside);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    uint64_t allocated, total;
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 3u);
+    ASSERT_TRUE(array.HasRunOutOfMemory());
+
+    // Clearing resets the flag, and bricks freed by compacting make room in the budget again
+    array.ClearArrayThreaded();
+    ASSERT_FALSE(array.HasRunOutOfMemory());
+    for (int z = 0; z < 8; z++) {
+        array.ForEachVoxelInSliceForWrite(0, 96, 0, 32, z, [&](int, int, BG::NES::Simulator::VoxelType& voxel) {
+            voxel = inside;
+        });
+    }
+    ASSERT_FALSE(array.HasRunOutOfMemory());
+    array.SetVoxel(0, 0, 8, inside);
+    ASSERT_TRUE(array.HasRunOutOfMemory());
+    ASSERT_EQ(array.GetVoxel(0, 0, 8).Intensity_, 240);
+    ASSERT_EQ(array.GetVoxel(95, 31, 7).Intensity_, 90);
+    ASSERT_EQ(array.CompactBricks(), 3u);
+    array.SetVoxel(0, 0, 8, inside);
+    ASSERT_EQ(array.GetVoxel(0, 0, 8).Intensity_, 90);
+    array.GetBrickUsage(&allocated, &total);
+    ASSERT_EQ(allocated, 1u);
+}
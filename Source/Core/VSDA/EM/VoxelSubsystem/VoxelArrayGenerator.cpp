@@ -79,7 +79,7 @@ std::vector<Geometries::Vec3D> SubdivideLine(Geometries::Vec3D Point1, Geometrie
 
 
 
-bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Sim, MicroscopeParameters* _Params, VoxelArray* _Array, ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool) {
+bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Sim, MicroscopeParameters* _Params, VoxelArray* _Array, ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool, const ShapeCullingIndex* _CullingIndex) {
     assert(_Array != nullptr);
     assert(_Params != nullptr);
     assert(_Sim != nullptr);
@@ -112,19 +112,37 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
     _Logger->Log("Rasterization Preprocessing " + std::to_string(_Sim->BSCompartments.size()) + " Shapes", 4);
 
 
+    // Find the compartments and receptors inside the region, through the culling index of the render if there is one
+    std::vector<size_t> CompartmentIndices;
+    std::vector<size_t> ReceptorIndices;
+    if (_CullingIndex != nullptr) {
+        _CullingIndex->Compartments.Query(RegionBoundingBox, CompartmentIndices);
+        _CullingIndex->Receptors.Query(RegionBoundingBox, ReceptorIndices);
+    } else {
+        for (size_t i = 0; i < _Sim->BSCompartments.size(); i++) {
+            if (IsShapeInsideRegion(_Sim, _Sim->BSCompartments[i].ShapeID, RegionBoundingBox, Info)) {
+                CompartmentIndices.push_back(i);
+            }
+        }
+        for (size_t i = 0; i < _Sim->Receptors.size(); i++) {
+            if (IsShapeInsideRegion(_Sim, _Sim->Receptors[i]->ShapeID, RegionBoundingBox, Info)) {
+                ReceptorIndices.push_back(i);
+            }
+        }
+    }
+
+
     // Build Bounding Boxes For All Compartments
     int AddedShapes = 0;
-    int TotalShapes = 0;
+    int TotalShapes = _Sim->BSCompartments.size();
     size_t TotalSegments = 0;
     size_t AddedSpheres = 0;
     size_t AddedCylinders = 0;
     _Sim->VSDAData_.TotalVoxelQueueLength_ = 0;
     auto StartTime = std::chrono::high_resolution_clock::now();
-    for (size_t i = 0; i < _Sim->BSCompartments.size(); i++) {
-
-        Compartments::BS* ThisCompartment = &_Sim->BSCompartments[i];
+    for (size_t i = 0; i < CompartmentIndices.size(); i++) {
 
-        TotalShapes++;
+        Compartments::BS* ThisCompartment = &_Sim->BSCompartments[CompartmentIndices[i]];
 
 
         // Processing Stats, every 500 ms
@@ -132,8 +150,8 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
         std::chrono::duration<double, std::milli> Elapsed_ms = CurrentTime - StartTime;
         if (Elapsed_ms.count() >= 500.0) {
 
-            std::string LogMsg = "Processed (" + std::to_string(TotalShapes) + "/" + std::to_string(_Sim->BSCompartments.size()) + ") TotalShapes, Added ";
-            LogMsg += std::to_string(AddedShapes) + " Shapes, With " + std::to_string(TotalSegments) + " Segments, In " + std::to_string(i) + " Iterations";
+            std::string LogMsg = "Processed (" + std::to_string(i) + "/" + std::to_string(CompartmentIndices.size()) + ") Shapes Inside The Region, Added ";
+            LogMsg += std::to_string(AddedShapes) + " Shapes, With " + std::to_string(TotalSegments) + " Segments";
             _Logger->Log(LogMsg, 1);
 
             // Reset Start Timer
@@ -149,8 +167,8 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
         // Task->Parameters_ = _Params;
 
 
-        // Now submit to render queue if it's inside the region, otherwise skip it
-        if (IsShapeInsideRegion(_Sim, ThisCompartment->ShapeID, RegionBoundingBox, Info)) {
+        // Now submit to render queue, only shapes inside the region were selected above
+        {
             
             
             // Check if we need to render this in parts
@@ -325,9 +343,9 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
     // Now Do It For Receptors
     _Logger->Log("Receptor Preprocessing " + std::to_string( _Sim->Receptors.size()) + " Boxes", 5);
 
-    for (unsigned int i = 0; i < _Sim->Receptors.size(); i++) {
+    for (size_t i = 0; i < ReceptorIndices.size(); i++) {
 
-        Connections::Receptor* ThisReceptor = _Sim->Receptors[i].get();
+        Connections::Receptor* ThisReceptor = _Sim->Receptors[ReceptorIndices[i]].get();
 
         // Create a working task for the generatorpool to complete
         std::unique_ptr<VoxelArrayGenerator::Task> Task = std::make_unique<VoxelArrayGenerator::Task>();
@@ -350,8 +368,8 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
 
         }
 
-        // Now submit to render queue if it's inside the region, otherwise skip it
-        if (IsShapeInsideRegion(_Sim, ThisReceptor->ShapeID, RegionBoundingBox, Info)) {
+        // Now submit to render queue, only shapes inside the region were selected above
+        {
             
             AddedShapes++;
 
@@ -39,6 +39,7 @@
 
 #include <VSDA/EM/VoxelSubsystem/Structs/MicroscopeParameters.h>
 #include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+#include <VSDA/Common/Structs/ShapeCullingIndex.h>
 
 
 #include <VSDA/EM/VoxelSubsystem/ArrayGeneratorPool/ArrayGeneratorPool.h>
@@ -61,10 +62,11 @@ namespace Simulator {
  * @param _Sim Pointer to simulation that data is to be generated from
  * @param _Region Pointer to region in that simulation where we'll be generating an array
  * @param _Array Pointer to array to be populated.
+ * @param _CullingIndex Index of the shapes of _Sim built for this render, if null every shape is tested against the region.
  * @return true On success
  * @return false On failure (eg: out of memory, out of bounds, etc.)
  */
-bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Sim, MicroscopeParameters* _Params, VoxelArray* _Array, ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool);
+bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulation* _Sim, MicroscopeParameters* _Params, VoxelArray* _Array, ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool, const ShapeCullingIndex* _CullingIndex = nullptr);
 
 
 
@@ -105,8 +105,7 @@ bool VSDA_CA_QueueRenderOperation(BG::Common::Logger::LoggingSystem* _Logger, Si
     // Setup Enums, Indicate that work is requested
     _Sim->CaData_.ActiveRegionID_ = _RegionID;
     _Sim->CaData_.State_ = CA_RENDER_REQUESTED;
-    _Sim->CurrentTask = Simulator::SIMULATION_CALCIUM;
-    _Sim->WorkRequested = true;
+    _Sim->RequestWork(Simulator::SIMULATION_CALCIUM);
 
     return true;
 
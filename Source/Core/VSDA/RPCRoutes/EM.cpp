@@ -43,7 +43,7 @@ bool VSDA_EM_SetupMicroscope(BG::Common::Logger::LoggingSystem* _Logger, Simulat
     // Check Preconditions
     assert(_Logger != nullptr);
     assert(_Sim != nullptr);
-    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE)) { // Check that the VSDA is during its init phase, and not yet done initializing.
+    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE) && (_Sim->VSDAData_.State_ != VSDA_RENDER_FAILED)) { // Check that the VSDA is during its init phase, and not yet done initializing.
         _Logger->Log("VSDA EM SetupMicroscope Error, Cannot Setup Microscope On System With Unknown State", 6);
         return false; 
     }
@@ -65,7 +65,7 @@ bool VSDA_EM_DefineScanRegion(BG::Common::Logger::LoggingSystem* _Logger, Simula
     // Check Preconditions
     assert(_Logger != nullptr);
     assert(_Sim != nullptr);
-    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE)) { // Check that the VSDA is during its init phase, and not yet done initializing.
+    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE) && (_Sim->VSDAData_.State_ != VSDA_RENDER_FAILED)) { // Check that the VSDA is during its init phase, and not yet done initializing.
         _Logger->Log("VSDA EM DefineScanRegion Error, Cannot Define Microscope Scan Region On System With Unknown State", 6);
         return false; 
     }
@@ -87,7 +87,7 @@ bool VSDA_EM_QueueRenderOperation(BG::Common::Logger::LoggingSystem* _Logger, Si
     // Check Preconditions
     assert(_Logger != nullptr);
     assert(_Sim != nullptr);
-    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE)) { // Check that the VSDA is during its init phase, and not yet done initializing.
+    if ((_Sim->VSDAData_.State_ != VSDA_INIT_BEGIN) && (_Sim->VSDAData_.State_ != VSDA_RENDER_DONE) && (_Sim->VSDAData_.State_ != VSDA_RENDER_FAILED)) { // Check that the VSDA is during its init phase, and not yet done initializing.
         _Logger->Log("VSDA EM QueueRenderOperation Error, Cannot Queue Render Operation On System With Unknown State", 6);
         return false; 
     }
@@ -104,8 +104,7 @@ bool VSDA_EM_QueueRenderOperation(BG::Common::Logger::LoggingSystem* _Logger, Si
     // Setup Enums, Indicate that work is requested
     _Sim->VSDAData_.ActiveRegionID_ = _RegionID;
     _Sim->VSDAData_.State_ = VSDA_RENDER_REQUESTED;
-    _Sim->CurrentTask = SIMULATION_VSDA;
-    _Sim->WorkRequested = true;
+    _Sim->RequestWork(SIMULATION_VSDA);
 
     return true;
 
@@ -11,6 +11,7 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <RPC/RPCHandlerHelper.h>
+#include <Util/FileChunk.h>
 
 #include <VSDA/VSDARPCInterface.h>
 
@@ -52,6 +53,8 @@ VSDARPCInterface::VSDARPCInterface(BG::Common::Logger::LoggingSystem* _Logger, A
     _RPCManager->AddRoute("VSDA/EM/GetDatasetHandle",           std::bind(&VSDARPCInterface::VSDAEMGetDatasetHandle, this, std::placeholders::_1));
     _RPCManager->AddRoute("VSDA/EM/GetNeuroglancerDatasetURL",  std::bind(&VSDARPCInterface::VSDAEMGetNeuroglancerDatasetURL, this, std::placeholders::_1));
     _RPCManager->AddRoute("VSDA/GetImage",                      std::bind(&VSDARPCInterface::VSDAGetImage, this, std::placeholders::_1));
+    _RPCManager->AddRoute("VSDA/GetImageChunk",                 std::bind(&VSDARPCInterface::VSDAGetImageChunk, this, std::placeholders::_1));
+    _RPCManager->AddBinaryRoute("VSDA/GetImageChunkRaw",        std::bind(&VSDARPCInterface::VSDAGetImageChunkRaw, this, std::placeholders::_1));
     _RPCManager->AddRoute("VSDA/Ca/Initialize",                 std::bind(&VSDARPCInterface::VSDACAInitialize, this, std::placeholders::_1));
     _RPCManager->AddRoute("VSDA/Ca/SetupMicroscope",            std::bind(&VSDARPCInterface::VSDACASetupMicroscope, this, std::placeholders::_1));
     _RPCManager->AddRoute("VSDA/Ca/DefineScanRegion",           std::bind(&VSDARPCInterface::VSDACADefineScanRegion, this, std::placeholders::_1));
@@ -427,8 +430,7 @@ std::string VSDARPCInterface::VSDAEMPrepareNeuroglancerDataset(std::string _JSON
     // Setup Enums, Indicate that work is requested
     ThisSimulation->VSDAData_.ActiveRegionID_ = ScanRegionID;
     ThisSimulation->VSDAData_.State_ = VSDA_CONVERSION_REQUESTED;
-    ThisSimulation->CurrentTask = SIMULATION_VSDA;
-    ThisSimulation->WorkRequested = true;
+    ThisSimulation->RequestWork(SIMULATION_VSDA);
 
    
     // Build Response
@@ -569,18 +571,7 @@ std::string VSDARPCInterface::VSDAGetImage(std::string _JSONRequest) {
 
 
 
-    // Minor security feature (probably still exploitable, so be warned!)
-    // We just remove .. from the incoming handle for the image, since they're just files right now
-    // as such, if we didnt strip that, then people could read any files on the server!
-    // Also, we prepend a '.' so people can't try and get to the root
-    std::string Pattern = "..";
-    std::string::size_type i = ImageHandle.find(Pattern);
-    while (i != std::string::npos) {
-        Logger_->Log("Detected '..' In ImageHandle, It's Possible That Someone Is Trying To Do Something Nasty", 8);
-        ImageHandle.erase(i, Pattern.length());
-        i = ImageHandle.find(Pattern, i);
-    }
-    std::string SafeHandle = "./" + ImageHandle;
+    std::string SafeHandle = Util::SafeFilePath(Logger_, ImageHandle, "./");
 
 
     // Now Check If The Handle Is Valid, If So, Load It
@@ -620,6 +611,42 @@ std::string VSDARPCInterface::VSDAGetImage(std::string _JSONRequest) {
 
 
 
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "ImageHandle": <str>,
+ *   "Offset": <bytes>,
+ *   "Length": <bytes>
+ * }
+ */
+std::string VSDARPCInterface::VSDAGetImageChunk(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "VSDA/GetImageChunk", SimulationsPtr_, true, true);
+    std::string ImageHandle;
+    Util::FileChunk Chunk;
+    if ((Handle.HasError())
+        || (!Handle.GetParString("ImageHandle", ImageHandle))
+        || (!Handle.GetFileChunk(Util::SafeFilePath(Logger_, ImageHandle, "./"), Chunk))) {
+        return Handle.ErrResponse();
+    }
+
+    return Handle.ChunkResponse("ImageData", Chunk);
+}
+
+API::BinaryResponse VSDARPCInterface::VSDAGetImageChunkRaw(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "VSDA/GetImageChunkRaw", SimulationsPtr_, true, true);
+    std::string ImageHandle;
+    Util::FileChunk Chunk;
+    if (!Handle.HasError() && Handle.GetParString("ImageHandle", ImageHandle)) {
+        Handle.GetFileChunk(Util::SafeFilePath(Logger_, ImageHandle, "./"), Chunk);
+    }
+
+    return API::BinaryResponse(int(Handle.GetStatus()), Chunk.FileSize, std::move(Chunk.Data));
+}
+
+
+
 std::string VSDARPCInterface::VSDACAInitialize(std::string _JSONRequest) {
 
     // Parse Request
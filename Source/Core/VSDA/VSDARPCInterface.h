@@ -162,6 +162,16 @@ public:
      */
     std::string VSDAGetImage(std::string _JSONRequest);
 
+    /**
+     * @brief Gets Length bytes of an image from Offset, for downloads in bounded chunks.
+     * The Raw variant returns the bytes as binary instead of base64 and is called directly, not through NES.
+     *
+     * @param _JSONRequest
+     * @return std::string
+     */
+    std::string VSDAGetImageChunk(std::string _JSONRequest);
+    API::BinaryResponse VSDAGetImageChunkRaw(std::string _JSONRequest);
+
 
     std::string VSDACAInitialize(std::string _JSONRequest);
     std::string VSDACASetupMicroscope(std::string _JSONRequest);
@@ -13,6 +13,7 @@
 #include <Visualizer/VisualizerRPCInterface.h>
 #include <Visualizer/Visualizer.h>
 #include <RPC/APIStatusCode.h>
+#include <Util/FileChunk.h>
 
 
 namespace BG {
@@ -31,6 +32,8 @@ VisualizerRPCInterface::VisualizerRPCInterface(BG::Common::Logger::LoggingSystem
     _RPCManager->AddRoute("Visualizer/GetStatus",        std::bind(&VisualizerRPCInterface::VisualizerGetStatus, this, std::placeholders::_1));
     _RPCManager->AddRoute("Visualizer/GetImageHandles",  std::bind(&VisualizerRPCInterface::VisualizerGetImageHandles, this, std::placeholders::_1));
     _RPCManager->AddRoute("Visualizer/GetImage",         std::bind(&VisualizerRPCInterface::VisualizerGetImage, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Visualizer/GetImageChunk",    std::bind(&VisualizerRPCInterface::VisualizerGetImageChunk, this, std::placeholders::_1));
+    _RPCManager->AddBinaryRoute("Visualizer/GetImageChunkRaw", std::bind(&VisualizerRPCInterface::VisualizerGetImageChunkRaw, this, std::placeholders::_1));
     _RPCManager->AddRoute("Visualizer/GenerateImages",   std::bind(&VisualizerRPCInterface::VisualizerGenerateImages, this, std::placeholders::_1));
 
 
@@ -98,18 +101,7 @@ std::string VisualizerRPCInterface::VisualizerGetImage(std::string _JSONRequest)
     }
 
 
-    // Minor security feature (probably still exploitable, so be warned!)
-    // We just remove .. from the incoming handle for the image, since they're just files right now
-    // as such, if we didnt strip that, then people could read any files on the server!
-    // Also, we prepend a '.' so people can't try and get to the root
-    std::string Pattern = "..";
-    std::string::size_type i = ImageHandle.find(Pattern);
-    while (i != std::string::npos) {
-        Logger_->Log("Detected '..' In ImageHandle, It's Possible That Someone Is Trying To Do Something Nasty", 8);
-        ImageHandle.erase(i, Pattern.length());
-        i = ImageHandle.find(Pattern, i);
-    }
-    std::string SafeHandle = "./" + ImageHandle;
+    std::string SafeHandle = Util::SafeFilePath(Logger_, ImageHandle, "./");
 
 
     // Now Check If The Handle Is Valid, If So, Load It
@@ -137,6 +129,40 @@ std::string VisualizerRPCInterface::VisualizerGetImage(std::string _JSONRequest)
     return Handle.StringResponse("ImageData", Base64Data); // ok
 }
 
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "ImageHandle": <str>,
+ *   "Offset": <bytes>,
+ *   "Length": <bytes>
+ * }
+ */
+std::string VisualizerRPCInterface::VisualizerGetImageChunk(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Visualizer/GetImageChunk", Simulations_, true, true);
+    std::string ImageHandle;
+    Util::FileChunk Chunk;
+    if ((Handle.HasError())
+        || (!Handle.GetParString("ImageHandle", ImageHandle))
+        || (!Handle.GetFileChunk(Util::SafeFilePath(Logger_, ImageHandle, "./"), Chunk))) {
+        return Handle.ErrResponse();
+    }
+
+    return Handle.ChunkResponse("ImageData", Chunk);
+}
+
+API::BinaryResponse VisualizerRPCInterface::VisualizerGetImageChunkRaw(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Visualizer/GetImageChunkRaw", Simulations_, true, true);
+    std::string ImageHandle;
+    Util::FileChunk Chunk;
+    if (!Handle.HasError() && Handle.GetParString("ImageHandle", ImageHandle)) {
+        Handle.GetFileChunk(Util::SafeFilePath(Logger_, ImageHandle, "./"), Chunk);
+    }
+
+    return API::BinaryResponse(int(Handle.GetStatus()), Chunk.FileSize, std::move(Chunk.Data));
+}
+
 /**
  * Expects _JSONRequest:
  * {
@@ -197,9 +223,8 @@ std::string VisualizerRPCInterface::VisualizerGenerateImages(std::string _JSONRe
 
     
 
-    Handle.Sim()->CurrentTask = SIMULATION_VISUALIZATION;
     Handle.Sim()->VisualizerParams.State = VISUALIZER_REQUESTED;
-    Handle.Sim()->WorkRequested = true;
+    Handle.Sim()->RequestWork(SIMULATION_VISUALIZATION);
 
 
     // Return Result ID
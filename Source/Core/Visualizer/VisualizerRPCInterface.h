@@ -85,6 +85,11 @@ public:
     std::string VisualizerGetStatus(std::string _JSONRequest);
     std::string VisualizerGenerateImages(std::string _JSONRequest);
 
+    //! Length bytes of an image from Offset, base64 encoded or, for the Raw
+    //! variant which is called directly instead of through NES, as binary.
+    std::string VisualizerGetImageChunk(std::string _JSONRequest);
+    API::BinaryResponse VisualizerGetImageChunkRaw(std::string _JSONRequest);
+
 
 };
 